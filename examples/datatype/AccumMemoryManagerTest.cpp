@@ -0,0 +1,176 @@
+﻿#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cassert>
+#include <cstring>
+#include <cstdint>
+#include <hgl/type/AccumMemoryManager.h>
+
+using namespace hgl;
+using namespace std;
+
+int main(int, char **)
+{
+    // 1) 已分配的地址在后续分配中保持不变
+    {
+        cout << "=== Test 1: stable addresses ===" << endl;
+
+        AccumMemoryManager amm(256);
+        vector<AccumMemoryManager::Block *> blocks;
+        vector<void *> addresses;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            AccumMemoryManager::Block *b = amm.Acquire(16 + (i % 7) * 8);
+            assert(b);
+            memset(amm.Access(b), i & 0xFF, b->size);
+
+            blocks.push_back(b);
+            addresses.push_back(amm.Access(b));
+        }
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            assert(amm.Access(blocks[i]) == addresses[i]);
+            assert(((uint8_t *)addresses[i])[blocks[i]->size - 1] == (i & 0xFF));
+        }
+
+        assert(amm.GetBlockCount() == 1000);
+        cout << "chunks: " << amm.GetChunkCount() << ", reserved: " << amm.GetReservedBytes()
+             << ", used: " << amm.GetTotalBytes() << endl;
+        assert(amm.GetChunkCount() < 16);          // 按倍数增长
+    }
+
+    // 2) 对齐
+    {
+        cout << "=== Test 2: alignment ===" << endl;
+
+        AccumMemoryManager amm(128);
+
+        for (int64 align = 1; align <= 4096; align *= 2)
+        {
+            amm.Allocate(3);
+            void *p = amm.Allocate(40, align);
+            assert(((uintptr_t)p % align) == 0);
+        }
+
+        double *d = amm.Allocate<double>(10);
+        assert(((uintptr_t)d % alignof(double)) == 0);
+
+        assert(amm.Allocate(16, 3) == nullptr);     // 非2的幂
+        assert(amm.Acquire(0) == nullptr);
+    }
+
+    // 3) 标记/回滚，检查点
+    {
+        cout << "=== Test 3: mark / rollback ===" << endl;
+
+        AccumMemoryManager amm(1024);
+
+        AccumMemoryManager::Block *keep = amm.Acquire(100);
+        memset(amm.Access(keep), 0x5A, 100);
+
+        const AccumMemoryManager::Mark mark = amm.GetMark();
+        void *first_after_mark = amm.Allocate(64);
+
+        for (int i = 0; i < 100; ++i)
+            amm.Acquire(200);
+
+        const int64 chunk_count = amm.GetChunkCount();
+
+        assert(amm.Rollback(mark));
+        assert(amm.GetBlockCount() == 1);
+        assert(amm.GetTotalBytes() == 100);
+        assert(amm.Allocate(64) == first_after_mark);   // 回滚后复用同一位置
+        assert(((uint8_t *)amm.Access(keep))[99] == 0x5A);
+
+        for (int frame = 0; frame < 10; ++frame)
+        {
+            AccumMemoryManager::Checkpoint cp(amm);
+
+            for (int i = 0; i < 100; ++i)
+                amm.Acquire(200);
+        }
+
+        assert(amm.GetChunkCount() == chunk_count);     // 复用已有内存块
+        assert(amm.GetBlockCount() == 1);
+
+        amm.Clear();
+        assert(amm.GetTotalBytes() == 0 && amm.GetChunkCount() == chunk_count);
+
+        amm.Free();
+        assert(amm.GetChunkCount() == 0 && amm.GetReservedBytes() == 0);
+    }
+
+    // 3b) 失效的标记
+    {
+        cout << "=== Test 3b: stale marks ===" << endl;
+
+        AccumMemoryManager amm(256);
+
+        for (int i = 0; i < 20; ++i)
+            amm.Acquire(100);
+
+        const AccumMemoryManager::Mark before_clear = amm.GetMark();
+
+        amm.Clear();
+        amm.Acquire(10);
+        assert(!amm.Rollback(before_clear));                    // Clear之前的标记
+        assert(amm.GetBlockCount() == 1 && amm.GetTotalBytes() == 10);
+
+        const AccumMemoryManager::Mark before_free = amm.GetMark();
+
+        amm.Free();
+        amm.Acquire(10);
+        assert(!amm.Rollback(before_free));                     // Free之前的标记
+        assert(amm.GetBlockCount() == 1 && amm.GetChunkCount() == 1);
+
+        const AccumMemoryManager::Mark now = amm.GetMark();
+        amm.Acquire(10);
+        assert(amm.Rollback(now));
+        assert(amm.Rollback(now));                              // 同一标记可重复回滚
+        assert(amm.GetBlockCount() == 1);
+    }
+
+    // 4) 大分配超过块上限
+    {
+        cout << "=== Test 4: oversized allocation ===" << endl;
+
+        AccumMemoryManager amm(1024, 4096);
+
+        void *big = amm.Allocate(100000, 64);
+        assert(big && ((uintptr_t)big % 64) == 0);
+        memset(big, 1, 100000);
+
+        void *small = amm.Allocate(16);
+        assert(small);
+    }
+
+    // 5) 性能：大量小块分配
+    {
+        cout << "=== Test 5: throughput ===" << endl;
+
+        constexpr int FRAMES = 20;
+        constexpr int ALLOCS = 100000;
+
+        AccumMemoryManager amm;
+
+        const auto t0 = chrono::steady_clock::now();
+
+        for (int frame = 0; frame < FRAMES; ++frame)
+        {
+            AccumMemoryManager::Checkpoint cp(amm);
+
+            for (int i = 0; i < ALLOCS; ++i)
+                *(int *)amm.Access(amm.Acquire(48)) = i;
+        }
+
+        const double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+        cout << FRAMES << " frames x " << ALLOCS << " allocations: " << ms << " ms, chunks: "
+             << amm.GetChunkCount() << endl;
+    }
+
+    cout << "All tests passed!" << endl;
+    return 0;
+}
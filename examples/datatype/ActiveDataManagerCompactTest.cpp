@@ -0,0 +1,197 @@
+﻿#include<hgl/type/ActiveDataManager.h>
+#include<hgl/type/FlatUnorderedSet.h>
+#include<hgl/type/ShardedSet.h>
+#include<hgl/type/DualHashSet.h>
+#include<hgl/type/LinearProbeSet.h>
+#include<iostream>
+#include<vector>
+
+using namespace hgl;
+using namespace std;
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+/**
+ * 写入0..count-1，删除所有3的倍数，压缩后检查剩余元素均可找到、被删除的元素均不存在
+ */
+template<typename S> static bool TestSetCompact(const char *name,bool incremental)
+{
+    constexpr int COUNT=2000;
+
+    S set;
+
+    for(int i=0;i<COUNT;i++)
+        set.Add(i);
+
+    for(int i=0;i<COUNT;i+=3)
+        set.Delete(i);
+
+    if(incremental)
+    {
+        while(!set.IsCompact())
+            set.CompactStep(64);
+    }
+    else
+        set.Compact();
+
+    bool ok=set.IsCompact()&&set.GetCount()==COUNT-(COUNT+2)/3;
+
+    for(int i=0;i<COUNT;i++)
+        if(set.Contains(i)!=(i%3!=0))
+            ok=false;
+
+    // 压缩后继续增删
+    for(int i=0;i<COUNT;i+=3)
+        set.Add(i);
+
+    ok=ok&&set.GetCount()==COUNT;
+
+    for(int i=0;i<COUNT;i++)
+        if(!set.Contains(i))
+            ok=false;
+
+    return Check(ok,name);
+}
+
+int main()
+{
+    bool ok=true;
+
+    cout<<"=== Test 1: ActiveDataManager full compaction ==="<<endl;
+    {
+        ActiveDataManager<int> adm;
+
+        vector<int> ids(300);
+        adm.GetOrCreate(ids.data(),300);
+
+        for(int i=0;i<300;i++)
+            adm.WriteData(i*10,ids[i]);
+
+        vector<int> released;
+        for(int i=0;i<300;i+=4)
+            released.push_back(i);
+
+        adm.Release(released.data(),(int)released.size());
+
+        ok&=Check(!adm.IsCompact()&&adm.GetIdleCount()==75,"75 holes before compaction");
+
+        vector<int> remap;
+        const int moved=adm.Compact(&remap);
+
+        ok&=Check(adm.IsCompact(),"IsCompact after Compact");
+        ok&=Check(adm.GetHistoryMaxId()==225&&adm.GetIdleCount()==0,"ID space trimmed to active count");
+        ok&=Check(moved>0&&moved<=75,"moved count bounded by hole count");
+        ok&=Check((int)remap.size()==300,"remap table covers old ID space");
+
+        bool data_ok=true;
+
+        for(int old_id=0;old_id<300;old_id++)
+        {
+            if(old_id%4==0)
+            {
+                if(remap[old_id]!=-1)
+                    data_ok=false;
+
+                continue;
+            }
+
+            int value;
+            if(remap[old_id]<0||remap[old_id]>=225||!adm.IsActive(remap[old_id])
+             ||!adm.GetData(value,remap[old_id])||value!=old_id*10)
+                data_ok=false;
+        }
+
+        ok&=Check(data_ok,"every surviving value reachable through remap table");
+
+        int new_id;
+        adm.GetOrCreate(&new_id,1);
+        ok&=Check(new_id==225,"new IDs continue after compacted range");
+    }
+
+    cout<<"\n=== Test 2: ActiveDataManager incremental compaction ==="<<endl;
+    {
+        ActiveDataManager<int> adm;
+
+        vector<int> ids(1000);
+        adm.GetOrCreate(ids.data(),1000);
+
+        for(int i=0;i<1000;i++)
+            adm.WriteData(i,ids[i]);
+
+        vector<int> released;
+        for(int i=0;i<500;i++)
+            released.push_back(i*2);
+
+        adm.Release(released.data(),(int)released.size());
+
+        vector<int> location(1000);                 // value -> 当前ID
+        for(int i=0;i<1000;i++)
+            location[i]=i;
+
+        vector<ActiveIDRemap> moved;
+        int steps=0;
+        bool step_ok=true;
+
+        while(!adm.IsCompact())
+        {
+            moved.clear();
+
+            if(adm.CompactStep(16,&moved)>16)
+                step_ok=false;
+
+            for(const ActiveIDRemap &m:moved)
+            {
+                int value;
+                adm.GetData(value,m.new_id);
+                location[value]=m.new_id;
+            }
+
+            // 步与步之间仍可正常分配/释放
+            if(steps==3)
+            {
+                int id;
+                adm.Get(&id,1);
+                adm.WriteData(-1,id);
+                adm.Release(&id,1);
+            }
+
+            ++steps;
+        }
+
+        ok&=Check(step_ok&&steps>=250/16,"each step bounded by budget");
+
+        bool data_ok=adm.GetActiveCount()==500&&adm.GetHistoryMaxId()==500;
+
+        for(int v=1;v<1000;v+=2)
+        {
+            int value;
+            if(!adm.IsActive(location[v])||!adm.GetData(value,location[v])||value!=v)
+                data_ok=false;
+        }
+
+        ok&=Check(data_ok,"all values tracked through incremental remap");
+    }
+
+    cout<<"\n=== Test 3: Hash sets rebuild indices after compaction ==="<<endl;
+    {
+        ok&=TestSetCompact<FlatUnorderedSet<int>>("FlatUnorderedSet::Compact",false);
+        ok&=TestSetCompact<FlatUnorderedSet<int>>("FlatUnorderedSet::CompactStep",true);
+        ok&=TestSetCompact<ShardedSet<int>>("ShardedSet::Compact",false);
+        ok&=TestSetCompact<ShardedSet<int>>("ShardedSet::CompactStep",true);
+        ok&=TestSetCompact<DualHashSet<int>>("DualHashSet::Compact",false);
+        ok&=TestSetCompact<DualHashSet<int>>("DualHashSet::CompactStep",true);
+        ok&=TestSetCompact<LinearProbeSet<int>>("LinearProbeSet::Compact",false);
+        ok&=TestSetCompact<LinearProbeSet<int>>("LinearProbeSet::CompactStep",true);
+        ok&=TestSetCompact<LinearProbeSet<int,LinearProbeMode::Group>>("LinearProbeSet<Group>::Compact",false);
+        ok&=TestSetCompact<LinearProbeSet<int,LinearProbeMode::Group>>("LinearProbeSet<Group>::CompactStep",true);
+        ok&=TestSetCompact<LinearProbeSet<int,LinearProbeMode::RobinHood>>("LinearProbeSet<RobinHood>::Compact",false);
+        ok&=TestSetCompact<LinearProbeSet<int,LinearProbeMode::RobinHood>>("LinearProbeSet<RobinHood>::CompactStep",true);
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
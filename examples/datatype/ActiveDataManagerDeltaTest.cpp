@@ -0,0 +1,149 @@
+﻿#include<hgl/type/ActiveDataManager.h>
+#include<iostream>
+#include<vector>
+#include<map>
+
+using namespace hgl;
+using namespace std;
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+/**
+ * 模拟接收方：按 released -> created -> changed 的顺序应用增量
+ */
+static void ApplyDelta(map<int,int> &replica,const ActiveDataManager<int>::Delta &delta)
+{
+    for(int id:delta.released_ids)
+        replica.erase(id);
+
+    for(int id:delta.created_ids)
+        replica[id]=0;
+
+    for(size_t i=0;i<delta.changed_ids.size();i++)
+        replica[delta.changed_ids[i]]=delta.changed_values[i];
+}
+
+static bool SameAsReplica(ActiveDataManager<int> &adm,const map<int,int> &replica)
+{
+    if((int)replica.size()!=adm.GetActiveCount())
+        return false;
+
+    bool same=true;
+
+    const ActiveDataManager<int> &cadm=adm;
+    cadm.ForEachActive([&](int id,const int &value)
+    {
+        auto it=replica.find(id);
+        if(it==replica.end()||it->second!=value)
+            same=false;
+    });
+
+    return same;
+}
+
+int main()
+{
+    bool ok=true;
+
+    ActiveDataManager<int> adm;
+    ActiveDataManager<int>::Delta delta;
+    map<int,int> replica;
+
+    vector<int> ids(1000);
+    adm.GetOrCreate(ids.data(),1000);
+
+    for(int i=0;i<1000;i++)
+        adm.WriteData(i,ids[i]);
+
+    cout<<"=== Test 1: Enabling tracking exports full state ==="<<endl;
+    {
+        ok&=Check(!adm.CollectDirty(delta),"nothing collected while tracking is off");
+
+        adm.SetDirtyTracking(true);
+
+        ok&=Check(adm.CollectDirty(delta)&&delta.created_ids.size()==1000&&delta.changed_ids.size()==1000,"initial delta holds all items");
+
+        ApplyDelta(replica,delta);
+        ok&=Check(SameAsReplica(adm,replica),"replica matches");
+
+        ok&=Check(!adm.CollectDirty(delta)&&delta.IsEmpty(),"second collect is empty");
+    }
+
+    cout<<"\n=== Test 2: Delta scales with changes ==="<<endl;
+    {
+        adm.WriteData(-5,ids[5]);
+
+        const int batch_ids[2]={ids[10],ids[20]};
+        const int batch_values[2]={-10,-20};
+        adm.WriteDataArray(batch_values,batch_ids,2);
+
+        *adm.At(ids[30])=-30;
+
+        adm.CollectDirty(delta);
+
+        ok&=Check(delta.changed_ids==vector<int>({5,10,20,30}),"changed IDs from WriteData/WriteDataArray/At");
+        ok&=Check(delta.changed_values==vector<int>({-5,-10,-20,-30}),"packed values");
+        ok&=Check(delta.created_ids.empty()&&delta.released_ids.empty(),"no created/released");
+
+        ApplyDelta(replica,delta);
+        ok&=Check(SameAsReplica(adm,replica),"replica matches");
+
+        const ActiveDataManager<int> &cadm=adm;
+        int value=*cadm.At(ids[40]);
+        adm.GetData(value,ids[41]);
+        ok&=Check(!adm.CollectDirty(delta),"reads are not tracked");
+    }
+
+    cout<<"\n=== Test 3: Created and released IDs ==="<<endl;
+    {
+        const int rel[3]={ids[1],ids[2],ids[3]};
+        adm.Release(rel,3);
+
+        int new_id[2];
+        adm.GetOrCreate(new_id,2);                  // 复用ID 1,2
+        adm.WriteData(111,new_id[0]);
+        adm.WriteData(222,new_id[1]);
+
+        int temp;
+        adm.GetOrCreate(&temp,1);                   // 复用ID 3
+        adm.Release(&temp,1);                       // 又释放
+
+        adm.CollectDirty(delta);
+
+        ok&=Check(delta.released_ids==vector<int>({1,2,3}),"released IDs");
+        ok&=Check(delta.created_ids==vector<int>({1,2}),"reused IDs reported as created");
+        ok&=Check(delta.changed_ids==vector<int>({1,2}),"created IDs carry values");
+
+        ApplyDelta(replica,delta);
+        ok&=Check(SameAsReplica(adm,replica),"replica matches");
+
+        int fresh;
+        adm.GetOrCreate(&fresh,1);                  // 在收集周期内新建后释放，直接抵消
+        adm.Release(&fresh,1);
+
+        ok&=Check(!adm.CollectDirty(delta),"create+release within one cycle cancels out");
+    }
+
+    cout<<"\n=== Test 4: Compaction is exported as release+create ==="<<endl;
+    {
+        vector<int> rel;
+        for(int i=100;i<600;i++)
+            rel.push_back(ids[i]);
+
+        adm.Release(rel.data(),(int)rel.size());
+        adm.Compact();
+
+        adm.CollectDirty(delta);
+        ApplyDelta(replica,delta);
+
+        ok&=Check(SameAsReplica(adm,replica),"replica matches after compaction");
+        ok&=Check(delta.released_ids.size()>=500,"moved and released IDs exported");
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
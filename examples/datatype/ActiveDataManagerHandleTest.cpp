@@ -0,0 +1,166 @@
+﻿#include<hgl/type/ActiveDataManager.h>
+#include<iostream>
+#include<vector>
+
+using namespace hgl;
+using namespace std;
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+struct Entity
+{
+    int id;
+    float x,y;
+};
+
+int main()
+{
+    bool ok=true;
+
+    cout<<"=== Test 1: Handle packing ==="<<endl;
+    {
+        ActiveHandle32 h32(12345,7);
+        ActiveHandle64 h64(1000000000,0xABCDEF01);
+
+        ok&=Check(sizeof(ActiveHandle32)==4&&sizeof(ActiveHandle64)==8,"32/64 bit handle size");
+        ok&=Check(h32.GetIndex()==12345&&h32.GetGeneration()==7,"32 bit handle index/generation");
+        ok&=Check(h64.GetIndex()==1000000000&&h64.GetGeneration()==0xABCDEF01,"64 bit handle index/generation");
+        ok&=Check(ActiveHandle().IsNull()&&!h32.IsNull(),"default handle is null");
+        ok&=Check(h32.Match(7+4096)&&!h32.Match(8),"32 bit handle compares low generation bits");
+    }
+
+    cout<<"\n=== Test 2: Stale handles after release and reuse ==="<<endl;
+    {
+        ActiveDataManager<Entity> adm;
+
+        ActiveHandle handles[4];
+        ok&=Check(adm.GetOrCreate(handles,4),"GetOrCreate handles");
+
+        for(int i=0;i<4;i++)
+            *adm.At(handles[i])=Entity{i,float(i),float(i)};
+
+        ok&=Check(adm.At(handles[2])->id==2,"dereference handle");
+
+        const ActiveHandle old_handle=handles[1];
+
+        ok&=Check(adm.Release(old_handle),"release by handle");
+        ok&=Check(!adm.IsValid(old_handle)&&adm.At(old_handle)==nullptr,"released handle is stale");
+        ok&=Check(!adm.Release(old_handle),"double release by stale handle ignored");
+
+        // 释放队列只有一个ID，再次分配必然复用它
+        ActiveHandle reused;
+        adm.GetOrCreate(&reused,1);
+
+        ok&=Check(reused.GetIndex()==old_handle.GetIndex(),"ID reused");
+        ok&=Check(reused!=old_handle&&adm.IsValid(reused)&&!adm.IsValid(old_handle),"reused ID gets new generation");
+        ok&=Check(adm.GetHandle(1)==reused,"GetHandle returns current generation");
+
+        int idle_id;
+        adm.CreateIdle(&idle_id,1);
+        ok&=Check(adm.GetHandle(idle_id).IsNull(),"no handle for idle ID");
+
+        ActiveHandle32 h32=adm.GetHandle<ActiveHandle32>(handles[3].GetIndex());
+        ok&=Check(adm.At(h32)->id==3,"32 bit handle dereference");
+
+        adm.Clear();
+        ok&=Check(!adm.IsValid(h32)&&!adm.IsValid(handles[0]),"Clear invalidates all handles");
+    }
+
+    cout<<"\n=== Test 3: Compaction invalidates moved handles ==="<<endl;
+    {
+        ActiveDataManager<int> adm;
+
+        vector<ActiveHandle> handles(100);
+        adm.GetOrCreate(handles.data(),100);
+
+        for(int i=0;i<100;i++)
+            *adm.At(handles[i])=i;
+
+        for(int i=0;i<50;i++)
+            adm.Release(handles[i]);
+
+        vector<int> remap;
+        adm.Compact(&remap);
+
+        bool compact_ok=true;
+
+        for(int i=50;i<100;i++)
+        {
+            const int old_id=handles[i].GetIndex();
+            const int new_id=remap[old_id];
+
+            if(new_id!=old_id&&adm.IsValid(handles[i]))     // 被搬走的旧句柄必须失效
+                compact_ok=false;
+
+            const ActiveHandle h=adm.GetHandle(new_id);
+            if(!adm.At(h)||*adm.At(h)!=i)
+                compact_ok=false;
+        }
+
+        ok&=Check(compact_ok,"moved handles stale, remapped handles valid");
+
+        // 压缩丢弃了高位ID，重新创建时不能与旧句柄匹配
+        vector<int> ids(50);
+        adm.GetOrCreate(ids.data(),50);
+
+        bool recreate_ok=true;
+        for(int i=0;i<100;i++)
+            if(adm.IsValid(handles[i])&&remap[handles[i].GetIndex()]!=handles[i].GetIndex())
+                recreate_ok=false;
+
+        ok&=Check(recreate_ok,"recreated IDs do not match handles from before compaction");
+    }
+
+    cout<<"\n=== Test 4: Free keeps generations ==="<<endl;
+    {
+        ActiveDataManager<int> adm;
+
+        ActiveHandle handles[8];
+        adm.GetOrCreate(handles,8);
+        adm.Release(handles[5]);                            // 闲置ID
+
+        adm.Free();
+        ok&=Check(adm.GetActiveCount()==0,"Free releases everything");
+
+        ActiveHandle recreated[8];
+        adm.GetOrCreate(recreated,8);
+
+        bool free_ok=true;
+        for(int i=0;i<8;i++)
+        {
+            if(adm.IsValid(handles[i]))                     // 同一ID重新创建后旧句柄仍须失效
+                free_ok=false;
+
+            if(!adm.IsValid(recreated[i]))
+                free_ok=false;
+        }
+
+        ok&=Check(recreated[0].GetIndex()==handles[0].GetIndex(),"IDs restart from 0");
+        ok&=Check(free_ok,"handles issued before Free do not match recreated IDs");
+    }
+
+    cout<<"\n=== Test 5: Forged handles ==="<<endl;
+    {
+        ActiveDataManager<int> adm;
+
+        ActiveHandle handles[4];
+        adm.GetOrCreate(handles,4);
+
+        const ActiveHandle high(int(0x80000001u),adm.GetHandle(1).GetGeneration());     // 索引最高位为1，GetIndex()为负
+        const ActiveHandle beyond(1000,1);
+        const ActiveHandle32 beyond32(0xFFFFF,1);
+
+        ok&=Check(high.GetIndex()<0,"forged 64 bit handle has negative index");
+        ok&=Check(!adm.IsValid(high)&&adm.At(high)==nullptr&&!adm.Release(high),"negative index rejected");
+        ok&=Check(!adm.IsValid(beyond)&&adm.At(beyond)==nullptr,"index past id_count rejected");
+        ok&=Check(!adm.IsValid(beyond32)&&adm.At(beyond32)==nullptr,"32 bit index past id_count rejected");
+        ok&=Check(adm.GetActiveCount()==4,"forged handles change nothing");
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
@@ -0,0 +1,126 @@
+﻿#include<hgl/type/ActiveDataManager.h>
+#include<iostream>
+#include<vector>
+
+using namespace hgl;
+using namespace std;
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+struct Vec2
+{
+    float x,y;
+};
+
+using ParticleManager=ActiveDataManager<Vec2,Vec2,uint32>;     // position, velocity, flags
+
+enum
+{
+    POSITION=0,
+    VELOCITY,
+    FLAGS
+};
+
+int main()
+{
+    bool ok=true;
+
+    ParticleManager pm;
+
+    constexpr int COUNT=100;
+
+    vector<int> ids(COUNT);
+
+    cout<<"=== Test 1: Shared ID space ==="<<endl;
+    {
+        ok&=Check(ParticleManager::COLUMN_COUNT==3,"3 columns");
+        ok&=Check(pm.GetOrCreate(ids.data(),COUNT),"GetOrCreate once for all columns");
+        ok&=Check(pm.GetColumn<POSITION>().size()==COUNT
+                &&pm.GetColumn<VELOCITY>().size()==COUNT
+                &&pm.GetColumn<FLAGS>().size()==COUNT,"every column sized to ID space");
+    }
+
+    cout<<"\n=== Test 2: Batched column writes/reads ==="<<endl;
+    {
+        vector<Vec2> pos(COUNT),vel(COUNT);
+        vector<uint32> flags(COUNT);
+
+        for(int i=0;i<COUNT;i++)
+        {
+            pos[i]={float(i),0};
+            vel[i]={1,2};
+            flags[i]=i&1;
+        }
+
+        ok&=Check(pm.WriteDataArray<POSITION>(pos.data(),ids.data(),COUNT)==COUNT,"WriteDataArray<POSITION>");
+        ok&=Check(pm.WriteDataArray<VELOCITY>(vel.data(),ids.data(),COUNT)==COUNT,"WriteDataArray<VELOCITY>");
+        ok&=Check(pm.WriteDataArray<FLAGS>(flags.data(),ids.data(),COUNT)==COUNT,"WriteDataArray<FLAGS>");
+
+        // 按列做一次积分(可直接向量化的循环)
+        {
+            auto p=pm.GetColumn<POSITION>();
+            auto v=pm.GetColumn<VELOCITY>();
+
+            for(size_t i=0;i<p.size();i++)
+            {
+                p[i].x+=v[i].x;
+                p[i].y+=v[i].y;
+            }
+        }
+
+        const int gather_ids[3]={ids[10],ids[20],ids[30]};
+        Vec2 gathered[3];
+
+        ok&=Check(pm.GetData<POSITION>(gathered,gather_ids,3)==3,"GetData<POSITION> gather");
+        ok&=Check(gathered[0].x==11&&gathered[1].x==21&&gathered[2].x==31&&gathered[2].y==2,"column loop result");
+
+        Vec2 p,v;
+        uint32 f;
+        ok&=Check(pm.GetRow(ids[5],p,v,f)&&p.x==6&&v.y==2&&f==1,"GetRow");
+
+        pm.WriteRow(ids[5],Vec2{-1,-1},Vec2{1,0},7u);
+        ok&=Check(pm.At<FLAGS>(ids[5])&&*pm.At<FLAGS>(ids[5])==7&&pm.At<POSITION>(ids[5])->x==-1,"WriteRow");
+    }
+
+    cout<<"\n=== Test 3: Release, ForEachActive, compaction ==="<<endl;
+    {
+        vector<int> released;
+        for(int i=0;i<COUNT;i+=2)
+            released.push_back(ids[i]);
+
+        ok&=Check(pm.Release(released.data(),(int)released.size())==COUNT/2,"Release once for all columns");
+
+        int visited=0;
+        bool rows_ok=true;
+
+        pm.ForEachActive([&](int,Vec2 &pos,Vec2 &,uint32 &flag)
+        {
+            ++visited;
+            if(flag!=1&&flag!=7)rows_ok=false;
+            pos.y=100;
+        });
+
+        ok&=Check(visited==COUNT/2&&rows_ok,"ForEachActive visits active rows");
+
+        const ActiveHandle h=pm.GetHandle(ids[99]);
+
+        pm.Compact();
+
+        bool compact_ok=pm.IsCompact()&&pm.GetHistoryMaxId()==COUNT/2&&!pm.IsValid(h);
+
+        const ParticleManager &cpm=pm;
+        cpm.ForEachActive([&](int,const Vec2 &pos,const Vec2 &vel,const uint32 &)
+        {
+            if(pos.y!=100||vel.x!=1)compact_ok=false;
+        });
+
+        ok&=Check(compact_ok&&pm.GetColumn<VELOCITY>().size()==COUNT/2,"compaction moves all columns together");
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
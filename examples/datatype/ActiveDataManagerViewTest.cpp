@@ -0,0 +1,115 @@
+﻿#include<hgl/type/ActiveDataManager.h>
+#include<iostream>
+#include<vector>
+
+using namespace hgl;
+using namespace std;
+
+int main()
+{
+    cout << "========================================" << endl;
+    cout << "ActiveDataManager Allocation-free Views" << endl;
+    cout << "========================================\n" << endl;
+
+    ActiveDataManager<int> adm;
+
+    vector<int> ids(300);
+    adm.GetOrCreate(ids.data(), 300);
+
+    for (int i = 0; i < 300; i++)
+        adm.WriteData(i * 10, ids[i]);
+
+    // Release every fourth ID
+    vector<int> released;
+    for (int i = 0; i < 300; i += 4)
+        released.push_back(i);
+
+    adm.Release(released.data(), (int)released.size());
+
+    const vector<int> snapshot = adm.GetActiveView();
+
+    // Test 1: GetActiveIDs() matches GetActiveView()
+    cout << "=== Test 1: GetActiveIDs range ===" << endl;
+    {
+        vector<int> from_range;
+
+        for (int id : adm.GetActiveIDs())
+            from_range.push_back(id);
+
+        const bool ok = from_range == snapshot && adm.GetActiveIDs().size() == adm.GetActiveCount();
+
+        cout << "    Range size: " << adm.GetActiveIDs().size() << " (expected: " << snapshot.size() << ")" << endl;
+
+        if (!ok)
+        {
+            cout << "✗ Test 1 FAILED" << endl;
+            return 1;
+        }
+
+        cout << "✓ Test 1 passed" << endl;
+    }
+
+    // Test 2: ForEachActive visits data in ID order
+    cout << "\n=== Test 2: ForEachActive ===" << endl;
+    {
+        size_t index = 0;
+        bool ok = true;
+
+        adm.ForEachActive([&](int id, int &value)
+        {
+            if (index >= snapshot.size() || snapshot[index] != id || value != id * 10)
+                ok = false;
+
+            value += 1;
+            ++index;
+        });
+
+        const ActiveDataManager<int> &cadm = adm;
+
+        cadm.ForEachActive([&](int id, const int &value)
+        {
+            if (value != id * 10 + 1)
+                ok = false;
+        });
+
+        ok = ok && index == snapshot.size();
+
+        if (!ok)
+        {
+            cout << "✗ Test 2 FAILED" << endl;
+            return 1;
+        }
+
+        cout << "✓ Test 2 passed" << endl;
+    }
+
+    // Test 3: GetActiveByIndex / FindNextActive
+    cout << "\n=== Test 3: GetActiveByIndex / FindNextActive ===" << endl;
+    {
+        bool ok = true;
+
+        for (size_t i = 0; i < snapshot.size(); i++)
+            if (adm.GetActiveByIndex((int)i) != snapshot[i])
+                ok = false;
+
+        ok = ok && adm.GetActiveByIndex(-1) == -1
+                && adm.GetActiveByIndex((int)snapshot.size()) == -1
+                && adm.FindNextActive(0) == 1
+                && adm.FindNextActive(4) == 5
+                && adm.FindNextActive(300) == -1;
+
+        if (!ok)
+        {
+            cout << "✗ Test 3 FAILED" << endl;
+            return 1;
+        }
+
+        cout << "✓ Test 3 passed" << endl;
+    }
+
+    cout << "\n========================================" << endl;
+    cout << "All view tests passed!" << endl;
+    cout << "========================================\n" << endl;
+
+    return 0;
+}
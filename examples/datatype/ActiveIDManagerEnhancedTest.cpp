@@ -116,6 +116,118 @@ int main()
         cout << "✓ Test 4 passed - Overflow protection active!" << endl;
     }
 
+    // Test 5: Bitmap membership, popcount statistics and ordered iteration
+    cout << "\n=== Test 5: Bitmap Membership / Popcount / Iteration ===" << endl;
+    {
+        ActiveIDManager mgr;
+
+        vector<int> ids(200);
+        mgr.CreateActive(ids.data(), 200);
+
+        // Release every third ID
+        vector<int> released;
+        for (int i = 0; i < 200; i += 3)
+            released.push_back(i);
+
+        mgr.Release(released.data(), (int)released.size());
+
+        bool membership_ok = true;
+        for (int i = 0; i < 200; i++)
+        {
+            const bool expect_active = (i % 3) != 0;
+
+            if (mgr.IsActive(i) != expect_active || mgr.IsIdle(i) == expect_active)
+                membership_ok = false;
+        }
+
+        membership_ok = membership_ok && !mgr.IsActive(-1) && !mgr.IsActive(200);
+
+        int expected_range = 0;
+        for (int i = 60; i < 130; i++)
+            if (i % 3) ++expected_range;
+
+        const bool popcount_ok = mgr.GetActiveCountInRange(0, 200) == mgr.GetActiveCount()
+                              && mgr.GetActiveCountInRange(60, 130) == expected_range
+                              && mgr.GetActiveCountInRange(63, 65) == 1
+                              && mgr.GetActiveCountInRange(150, 150) == 0;
+
+        int prev = -1;
+        int visited = 0;
+        bool order_ok = true;
+
+        mgr.ForEachActive([&](int id)
+        {
+            if (id <= prev || (id % 3) == 0)
+                order_ok = false;
+
+            prev = id;
+            ++visited;
+        });
+
+        order_ok = order_ok && visited == mgr.GetActiveCount()
+                            && mgr.FindNextActive(63) == 64
+                            && mgr.FindNextActive(198) == 199
+                            && mgr.FindNextActive(200) == -1;
+
+        cout << "    Active: " << mgr.GetActiveCount() << " Idle: " << mgr.GetIdleCount() << endl;
+        cout << "    Membership correct? " << (membership_ok ? "Yes" : "No") << endl;
+        cout << "    Popcount range stats correct? " << (popcount_ok ? "Yes" : "No") << endl;
+        cout << "    Ascending iteration correct? " << (order_ok ? "Yes" : "No") << endl;
+
+        if (!membership_ok || !popcount_ok || !order_ok)
+        {
+            cout << "✗ Test 5 FAILED" << endl;
+            return 1;
+        }
+
+        cout << "✓ Test 5 passed - Bitmap operations correct!" << endl;
+    }
+
+    // Test 6: GetActiveSet / GetIdleSet compatibility views
+    cout << "\n=== Test 6: GetActiveSet / GetIdleSet ===" << endl;
+    {
+        ActiveIDManager mgr;
+
+        vector<int> ids(100);
+        mgr.CreateActive(ids.data(), 100);
+
+        const auto &active = mgr.GetActiveSet();
+
+        vector<int> released;
+        for (int i = 0; i < 100; i += 2)
+            released.push_back(i);
+
+        mgr.Release(released.data(), (int)released.size());
+
+        // 视图反映当前状态
+        int prev = -1;
+        bool set_ok = active.size() == 50 && !active.empty()
+                   && active.contains(1) && !active.contains(2) && active.count(99) == 1 && !active.contains(100);
+
+        for (int id : active)
+        {
+            if (id <= prev || (id % 2) == 0)
+                set_ok = false;
+            prev = id;
+        }
+
+        const auto &idle = mgr.GetIdleSet();
+        set_ok = set_ok && idle.size() == 50 && idle.contains(0) && !idle.contains(1);
+
+        ActiveIDManager moved(std::move(mgr));
+        set_ok = set_ok && moved.GetActiveSet().size() == 50 && moved.GetActiveSet().contains(51);
+
+        cout << "    Active set view correct? " << (set_ok ? "Yes" : "No") << endl;
+
+        if (!set_ok)
+        {
+            cout << "✗ Test 6 FAILED" << endl;
+            return 1;
+        }
+
+        cout << "✓ Test 6 passed - Set views compatible!" << endl;
+    }
+
     cout << "\n========================================" << endl;
     cout << "All Enhancements Verified Successfully!" << endl;
     cout << "✓ Batch Release buffering (512-element chunks)" << endl;
@@ -0,0 +1,148 @@
+﻿#include <iostream>
+#include <chrono>
+#include <cassert>
+#include <cstring>
+#include <hgl/type/MemoryAllocator.h>
+#include <hgl/platform/MemoryAffinity.h>
+
+using namespace hgl;
+using namespace std;
+
+/**
+ * 可模拟映射失败的页面分配器
+ */
+class FailingPageMemoryAllocator:public PageMemoryAllocator
+{
+public:
+
+    bool fail=false;
+
+    FailingPageMemoryAllocator():PageMemoryAllocator(false){}
+
+protected:
+
+    void *MapPages(uint64 &size,bool &tlb) override
+    {
+        return fail?nullptr:PageMemoryAllocator::MapPages(size,tlb);
+    }
+
+    void *RemapPages(void *ptr,const uint64 old_size,uint64 &new_size) override
+    {
+        return fail?nullptr:PageMemoryAllocator::RemapPages(ptr,old_size,new_size);
+    }
+};
+
+/**
+ * 逐步扩容并校验之前写入的数据没有丢失
+ */
+static void GrowAndVerify(AbstractMemoryAllocator &ma, const char *name)
+{
+    constexpr uint64 STEP = 1024 * 1024;
+    constexpr uint64 TOTAL = 64 * STEP;
+
+    int moves = 0;
+    void *last = nullptr;
+
+    const auto t0 = chrono::steady_clock::now();
+
+    for (uint64 size = STEP; size <= TOTAL; size += STEP)
+    {
+        assert(ma.Reserve(size));
+        assert(ma.GetAllocSize() >= size);
+
+        if (ma.Get() != last)
+        {
+            ++moves;
+            last = ma.Get();
+        }
+
+        memset(ma.Get(size - STEP), int(size / STEP) & 0xFF, STEP);
+    }
+
+    const double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    for (uint64 size = STEP; size <= TOTAL; size += STEP)
+    {
+        const uint8 *p = (const uint8 *)ma.Get(size - STEP);
+        assert(p[0] == (int(size / STEP) & 0xFF) && p[STEP - 1] == p[0]);
+    }
+
+    cout << name << ": grew to " << TOTAL / STEP << " MB, alloc " << ma.GetAllocSize() / STEP
+         << " MB, address changes " << moves << ", " << ms << " ms" << endl;
+
+    ma.Free();
+    assert(ma.Get() == nullptr && ma.GetAllocSize() == 0);
+}
+
+int main(int, char **)
+{
+    cout << "page size: " << GetSystemPageSize() << ", huge page size: " << GetHugePageSize() << endl;
+
+    // 1) 普通堆分配器(对照)
+    {
+        MemoryAllocator ma;
+        GrowAndVerify(ma, "MemoryAllocator    ");
+    }
+
+    // 2) 页面分配器，使用大页面
+    {
+        PageMemoryAllocator pma;
+
+        assert(pma.Reserve(100));
+        assert(pma.GetAllocSize() % GetSystemPageSize() == 0);     // 按页面取整
+        assert(pma.Write("hello", 0, 6));
+        assert(!pma.Write("hello", 98, 6));                         // 越界
+
+        assert(pma.Reserve(8 * 1024 * 1024));
+        assert(strcmp((const char *)pma.Get(), "hello") == 0);
+        cout << "PageMemoryAllocator huge tlb: " << (pma.IsHugeTLB() ? "yes" : "no (transparent huge page advised)") << endl;
+
+        pma.Free();
+        GrowAndVerify(pma, "PageMemoryAllocator");
+    }
+
+    // 3) 页面分配器，不使用大页面
+    {
+        PageMemoryAllocator pma(false);
+        GrowAndVerify(pma, "PageMemoryAllocator(no huge page)");
+    }
+
+    // 4) NUMA节点分配器
+    {
+        NumaMemoryAllocator nma(0);
+
+        assert(nma.Reserve(4 * 1024 * 1024));
+        memset(nma.Get(), 1, 4 * 1024 * 1024);
+
+        cout << "NumaMemoryAllocator node " << nma.GetNumaNode() << ", pages on node: " << GetMemoryNode(nma.Get()) << endl;
+
+        nma.Free();
+        GrowAndVerify(nma, "NumaMemoryAllocator");
+    }
+
+    // 5) 扩容失败后分配大小恢复为实际映射的大小
+    {
+        FailingPageMemoryAllocator fma;
+
+        assert(fma.Reserve(100));
+        const uint64 mapped = fma.GetAllocSize();
+
+        fma.fail = true;
+        assert(!fma.Reserve(mapped * 16));
+        assert(fma.GetAllocSize() == mapped);
+        assert(!fma.Reserve(mapped * 8));                           // 不能在未映射的空间上"成功"
+        assert(fma.Reserve(mapped));                                // 已映射的部分仍可用
+        assert(fma.Write("x", mapped - 1, 1));
+        assert(!fma.Write("x", mapped, 1));
+
+        fma.fail = false;
+        assert(fma.Reserve(mapped * 16));
+        assert(fma.GetAllocSize() >= mapped * 16);
+        assert(fma.Write("y", mapped * 16 - 1, 1));
+
+        cout << "PageMemoryAllocator growth failure keeps alloc size at mapped size" << endl;
+    }
+
+    cout << "All tests passed!" << endl;
+    return 0;
+}
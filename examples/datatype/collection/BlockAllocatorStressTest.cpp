@@ -0,0 +1,192 @@
+﻿#include<hgl/type/BlockAllocator.h>
+#include<iostream>
+#include<vector>
+#include<random>
+#include<chrono>
+#include<cassert>
+
+using namespace std;
+using namespace hgl;
+
+/**
+* 用简单的占用表校验空闲链：有序、不相邻(已合并)、与占用表一致
+*/
+static void Verify(BlockAllocator &ba,const vector<char> &used)
+{
+    int free_total=0;
+    int largest=0;
+    int runs=0;
+    int last_end=-1;
+
+    for(BlockAllocator::ChainNode *cn=ba.GetStartNode();cn;cn=cn->next)
+    {
+        assert(cn->count>0);
+        assert(cn->start>last_end);                 //有序且没有相邻未合并的段
+
+        for(int i=cn->start;i<cn->GetEnd();i++)
+            assert(!used[i]);
+
+        if(cn->start>0)
+            assert(used[cn->start-1]);
+        if(cn->GetEnd()<ba.GetMaxCount())
+            assert(used[cn->GetEnd()]);
+
+        free_total+=cn->count;
+        largest=max(largest,cn->count);
+        last_end=cn->GetEnd();
+        ++runs;
+
+        if(!cn->next)
+            assert(cn==ba.GetEndNode());
+    }
+
+    assert(free_total==ba.GetFreeCount());
+    assert(largest==ba.GetLargestFreeRun());
+    assert(runs==ba.GetFreeRunCount());
+}
+
+int os_main(int,os_char **)
+{
+    cout<<"BlockAllocator Stress Test"<<endl;
+
+    mt19937 gen(22);
+
+    // 1) 与占用表对照的随机申请/释放
+    {
+        constexpr int BLOCK_COUNT=2000;
+
+        BlockAllocator ba;
+        ba.Init(BLOCK_COUNT);
+
+        vector<char> used(BLOCK_COUNT,0);
+        vector<BlockAllocator::UserNode *> nodes;
+
+        for(int op=0;op<20000;op++)
+        {
+            if(nodes.empty()||gen()%2)
+            {
+                const int count=1+gen()%40;
+                BlockAllocator::UserNode *un=ba.Acquire(count);
+
+                if(!un)
+                {
+                    assert(ba.GetLargestFreeRun()<count);
+                    continue;
+                }
+
+                for(int i=un->GetStart();i<un->GetEnd();i++)
+                {
+                    assert(!used[i]);
+                    used[i]=1;
+                }
+
+                nodes.push_back(un);
+            }
+            else
+            {
+                const int pos=gen()%nodes.size();
+                BlockAllocator::UserNode *un=nodes[pos];
+
+                for(int i=un->GetStart();i<un->GetEnd();i++)
+                    used[i]=0;
+
+                assert(ba.Release(un));
+                assert(!ba.Release(un));            //重复释放
+
+                nodes[pos]=nodes.back();
+                nodes.pop_back();
+            }
+
+            if(op%97==0)
+                Verify(ba,used);
+        }
+
+        Verify(ba,used);
+
+        vector<int> histogram;
+        ba.GetFreeRunHistogram(histogram);
+
+        int runs=0;
+        cout<<"  free runs histogram:";
+        for(size_t i=0;i<histogram.size();i++)
+        {
+            cout<<" ["<<(1<<i)<<"+]="<<histogram[i];
+            runs+=histogram[i];
+        }
+        cout<<endl;
+
+        assert(runs==ba.GetFreeRunCount());
+        cout<<"  free="<<ba.GetFreeCount()<<" largest="<<ba.GetLargestFreeRun()
+            <<" fragmentation="<<ba.GetExternalFragmentation()<<endl;
+
+        for(BlockAllocator::UserNode *un:nodes)
+            assert(ba.Release(un));
+
+        assert(ba.GetFreeCount()==BLOCK_COUNT);
+        assert(ba.GetFreeRunCount()==1&&ba.GetLargestFreeRun()==BLOCK_COUNT);
+        assert(ba.GetExternalFragmentation()==0);
+        cout<<"  ✓ Matches occupancy table, fully coalesces"<<endl;
+    }
+
+    // 2) 最佳适配：同样大小取最靠前的
+    {
+        BlockAllocator ba;
+        ba.Init(100);
+
+        BlockAllocator::UserNode *un[10];
+        for(int i=0;i<10;i++)
+            un[i]=ba.Acquire(10);
+
+        ba.Release(un[6]);          //[60,10]
+        ba.Release(un[2]);          //[20,10]
+        ba.Release(un[8]);
+        ba.Release(un[9]);          //[80,20]
+
+        BlockAllocator::UserNode *a=ba.Acquire(5);
+        assert(a->GetStart()==20);
+        BlockAllocator::UserNode *b=ba.Acquire(15);
+        assert(b->GetStart()==80);
+        assert(ba.GetLargestFreeRun()==10);
+        cout<<"  ✓ Best fit, lowest address on ties"<<endl;
+    }
+
+    // 3) 大量数据块
+    {
+        constexpr int BLOCK_COUNT=1<<20;
+        constexpr int NODE_COUNT=200000;
+
+        BlockAllocator ba;
+        ba.Init(BLOCK_COUNT);
+
+        vector<BlockAllocator::UserNode *> nodes;
+        nodes.reserve(NODE_COUNT);
+
+        const auto t0=chrono::steady_clock::now();
+
+        for(int i=0;i<NODE_COUNT;i++)
+            nodes.push_back(ba.Acquire(1+gen()%8));
+
+        for(int i=0;i<NODE_COUNT;i+=2)              //制造大量碎片
+            ba.Release(nodes[i]);
+
+        int ok=0;
+        for(int i=0;i<NODE_COUNT;i++)
+        {
+            BlockAllocator::UserNode *un=ba.Acquire(1+gen()%8);
+
+            if(un)
+            {
+                ++ok;
+                ba.Release(un);
+            }
+        }
+
+        const double ms=chrono::duration<double,milli>(chrono::steady_clock::now()-t0).count();
+
+        cout<<"  "<<NODE_COUNT<<" blocks, "<<ba.GetFreeRunCount()<<" free runs: "<<ms<<" ms ("<<ok<<" reacquired)"<<endl;
+        cout<<"  fragmentation="<<ba.GetExternalFragmentation()<<endl;
+    }
+
+    cout<<"All tests passed!"<<endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+﻿#include<hgl/type/ConcurrentLRUCache.h>
+
+#include<iostream>
+#include<thread>
+#include<vector>
+#include<atomic>
+#include<chrono>
+
+using namespace hgl;
+using namespace std;
+
+/**
+ * 平方数缓存：Get时不存在则计算key*key
+ */
+class SquareCache:public ConcurrentLRUCache<int,int>
+{
+public:
+
+    atomic<int> create_count{0};
+
+    using ConcurrentLRUCache<int,int>::ConcurrentLRUCache;
+
+protected:
+
+    bool Create(const int &key,int &value) override
+    {
+        value=key*key;
+        ++create_count;
+        return(true);
+    }
+};
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+int main(int,char **)
+{
+    bool ok=true;
+
+    cout<<"=== Test 1: Multi-thread Get ==="<<endl;
+    {
+        SquareCache cache(1600);
+        atomic<int> error_count{0};
+
+        vector<thread> threads;
+
+        for(int t=0;t<8;t++)
+            threads.emplace_back([&cache,&error_count,t]
+            {
+                for(int i=0;i<100000;i++)
+                {
+                    const int key=(i*7+t)%3000;
+                    int value;
+
+                    if(!cache.Get(key,value)||value!=key*key)
+                        ++error_count;
+                }
+            });
+
+        for(thread &th:threads)
+            th.join();
+
+        ok&=Check(error_count==0,"all values correct");
+        ok&=Check(cache.GetCount()<=1600,"count within capacity");
+        cout<<"  Create called "<<cache.create_count<<" times"<<endl;
+    }
+
+    cout<<"\n=== Test 2: FindBatch ==="<<endl;
+    {
+        ConcurrentLRUCache<int,int> cache(1000);
+
+        int keys[200];
+        int values[200];
+        bool found[200];
+
+        for(int i=0;i<200;i++)
+        {
+            keys[i]=i;
+
+            if(i<100)
+                cache.Add(i,i+1);
+        }
+
+        const int hit=cache.FindBatch(keys,values,found,200);
+
+        bool match=true;
+        for(int i=0;i<200;i++)
+            if(found[i]!=(i<100)||(i<100&&values[i]!=i+1))
+                match=false;
+
+        ok&=Check(hit==100,"100 of 200 keys found");
+        ok&=Check(match,"found flags and values match");
+    }
+
+    cout<<"\n=== Test 3: TTL expiry ==="<<endl;
+    {
+        ConcurrentLRUCache<int,int> cache(100,0,20);
+        int value;
+
+        cache.Add(1,100);
+        cache.Add(2,200,0);             //永不过期
+        cache.Add(3,300,1000);
+
+        ok&=Check(cache.Find(1,value)&&value==100,"item 1 alive before TTL");
+
+        this_thread::sleep_for(chrono::milliseconds(50));
+
+        ok&=Check(!cache.Find(1,value),"item 1 expired after TTL");
+        ok&=Check(cache.Find(2,value)&&value==200,"item 2 without TTL still alive");
+        ok&=Check(cache.Find(3,value)&&value==300,"item 3 with longer TTL still alive");
+
+        cache.Add(4,400);
+        this_thread::sleep_for(chrono::milliseconds(50));
+
+        ok&=Check(cache.RemoveExpired()==1,"RemoveExpired removes item 4");
+        ok&=Check(cache.GetCount()==2,"2 items remain");
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
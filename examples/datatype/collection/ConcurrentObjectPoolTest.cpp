@@ -0,0 +1,240 @@
+﻿#include<hgl/type/ConcurrentObjectPool.h>
+#include<hgl/type/FixedValuePool.h>
+
+#include<iostream>
+#include<thread>
+#include<vector>
+#include<atomic>
+#include<mutex>
+#include<chrono>
+#include<set>
+
+using namespace hgl;
+using namespace std;
+
+struct Slot
+{
+    int owner;
+    int value;
+};
+
+struct Resource
+{
+    static atomic<int> alive;
+
+    int owner=-1;
+
+    Resource(){++alive;}
+    ~Resource(){--alive;}
+};
+
+atomic<int> Resource::alive{0};
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+int main(int,char **)
+{
+    bool ok=true;
+
+    constexpr int THREAD_COUNT=4;
+
+    cout<<"[1] Single thread"<<endl;
+    {
+        ConcurrentFixedValuePool<Slot,8> pool;
+        pool.Init(100);
+
+        set<Slot *> got;
+        Slot *s;
+
+        while((s=pool.Acquire()))
+            got.insert(s);
+
+        ok&=Check(got.size()==100,"acquire every slot exactly once");
+        ok&=Check(*got.begin()==pool.GetRawData(),"slots start at data_array");
+        ok&=Check(pool.GetIdleCount()==0,"no idle slots when exhausted");
+        ok&=Check(!pool.Release(pool.GetRawData()+100),"reject out of range release");
+
+        for(Slot *p:got)
+            pool.Release(p);
+
+        ok&=Check(pool.GetIdleCount()==100,"all slots idle after release");
+        ok&=Check(pool.GetThreadCacheCount()==1,"one thread cache");
+
+        pool.FlushThreadCache();
+        ok&=Check(pool.GetCachedIdleCount()==0&&pool.GetDepotIdleCount()==100,"flush moves cached slots to depot");
+    }
+
+    cout<<"[2] Concurrent acquire/release"<<endl;
+    {
+        ConcurrentFixedValuePool<Slot> pool;
+        pool.Init(THREAD_COUNT*256);
+
+        atomic<int> conflicts{0};
+        atomic<int> failures{0};
+        vector<thread> threads;
+
+        for(int t=0;t<THREAD_COUNT;t++)
+            threads.emplace_back([&,t]
+            {
+                vector<Slot *> held;
+
+                for(int round=0;round<2000;round++)
+                {
+                    const int n=1+(round*7+t)%100;
+
+                    for(int i=0;i<n;i++)
+                    {
+                        Slot *s=pool.Acquire();
+
+                        if(!s){++failures;continue;}
+
+                        s->owner=t;
+                        s->value=round;
+                        held.push_back(s);
+                    }
+
+                    for(Slot *s:held)
+                    {
+                        if(s->owner!=t||s->value!=round)
+                            ++conflicts;
+
+                        pool.Release(s);
+                    }
+
+                    held.clear();
+                }
+
+                pool.FlushThreadCache();
+            });
+
+        for(thread &th:threads)
+            th.join();
+
+        ok&=Check(conflicts==0,"no slot handed to two threads at once");
+        ok&=Check(failures==0,"pool never ran dry");
+        ok&=Check(pool.GetIdleCount()==pool.GetMaxCount(),"every slot returned");
+
+        cout<<"  exchanges="<<pool.GetExchangeCount()<<" fills="<<pool.GetFillCount()
+            <<" caches="<<pool.GetThreadCacheCount()<<endl;
+    }
+
+    cout<<"[3] Release on another thread"<<endl;
+    {
+        ConcurrentFixedValuePool<Slot,16> pool;
+        pool.Init(1000);
+
+        vector<Slot *> handoff;
+
+        thread producer([&]{for(int i=0;i<1000;i++)handoff.push_back(pool.Acquire());});
+        producer.join();
+
+        thread consumer([&]{for(Slot *s:handoff)pool.Release(s);pool.FlushThreadCache();});
+        consumer.join();
+
+        set<Slot *> again;
+        Slot *s;
+
+        while((s=pool.Acquire()))
+            again.insert(s);
+
+        ok&=Check(again.size()==1000,"slots released elsewhere are reusable");
+    }
+
+    cout<<"[4] ConcurrentPointerObjectPool"<<endl;
+    {
+        Resource *kept;
+
+        {
+            ConcurrentPointerObjectPool<Resource> pool;
+            pool.Init();
+
+            for(int i=0;i<500;i++)
+                pool.AddObject(new Resource);
+
+            atomic<int> conflicts{0};
+            vector<thread> threads;
+
+            for(int t=0;t<THREAD_COUNT;t++)
+                threads.emplace_back([&,t]
+                {
+                    for(int round=0;round<2000;round++)
+                    {
+                        Resource *r=pool.Acquire();
+
+                        if(!r)continue;
+
+                        r->owner=t;
+                        this_thread::yield();
+
+                        if(r->owner!=t)
+                            ++conflicts;
+
+                        pool.Release(r);
+                    }
+                });
+
+            for(thread &th:threads)
+                th.join();
+
+            ok&=Check(conflicts==0,"no object handed to two threads at once");
+            ok&=Check(pool.GetIdleCount()==500,"all objects idle (some left in thread caches)");
+
+            kept=pool.Acquire();
+            ok&=Check(kept!=nullptr,"acquire after workers exit");
+        }
+
+        ok&=Check(Resource::alive==1,"destructor deleted idle objects, including thread caches");
+        delete kept;
+    }
+
+    cout<<"[5] Throughput vs FixedValuePool + mutex"<<endl;
+    {
+        constexpr int OPS=200000;
+
+        auto run=[&](auto &&acquire,auto &&release)
+        {
+            const auto t0=chrono::steady_clock::now();
+            vector<thread> threads;
+
+            for(int t=0;t<THREAD_COUNT;t++)
+                threads.emplace_back([&]
+                {
+                    Slot *held[8];
+
+                    for(int i=0;i<OPS;i+=8)
+                    {
+                        for(int k=0;k<8;k++)held[k]=acquire();
+                        for(int k=0;k<8;k++)release(held[k]);
+                    }
+                });
+
+            for(thread &th:threads)
+                th.join();
+
+            return chrono::duration<double,milli>(chrono::steady_clock::now()-t0).count();
+        };
+
+        FixedValuePool<Slot> locked_pool;
+        locked_pool.Init(THREAD_COUNT*64);
+        mutex pool_lock;
+
+        const double locked_ms=run([&]{lock_guard<mutex> lg(pool_lock);return locked_pool.Acquire();},
+                                   [&](Slot *s){lock_guard<mutex> lg(pool_lock);locked_pool.Release(s);});
+
+        ConcurrentFixedValuePool<Slot> cached_pool;
+        cached_pool.Init(THREAD_COUNT*64);
+
+        const double cached_ms=run([&]{return cached_pool.Acquire();},
+                                   [&](Slot *s){cached_pool.Release(s);});
+
+        cout<<"  mutex: "<<locked_ms<<" ms, thread cache: "<<cached_ms<<" ms"
+            <<" (exchanges="<<cached_pool.GetExchangeCount()<<")"<<endl;
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
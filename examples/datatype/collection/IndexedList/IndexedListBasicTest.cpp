@@ -323,6 +323,69 @@ void test_shrink_reorder()
     }
 }
 
+void test_defragment()
+{
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "TEST 7: Defragment and Auto Reorder" << std::endl;
+    std::cout << "========================================\n" << std::endl;
+
+    std::cout << "[7.1] Reorder drains free slots:" << std::endl;
+    IndexedList<int> list;
+    for (int i = 0; i < 10; i++) {
+        list.Add(i * 10);
+    }
+    list.Delete(2, 3);
+    list.Exchange(0, list.GetCount()-1);
+    list.Reorder();
+    PrintList("After reorder", list);
+    TEST_ASSERT(list.IsOrdered(), "List is ordered");
+    TEST_ASSERT(list.GetFreeCount() == 0, "No free slots after reorder");
+    TEST_ASSERT((int)list.GetRawData().size() == list.GetCount(), "Data array has no holes");
+    TEST_ASSERT(list[0] == 90 && list[1] == 10 && list[6] == 0, "Logical order preserved");
+
+    list.Add(100);
+    TEST_ASSERT(list[6] == 0 && list[7] == 100, "Add after reorder does not overwrite data");
+
+    std::cout << "\n[7.2] Defragment releases memory:" << std::endl;
+    IndexedList<int> big;
+    for (int i = 0; i < 1000; i++) {
+        big.Add(i);
+    }
+    big.Delete(0, 900);
+    big.Defragment();
+    TEST_ASSERT(big.GetCount() == 100 && big[0] == 900 && big[99] == 999, "Data preserved");
+    TEST_ASSERT(big.GetAllocCount() == 100, "Capacity shrunk to count");
+
+    std::cout << "\n[7.3] Auto reorder after churn:" << std::endl;
+    IndexedList<int> auto_list;
+    auto_list.SetAutoReorder(8);
+    for (int i = 0; i < 20; i++) {
+        auto_list.Add(i);
+    }
+    TEST_ASSERT(auto_list.GetChurnCount() == 0, "Appending is not churn");
+
+    for (int i = 0; i < 7; i++) {
+        auto_list.Exchange(i, 19 - i);
+    }
+    TEST_ASSERT(!auto_list.IsOrdered() && auto_list.GetChurnCount() == 7, "Below threshold keeps index order");
+
+    auto_list.Delete(10, 1);
+    TEST_ASSERT(auto_list.IsOrdered() && auto_list.GetChurnCount() == 0, "Threshold triggers reorder");
+    TEST_ASSERT(auto_list.GetFreeCount() == 0, "Auto reorder drains free slots");
+    TEST_ASSERT(auto_list[0] == 19 && auto_list[6] == 13 && auto_list[7] == 7 && auto_list[10] == 11, "Logical order preserved");
+
+    int *p = nullptr;
+    auto_list.SetAutoReorder(1);
+    auto_list.Delete(0, 1);
+    p = auto_list.Add();
+    *p = 500;
+    TEST_ASSERT(auto_list[auto_list.GetCount()-1] == 500, "Add() pointer valid after triggered reorder");
+
+    auto_list.SetAutoReorder(0);
+    auto_list.Exchange(0, 1);
+    TEST_ASSERT(!auto_list.IsOrdered(), "Disabled auto reorder");
+}
+
 void test_edge_cases()
 {
     std::cout << "\n========================================" << std::endl;
@@ -424,6 +487,7 @@ int main()
     test_exchange_operations();
     test_iterator();
     test_shrink_reorder();
+    test_defragment();
     test_edge_cases();
     test_stress();
 
@@ -0,0 +1,152 @@
+﻿#include<hgl/type/LRUCache.h>
+
+#include<iostream>
+#include<string>
+#include<chrono>
+#include<memory>
+
+using namespace hgl;
+using namespace std;
+
+/**
+ * 按字节数淘汰的缓存：数据开销为字符串长度
+ */
+class StringCache:public LRUCache<int,string>
+{
+public:
+
+    int create_count=0;
+    int clear_count=0;
+
+    StringCache(int max_count,int64 max_bytes):LRUCache<int,string>(max_count,max_bytes){}
+
+protected:
+
+    bool Create(const int &key,string &value) override
+    {
+        value=string(key,'#');
+        ++create_count;
+        return(true);
+    }
+
+    void Clear(const int &,string &) override
+    {
+        ++clear_count;
+    }
+
+    int64 GetCost(const int &,const string &value) override
+    {
+        return (int64)value.size();
+    }
+};
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+int main(int,char **)
+{
+    bool ok=true;
+    int value;
+
+    cout<<"=== Test 1: Count based eviction ==="<<endl;
+    {
+        LRUCache<int,int> cache(3);
+
+        for(int i=0;i<5;i++)
+            cache.Add(i,i*10);
+
+        ok&=Check(cache.GetCount()==3,"count limited to 3");
+        ok&=Check(!cache.Find(0,value)&&!cache.Find(1,value),"oldest items evicted");
+        ok&=Check(cache.Find(2,value)&&value==20,"Find(2) moves it to front");
+
+        cache.Add(5,50);
+
+        ok&=Check(!cache.Contains(3),"item 3 evicted instead of recently used item 2");
+        ok&=Check(cache.Contains(2)&&cache.Contains(4)&&cache.Contains(5),"items 2,4,5 remain");
+
+        cache.Add(4,44);
+        ok&=Check(cache.Find(4,value)&&value==44&&cache.GetCount()==3,"Add on existing key replaces value");
+
+        cache.DeleteByKey(4);
+        ok&=Check(cache.GetCount()==2&&!cache.Contains(4),"DeleteByKey");
+    }
+
+    cout<<"\n=== Test 2: Byte budget eviction ==="<<endl;
+    {
+        StringCache cache(1000,100);
+        string str;
+
+        cache.Get(40,str);
+        cache.Get(40,str);
+        cache.Get(30,str);
+
+        ok&=Check(cache.create_count==2,"Get creates each key once");
+        ok&=Check(cache.GetTotalCost()==70,"total cost = 70 bytes");
+
+        cache.Get(50,str);
+        ok&=Check(cache.GetTotalCost()==80&&!cache.Contains(40),"exceeding budget evicts oldest (40)");
+        ok&=Check(cache.clear_count==1,"Clear called for evicted item");
+
+        cache.SetMaxCost(60);
+        ok&=Check(cache.GetCount()==1&&cache.GetTotalCost()==50,"lowering budget evicts immediately");
+    }
+
+    cout<<"\n=== Test 3: Lookup performance (50000 items) ==="<<endl;
+    {
+        constexpr int COUNT=50000;
+
+        LRUCache<int,int> cache(COUNT);
+
+        for(int i=0;i<COUNT;i++)
+            cache.Add(i,i);
+
+        auto start=chrono::steady_clock::now();
+
+        int hit=0;
+        for(int i=0;i<COUNT;i++)
+            if(cache.Find(i,value)&&value==i)
+                ++hit;
+
+        auto end=chrono::steady_clock::now();
+
+        ok&=Check(hit==COUNT,"all items found");
+        cout<<"  Find x "<<COUNT<<": "<<chrono::duration_cast<chrono::microseconds>(end-start).count()<<" us"<<endl;
+
+        cache.Clear();
+        ok&=Check(cache.GetCount()==0,"Clear");
+
+        for(int i=0;i<COUNT;i++)
+            cache.Add(i,i);
+
+        ok&=Check(cache.GetCount()==COUNT,"nodes reused after Clear");
+    }
+
+    cout<<"\n=== Test 4: Evicted values are released ==="<<endl;
+    {
+        LRUCache<int,shared_ptr<int>> cache(2);
+
+        weak_ptr<int> w[4];
+
+        for(int i=0;i<4;i++)
+        {
+            auto p=make_shared<int>(i);
+            w[i]=p;
+            cache.Add(i,p);
+        }
+
+        ok&=Check(w[0].expired()&&w[1].expired(),"evicted values destroyed");
+        ok&=Check(!w[2].expired()&&!w[3].expired(),"cached values alive");
+
+        cache.DeleteByKey(2);
+        ok&=Check(w[2].expired(),"deleted value destroyed");
+
+        cache.Clear();
+        ok&=Check(w[3].expired(),"Clear destroys values");
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
@@ -0,0 +1,196 @@
+﻿#include<hgl/type/LockFreeFixedValuePool.h>
+#include<hgl/type/FixedValuePool.h>
+
+#include<iostream>
+#include<thread>
+#include<vector>
+#include<atomic>
+#include<mutex>
+#include<chrono>
+#include<set>
+
+using namespace hgl;
+using namespace std;
+
+struct Slot
+{
+    int owner;
+    int value;
+};
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+/**
+ * 多个线程反复取得/归还，检查同一位置不会同时交给两个线程
+ */
+template<typename P> static bool Stress(P &pool,const int thread_count,const int rounds)
+{
+    atomic<int> conflicts{0};
+    vector<thread> threads;
+
+    for(int t=0;t<thread_count;t++)
+        threads.emplace_back([&,t]
+        {
+            vector<Slot *> held;
+
+            for(int round=0;round<rounds;round++)
+            {
+                const int n=1+(round*5+t)%16;
+
+                for(int i=0;i<n;i++)
+                {
+                    Slot *s=pool.Acquire();
+
+                    if(!s)continue;
+
+                    s->owner=t;
+                    s->value=round;
+                    held.push_back(s);
+                }
+
+                for(Slot *s:held)
+                {
+                    if(s->owner!=t||s->value!=round)
+                        ++conflicts;
+
+                    pool.Release(s);
+                }
+
+                held.clear();
+            }
+        });
+
+    for(thread &th:threads)
+        th.join();
+
+    return conflicts==0;
+}
+
+int main(int,char **)
+{
+    bool ok=true;
+
+    constexpr int THREAD_COUNT=4;
+
+    cout<<"[1] Single thread"<<endl;
+    {
+        LockFreeFixedValuePool<Slot> pool;
+
+        ok&=Check(pool.Acquire()==nullptr,"acquire before Init fails");
+        ok&=Check(pool.Init(100),"init");
+        ok&=Check(!pool.Init(100),"init twice fails");
+
+        set<Slot *> got;
+        Slot *s;
+
+        while((s=pool.Acquire()))
+            got.insert(s);
+
+        ok&=Check(got.size()==100,"acquire every slot exactly once");
+        ok&=Check(*got.begin()==pool.Get(0),"slots start at index 0");
+        ok&=Check(pool.GetUseCount()==100&&pool.GetEmptyCount()==1,"use count and empty counter");
+
+        Slot outside;
+        ok&=Check(!pool.Release(&outside),"reject foreign pointer");
+
+        ok&=Check(pool.Release(pool.Get(42)),"release");
+        ok&=Check(!pool.Release(pool.Get(42)),"reject double release");
+        ok&=Check(pool.Acquire()==pool.Get(42),"LIFO reuse of released slot");
+
+        for(Slot *p:got)
+            pool.Release(p);
+
+        ok&=Check(pool.GetFreeCount()==100,"all slots free");
+        ok&=Check(pool.GetAcquireRetryCount()==0&&pool.GetReleaseRetryCount()==0,"no retries without contention");
+    }
+
+    cout<<"[2] Cache line aligned layout"<<endl;
+    {
+        LockFreeFixedValuePool<Slot,true> pool;
+        pool.Init(16);
+
+        Slot *a=pool.Acquire();
+        Slot *b=pool.Acquire();
+
+        ok&=Check(((uintptr_t)a%64)==0&&((uintptr_t)b%64)==0,"slots are 64 byte aligned");
+        ok&=Check(pool.GetIndex(a)==0&&pool.GetIndex(b)==1,"index from pointer");
+        ok&=Check(!pool.Release((Slot *)((char *)a+8)),"reject pointer inside a slot");
+        ok&=Check(pool.Release(a)&&pool.Release(b),"release");
+    }
+
+    cout<<"[3] Concurrent acquire/release"<<endl;
+    {
+        LockFreeFixedValuePool<Slot> pool;
+        pool.Init(THREAD_COUNT*16);
+
+        ok&=Check(Stress(pool,THREAD_COUNT,20000),"no slot handed to two threads at once");
+        ok&=Check(pool.GetUseCount()==0,"every slot returned");
+
+        set<Slot *> got;
+        Slot *s;
+
+        while((s=pool.Acquire()))
+            got.insert(s);
+
+        ok&=Check((int)got.size()==pool.GetMaxCount(),"free list intact after stress");
+
+        cout<<"  acquire retries="<<pool.GetAcquireRetryCount()
+            <<" release retries="<<pool.GetReleaseRetryCount()
+            <<" empty="<<pool.GetEmptyCount()<<endl;
+    }
+
+    cout<<"[4] Aligned layout under contention"<<endl;
+    {
+        LockFreeFixedValuePool<Slot,true> pool;
+        pool.Init(THREAD_COUNT*16);
+
+        ok&=Check(Stress(pool,THREAD_COUNT,20000),"no slot handed to two threads at once");
+        ok&=Check(pool.GetUseCount()==0,"every slot returned");
+    }
+
+    cout<<"[5] Throughput vs FixedValuePool + mutex"<<endl;
+    {
+        constexpr int OPS=200000;
+
+        auto run=[&](auto &&acquire,auto &&release)
+        {
+            const auto t0=chrono::steady_clock::now();
+            vector<thread> threads;
+
+            for(int t=0;t<THREAD_COUNT;t++)
+                threads.emplace_back([&]
+                {
+                    for(int i=0;i<OPS;i++)
+                        release(acquire());
+                });
+
+            for(thread &th:threads)
+                th.join();
+
+            return chrono::duration<double,milli>(chrono::steady_clock::now()-t0).count();
+        };
+
+        FixedValuePool<Slot> locked_pool;
+        locked_pool.Init(THREAD_COUNT*4);
+        mutex pool_lock;
+
+        const double locked_ms=run([&]{lock_guard<mutex> lg(pool_lock);return locked_pool.Acquire();},
+                                   [&](Slot *s){lock_guard<mutex> lg(pool_lock);locked_pool.Release(s);});
+
+        LockFreeFixedValuePool<Slot> lock_free_pool;
+        lock_free_pool.Init(THREAD_COUNT*4);
+
+        const double lock_free_ms=run([&]{return lock_free_pool.Acquire();},
+                                      [&](Slot *s){lock_free_pool.Release(s);});
+
+        cout<<"  mutex: "<<locked_ms<<" ms, lock-free: "<<lock_free_ms<<" ms"
+            <<" (CAS retries "<<lock_free_pool.GetAcquireRetryCount()+lock_free_pool.GetReleaseRetryCount()<<")"<<endl;
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
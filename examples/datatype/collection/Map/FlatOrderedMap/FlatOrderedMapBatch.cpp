@@ -0,0 +1,168 @@
+﻿#include<hgl/type/FlatOrderedMap.h>
+#include<iostream>
+#include<cassert>
+#include<map>
+#include<random>
+#include<chrono>
+
+using namespace hgl;
+using namespace std;
+
+template<typename K,typename V>
+static bool SameAs(const FlatOrderedMap<K,V> &map,const std::map<K,V> &ref)
+{
+    if(map.GetCount()!=(int64)ref.size())
+        return false;
+
+    int64 i=0;
+    for(const auto &[k,v]:ref)
+    {
+        if(map.GetKeyAt(i)!=k||map.GetValueAt(i)!=v)
+            return false;
+        ++i;
+    }
+
+    return true;
+}
+
+int os_main(int, os_char**)
+{
+    cout << "\n========================================" << endl;
+    cout << "TEST 08: FlatOrderedMap<K,V> Batch Add / Delete" << endl;
+    cout << "========================================" << endl;
+
+    cout << "\n[8.1] BuildFrom with duplicate policies:" << endl;
+    {
+        const int keys[]  ={5,  -3, 5,  9,  -3, 0};
+        const int values[]={50, 30, 51, 90, 31, 0};
+
+        FlatOrderedMap<int,int> first,last;
+
+        assert(first.BuildFrom(keys,values,6)==4);
+        assert(last.BuildFrom(keys,values,6,BatchDuplicatePolicy::KeepLast)==4);
+
+        assert(first.GetKeyAt(0)==-3&&first.GetKeyAt(3)==9);
+        assert(*first.GetValuePointer(5)==50&&*first.GetValuePointer(-3)==30);
+        assert(*last.GetValuePointer(5)==51&&*last.GetValuePointer(-3)==31);
+        cout << "  ✓ KeepFirst / KeepLast resolve duplicates inside the batch" << endl;
+    }
+
+    cout << "\n[8.2] AddBatch merges into existing data:" << endl;
+    {
+        FlatOrderedMap<int,int> map;
+        map.Add(10,100);
+        map.Add(20,200);
+        map.Add(30,300);
+
+        const int keys[]  ={25, 10, 5,  35, 25};
+        const int values[]={250,101,50, 350,251};
+
+        assert(map.AddBatch(keys,values,5)==3);
+        assert(map.GetCount()==6);
+        assert(*map.GetValuePointer(10)==100&&*map.GetValuePointer(25)==250);
+
+        assert(map.AddBatch(keys,values,5,BatchDuplicatePolicy::KeepLast)==0);
+        assert(*map.GetValuePointer(10)==101&&*map.GetValuePointer(25)==251);
+
+        for(int64 i=1;i<map.GetCount();i++)
+            assert(map.GetKeyAt(i-1)<map.GetKeyAt(i));
+
+        cout << "  ✓ New keys merged in order, existing keys kept or overwritten by policy" << endl;
+    }
+
+    cout << "\n[8.3] DeleteBatch:" << endl;
+    {
+        FlatOrderedMap<int,int> map;
+        for(int i=0;i<10;i++)
+            map.Add(i,i*10);
+
+        const int del[]={7,3,3,42,0};
+        assert(map.DeleteBatch(del,5)==3);
+        assert(map.GetCount()==7);
+        assert(!map.ContainsKey(0)&&!map.ContainsKey(3)&&!map.ContainsKey(7));
+        assert(*map.GetValuePointer(8)==80);
+        cout << "  ✓ Deleted 3 keys in one pass, values stay aligned" << endl;
+    }
+
+    cout << "\n[8.4] Randomized comparison with std::map:" << endl;
+    {
+        mt19937 rng(8);
+
+        FlatOrderedMap<int64,uint32> map;
+        std::map<int64,uint32> ref;
+
+        for(int round=0;round<20;round++)
+        {
+            const int count=(int)(rng()%2000)+1;
+            vector<int64> keys(count);
+            vector<uint32> values(count);
+
+            for(int i=0;i<count;i++)
+            {
+                keys[i]=(int64)(rng()%5000)-2500;
+                values[i]=rng();
+            }
+
+            const BatchDuplicatePolicy policy=(round&1)?BatchDuplicatePolicy::KeepLast:BatchDuplicatePolicy::KeepFirst;
+
+            int64 expect_added=0;
+            for(int i=0;i<count;i++)
+            {
+                auto it=ref.find(keys[i]);
+                if(it==ref.end())
+                {
+                    ref[keys[i]]=values[i];
+                    ++expect_added;
+                }
+                else if(policy==BatchDuplicatePolicy::KeepLast)
+                    it->second=values[i];
+            }
+
+            assert(map.AddBatch(keys.data(),values.data(),count,policy)==expect_added);
+
+            const int del_count=(int)(rng()%500);
+            vector<int64> del(del_count);
+            int64 expect_deleted=0;
+
+            for(int i=0;i<del_count;i++)
+            {
+                del[i]=(int64)(rng()%5000)-2500;
+                expect_deleted+=ref.erase(del[i]);
+            }
+
+            assert(map.DeleteBatch(del.data(),del_count)==expect_deleted);
+            assert(SameAs(map,ref));
+        }
+
+        cout << "  ✓ 20 rounds of AddBatch/DeleteBatch match std::map" << endl;
+    }
+
+    cout << "\n[8.5] Bulk load of 1M unsorted pairs:" << endl;
+    {
+        constexpr int COUNT=1000000;
+
+        mt19937 rng(1);
+        vector<uint32> keys(COUNT),values(COUNT);
+
+        for(int i=0;i<COUNT;i++)
+        {
+            keys[i]=rng();
+            values[i]=i;
+        }
+
+        FlatOrderedMap<uint32,uint32> map;
+
+        const auto t0=chrono::steady_clock::now();
+        map.BuildFrom(keys.data(),values.data(),COUNT);
+        const double ms=chrono::duration<double,milli>(chrono::steady_clock::now()-t0).count();
+
+        for(int64 i=1;i<map.GetCount();i++)
+            assert(map.GetKeyAt(i-1)<map.GetKeyAt(i));
+
+        assert(map.GetValueAt(map.Find(keys[12345]))<=12345u);
+        cout << "  ✓ BuildFrom(" << COUNT << ") took " << ms << " ms, " << map.GetCount() << " unique keys" << endl;
+    }
+
+    cout << "\n✅ TEST 08 PASSED" << endl;
+    return 0;
+}
@@ -0,0 +1,128 @@
+﻿#include<hgl/type/FlatOrderedMap.h>
+#include<iostream>
+#include<cassert>
+#include<random>
+#include<chrono>
+
+using namespace hgl;
+using namespace std;
+
+int os_main(int, os_char**)
+{
+    cout << "\n========================================" << endl;
+    cout << "TEST 09: FlatOrderedMap<K,V> Freeze (B+ tree search index)" << endl;
+    cout << "========================================" << endl;
+
+    cout << "\n[9.1] Frozen Find matches binary search for every size:" << endl;
+    {
+        for (int count : {0, 1, 15, 16, 17, 255, 256, 257, 4096, 4097, 70001})
+        {
+            FlatOrderedMap<int, int> map;
+
+            for (int i = 0; i < count; i++)
+                map.Add(i * 3, i);
+
+            map.Freeze();
+            assert(map.IsFrozen());
+
+            // 覆盖命中、落在两个键之间、小于最小键、大于最大键
+            for (int k = -3; k <= count * 3 + 3; k++)
+            {
+                const int64 index = map.Find(k);
+
+                if (k >= 0 && k % 3 == 0 && k / 3 < count)
+                    assert(index == k / 3);
+                else
+                    assert(index == -1);
+            }
+        }
+
+        cout << "  ✓ Sizes 0..70001, hits and misses on both sides" << endl;
+    }
+
+    cout << "\n[9.2] Key changes thaw, value changes do not:" << endl;
+    {
+        FlatOrderedMap<int, int> map;
+        for (int i = 0; i < 1000; i++)
+            map.Add(i, i);
+
+        map.Freeze();
+
+        map.Change(10, -10);
+        map.AddOrUpdate(20, -20);
+        assert(map.IsFrozen());
+        assert(*map.GetValuePointer(10) == -10 && *map.GetValuePointer(20) == -20);
+
+        assert(!map.Add(30, 0));                // 已存在，键未改变
+        assert(map.IsFrozen());
+
+        map.Add(5000, 5000);
+        assert(!map.IsFrozen() && map.ContainsKey(5000));
+
+        map.Freeze();
+        map.DeleteByKey(500);
+        assert(!map.IsFrozen() && !map.ContainsKey(500));
+
+        map.Freeze();
+        const int keys[] = {-1, 2000};
+        const int values[] = {-1, 2000};
+        map.AddBatch(keys, values, 2);
+        assert(!map.IsFrozen() && map.ContainsKey(-1) && map.ContainsKey(2000));
+
+        map.Freeze();
+        FlatOrderedMap<int, int> copy = map;     // 索引只保存分隔键，可随容器复制
+        assert(copy.IsFrozen() && copy.ContainsKey(2000) && !copy.ContainsKey(500));
+
+        map.Clear();
+        assert(!map.IsFrozen() && map.GetFrozenIndexSize() == 0);
+        cout << "  ✓ Add/Delete/AddBatch/Clear thaw, Change/AddOrUpdate keep the index" << endl;
+    }
+
+    cout << "\n[9.3] Lookup throughput on a 4M entry table:" << endl;
+    {
+        constexpr int COUNT = 4 * 1024 * 1024;
+        constexpr int LOOKUPS = 4 * 1024 * 1024;
+
+        mt19937 rng(9);
+
+        vector<uint32> keys(COUNT), values(COUNT);
+        for (int i = 0; i < COUNT; i++)
+        {
+            keys[i] = rng();
+            values[i] = i;
+        }
+
+        FlatOrderedMap<uint32, uint32> map;
+        map.BuildFrom(keys.data(), values.data(), COUNT);
+
+        vector<uint32> probes(LOOKUPS);
+        for (auto& p : probes)
+            p = (rng() & 1) ? keys[rng() % COUNT] : rng();
+
+        auto run = [&]()
+        {
+            int64 found = 0;
+            const auto t0 = chrono::steady_clock::now();
+
+            for (const uint32 p : probes)
+                found += map.ContainsKey(p);
+
+            const double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+            return make_pair(found, ms);
+        };
+
+        const auto [plain_found, plain_ms] = run();
+
+        map.Freeze();
+        const auto [frozen_found, frozen_ms] = run();
+
+        assert(plain_found == frozen_found);
+
+        cout << "  binary search: " << plain_ms << " ms" << endl;
+        cout << "  frozen index : " << frozen_ms << " ms (index " << map.GetFrozenIndexSize() / 1024 << " KB)" << endl;
+        cout << "  ✓ Same results, speedup x" << plain_ms / frozen_ms << endl;
+    }
+
+    cout << "\n✅ TEST 09 PASSED" << endl;
+    return 0;
+}
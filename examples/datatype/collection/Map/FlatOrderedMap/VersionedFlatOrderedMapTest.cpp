@@ -0,0 +1,239 @@
+﻿#include<hgl/type/VersionedFlatOrderedMap.h>
+#include<iostream>
+#include<cassert>
+#include<map>
+#include<random>
+#include<thread>
+#include<atomic>
+#include<vector>
+
+using namespace hgl;
+using namespace std;
+
+using VMap = VersionedFlatOrderedMap<int, int, 16, 8>;
+
+static bool SameAs(const VMap::Snapshot& snapshot, const std::map<int, int>& ref)
+{
+    if (snapshot.GetCount() != (int64)ref.size())
+        return false;
+
+    auto it = ref.begin();
+    bool same = true;
+
+    snapshot.EnumKV([&](const int& k, const int& v)
+    {
+        if (it == ref.end() || it->first != k || it->second != v)
+            same = false;
+        else
+            ++it;
+    });
+
+    return same;
+}
+
+int os_main(int, os_char**)
+{
+    cout << "\n========================================" << endl;
+    cout << "TEST 10: VersionedFlatOrderedMap (copy-on-write snapshots)" << endl;
+    cout << "========================================" << endl;
+
+    cout << "\n[10.1] Snapshots are immutable:" << endl;
+    {
+        VMap map;
+        auto reader = map.GetReader();
+        assert(reader.IsValid());
+
+        for (int i = 0; i < 100; i++)
+            map.Add(i, i);
+
+        auto before = reader.Pin();
+
+        map.Change(50, -50);
+        map.DeleteByKey(10);
+        map.Add(1000, 1000);
+
+        {
+            auto after = reader.Pin();                  // 嵌套固定
+
+            assert(before.GetSerial() + 3 == after.GetSerial());
+            assert(*before.GetValuePointer(50) == 50 && before.ContainsKey(10) && !before.ContainsKey(1000));
+            assert(*after.GetValuePointer(50) == -50 && !after.ContainsKey(10) && after.ContainsKey(1000));
+        }
+
+        assert(map.GetRetiredCount() > 0);              // before仍被固定
+
+        before.Release();
+        map.Reclaim();
+        assert(map.GetRetiredCount() == 0);
+
+        assert(!before.IsValid() && before.GetChunkCount() == 0 && before.GetChunk(0) == nullptr);
+        VMap::Snapshot empty;
+        assert(empty.GetChunk(0) == nullptr);
+        cout << "  ✓ Old snapshot unchanged, retired versions reclaimed after release" << endl;
+    }
+
+    cout << "\n[10.2] Writes copy only the touched chunk:" << endl;
+    {
+        VMap map;
+        auto reader = map.GetReader();
+
+        vector<int> keys(1000), values(1000);
+        for (int i = 0; i < 1000; i++)
+        {
+            keys[i] = i * 2;
+            values[i] = i;
+        }
+
+        map.BuildFrom(keys.data(), values.data(), 1000);
+
+        auto a = reader.Pin();
+        map.AddOrUpdate(500, 0);
+        auto b = reader.Pin();
+
+        assert(a.GetChunkCount() == b.GetChunkCount());
+
+        int changed = 0;
+        for (int64 i = 0; i < a.GetChunkCount(); i++)
+            changed += (a.GetChunk(i) != b.GetChunk(i));
+
+        assert(changed == 1);
+
+        assert(!map.Change(-1, 0));                    // 无修改，不发布
+        auto c = reader.Pin();
+        assert(c.GetSerial() == b.GetSerial());
+        cout << "  ✓ " << a.GetChunkCount() << " chunks, 1 copied by a single-key write" << endl;
+    }
+
+    cout << "\n[10.3] Random batches match std::map:" << endl;
+    {
+        VMap map;
+        auto reader = map.GetReader();
+        std::map<int, int> ref;
+        mt19937 rng(10);
+
+        for (int round = 0; round < 200; round++)
+        {
+            const int op = rng() % 4;
+            const int count = (int)(rng() % 200) + 1;
+
+            vector<int> k(count), v(count);
+            for (int i = 0; i < count; i++)
+            {
+                k[i] = (int)(rng() % 3000) - 1000;
+                v[i] = (int)rng();
+            }
+
+            if (op == 0)
+            {
+                int64 expect = 0;
+                for (int i = 0; i < count; i++)
+                    expect += ref.emplace(k[i], v[i]).second;
+
+                assert(map.AddBatch(k.data(), v.data(), count) == expect);
+            }
+            else if (op == 1)
+            {
+                for (int i = 0; i < count; i++)
+                    ref[k[i]] = v[i];
+
+                map.AddBatch(k.data(), v.data(), count, BatchDuplicatePolicy::KeepLast);
+            }
+            else if (op == 2)
+            {
+                int64 expect = 0;
+                for (int i = 0; i < count; i++)
+                    expect += ref.erase(k[i]);
+
+                assert(map.DeleteBatch(k.data(), count) == expect);
+            }
+            else
+            {
+                assert(map.Add(k[0], v[0]) == ref.emplace(k[0], v[0]).second);
+                assert(map.DeleteByKey(k[1 % count]) == (ref.erase(k[1 % count]) > 0));
+            }
+
+            auto snapshot = reader.Pin();
+            assert(SameAs(snapshot, ref));
+
+            for (int64 i = 0; i < snapshot.GetChunkCount(); i++)
+                assert(snapshot.GetChunk(i)->GetCount() <= 32 && snapshot.GetChunk(i)->GetCount() > 0);
+        }
+
+        cout << "  ✓ 200 rounds of AddBatch/DeleteBatch/Add/Delete, chunks stay within bounds" << endl;
+    }
+
+    cout << "\n[10.4] Concurrent readers during writes:" << endl;
+    {
+        // 不变量：每个版本中所有值之和为0(写者总是成对修改)
+        VMap map;
+
+        vector<int> keys(512), values(512, 0);
+        for (int i = 0; i < 512; i++)
+            keys[i] = i;
+
+        map.BuildFrom(keys.data(), values.data(), 512);
+
+        atomic<bool> stop{false};
+        atomic<int64> reads{0};
+        atomic<bool> consistent{true};
+
+        vector<thread> readers;
+        for (int t = 0; t < 4; t++)
+        {
+            readers.emplace_back([&]()
+            {
+                auto reader = map.GetReader();
+                int64 local = 0;
+
+                while (!stop.load(memory_order_relaxed))
+                {
+                    auto snapshot = reader.Pin();
+
+                    int64 sum = 0;
+                    snapshot.EnumKV([&](const int&, const int& v) { sum += v; });
+
+                    if (sum != 0 || snapshot.GetCount() != 512)
+                        consistent = false;
+
+                    ++local;
+                }
+
+                reads += local;
+            });
+        }
+
+        mt19937 rng(4);
+        for (int i = 0; i < 5000; i++)
+        {
+            const int a = rng() % 512, b = rng() % 512;
+            if (a == b)
+                continue;
+
+            const int delta = (int)(rng() % 100);
+
+            int k[2] = {a, b};
+            int v[2];
+            {
+                auto reader = map.GetReader();
+                auto snapshot = reader.Pin();
+                v[0] = *snapshot.GetValuePointer(a) + delta;
+                v[1] = *snapshot.GetValuePointer(b) - delta;
+            }
+
+            map.AddBatch(k, v, 2, BatchDuplicatePolicy::KeepLast);     // 一次发布两个修改
+        }
+
+        stop = true;
+        for (auto& t : readers)
+            t.join();
+
+        map.Reclaim();
+
+        assert(consistent);
+        assert(map.GetRetiredCount() == 0);
+        cout << "  ✓ " << reads.load() << " snapshot reads saw only complete versions, all retired versions reclaimed" << endl;
+    }
+
+    cout << "\n✅ TEST 10 PASSED" << endl;
+    return 0;
+}
@@ -246,5 +246,60 @@ int main(int,char **)
     cout<<"  10000-scale test: "<<(test10000 ? "PASSED" : "FAILED")<<"\n";
     cout<<"  Overall: "<<(test100 && test1000 && test10000 ? "ALL PASSED" : "SOME FAILED")<<"\n";
 
-    return 0;
+    // ==================== 分页ID索引 ====================
+    cout<<"\n\n========================================\n";
+    cout<<"   Paged ID Index Test\n";
+    cout<<"========================================\n";
+
+    bool page_ok=true;
+    {
+        MonotonicIDList<int> page_list;
+        constexpr int COUNT=1000000;
+
+        auto start=chrono::high_resolution_clock::now();
+
+        for(int i=0; i<COUNT; ++i)
+            page_list.Add(i);
+
+        auto after_add=chrono::high_resolution_clock::now();
+
+        const int pages_full=page_list.GetIndexPageCount();
+
+        // 先删除前一半：这些页内的ID都已分配且全部删除，应被释放
+        for(int id=1; id<=COUNT/2; ++id)
+            page_ok&=page_list.Remove(id);
+
+        const int pages_half=page_list.GetIndexPageCount();
+
+        int64 sum=0;
+        for(int id=1; id<=COUNT; ++id)
+        {
+            const int *v=page_list.Get(id);
+            if(v) sum+=*v;
+        }
+
+        auto after_lookup=chrono::high_resolution_clock::now();
+
+        page_ok&=!page_list.Remove(1)&&!page_list.Contains(COUNT+1)&&!page_list.Contains(0);
+        page_ok&=(page_list.Count()==COUNT/2);
+        page_ok&=(sum==int64(COUNT/2)*(COUNT/2+COUNT-1)/2);
+        page_ok&=(pages_half<pages_full/2+2);
+
+        // 复用空闲位置的新ID
+        const int new_id=page_list.AddGetID(-1);
+        page_ok&=(new_id==COUNT+1)&&(*page_list.Get(new_id)==-1);
+
+        for(int id=COUNT/2+1; id<=COUNT+1; ++id)
+            page_list.Remove(id);
+
+        // 最后一页仍可能分配新ID，保留
+        page_ok&=page_list.Empty()&&(page_list.GetIndexPageCount()<=1);
+
+        cout<<"  Index pages: "<<pages_full<<" -> "<<pages_half<<" after removing first half\n";
+        cout<<"  Add "<<COUNT<<": "<<chrono::duration<double,milli>(after_add-start).count()<<" ms\n";
+        cout<<"  Remove half + lookup all: "<<chrono::duration<double,milli>(after_lookup-after_add).count()<<" ms\n";
+        cout<<"  Verification: "<<(page_ok ? "PASSED" : "FAILED")<<"\n";
+    }
+
+    return (test100 && test1000 && test10000 && page_ok) ? 0 : 1;
 }
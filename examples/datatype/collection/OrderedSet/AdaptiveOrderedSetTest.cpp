@@ -0,0 +1,180 @@
+﻿#include<hgl/type/AdaptiveOrderedSet.h>
+#include<iostream>
+#include<cassert>
+#include<set>
+#include<vector>
+#include<random>
+#include<chrono>
+
+using namespace hgl;
+using namespace std;
+
+template<typename T>
+static vector<T> ToVector(const AdaptiveOrderedSet<T> &set)
+{
+    vector<T> result;
+    set.Enum([&](const T &v){result.push_back(v);});
+    return result;
+}
+
+int os_main(int, os_char**)
+{
+    cout << "\n========================================" << endl;
+    cout << "TEST 08: AdaptiveOrderedSet" << endl;
+    cout << "========================================" << endl;
+
+    mt19937 rng(8);
+
+    cout << "\n[8.1] Same results as std::set across forced switches:" << endl;
+    {
+        AdaptiveOrderedSet<int> set;
+        std::set<int> expect;
+
+        set.SetAutoAdapt(false);
+
+        for(int round=0;round<20;round++)
+        {
+            set.SetMode(round&1?AdaptiveSetMode::Flat:AdaptiveSetMode::Tree);
+
+            for(int i=0;i<200;i++)
+            {
+                const int v=int(rng()%1000);
+
+                if(rng()%3)
+                    assert(set.Add(v)==expect.insert(v).second);
+                else
+                    assert(set.Delete(v)==(expect.erase(v)>0));
+            }
+
+            assert(ToVector(set)==vector<int>(expect.begin(),expect.end()));
+
+            for(int v=0;v<1000;v+=7)
+                assert(set.Contains(v)==(expect.count(v)>0));
+        }
+
+        assert(set.GetMigrateCount()==19);
+        cout << "  ✓ Add/Delete/Contains/Enum match std::set in both modes" << endl;
+    }
+
+    cout << "\n[8.2] Batch, index and boundary access:" << endl;
+    {
+        AdaptiveOrderedSet<int> tree_set,flat_set;
+
+        tree_set.SetAutoAdapt(false);
+        flat_set.SetAutoAdapt(false);
+        flat_set.SetMode(AdaptiveSetMode::Flat);
+
+        const int values[]={9,3,7,3,1,5};
+        const int remove[]={3,4,9};
+
+        for(auto *set:{&tree_set,&flat_set})
+        {
+            assert(set->Add(values,6)==5);
+            assert(set->Delete(remove,3)==2);
+            assert(set->GetCount()==3);
+
+            int v;
+            assert(set->GetFirst(v)&&v==1);
+            assert(set->GetLast(v)&&v==7);
+            assert(set->Get(1,v)&&v==5);
+            assert(set->FindIndex(7)==2&&set->FindIndex(3)==-1);
+            assert(set->DeleteAt(0)&&!set->Contains(1));
+        }
+
+        assert(tree_set==flat_set);
+        flat_set.Add(100);
+        assert(tree_set!=flat_set);
+
+        tree_set.Clear();
+        assert(tree_set.IsEmpty()&&tree_set.GetMode()==AdaptiveSetMode::Tree);
+        cout << "  ✓ Batch add/delete, Get/FindIndex/DeleteAt, mixed-mode comparison" << endl;
+    }
+
+    cout << "\n[8.3] Automatic switching at phase boundaries:" << endl;
+    {
+        constexpr int COUNT=20000;
+
+        AdaptiveOrderedSet<int> set;
+
+        for(int i=0;i<COUNT;i++)
+            set.Add(int(rng()%(COUNT*4)));
+
+        assert(set.GetMode()==AdaptiveSetMode::Tree);
+
+        // 读取阶段：一个窗口后转为Flat
+        int64 hits=0;
+        for(int i=0;i<COUNT;i++)
+            hits+=set.Contains(i);
+
+        assert(set.GetMode()==AdaptiveSetMode::Flat);
+        cout << "  ✓ Lookup phase moved Tree -> Flat (" << hits << " hits)" << endl;
+
+        // 批量写入在Flat上是线性合并，不切换
+        vector<int> batch;
+        for(int i=0;i<1000;i++)
+            batch.push_back(COUNT*4+i);
+
+        set.Add(batch.data(),(int64)batch.size());
+        assert(set.GetMode()==AdaptiveSetMode::Flat);
+        cout << "  ✓ Batch add stays Flat" << endl;
+
+        // 单元素写入阶段：转回Tree
+        for(int i=0;i<1000;i++)
+            set.Add(-1-i);
+
+        assert(set.GetMode()==AdaptiveSetMode::Tree);
+        cout << "  ✓ Single-element write burst moved Flat -> Tree" << endl;
+
+        set.Optimize();
+        assert(set.GetMode()==AdaptiveSetMode::Flat);
+        int v;
+        assert(set.GetFirst(v)&&v==-1000);
+        cout << "  ✓ Optimize() switches to Flat" << endl;
+    }
+
+    cout << "\n[8.4] Mixed workload timing:" << endl;
+    {
+        constexpr int COUNT=200000;
+        constexpr int LOOKUPS=1000000;
+
+        vector<int> keys(COUNT);
+        for(auto &k:keys)
+            k=int(rng());
+
+        auto run=[&](AdaptiveOrderedSet<int> &set)
+        {
+            const auto t0=chrono::steady_clock::now();
+            int64 hits=0;
+
+            for(const int k:keys)                   // 构建阶段
+                set.Add(k);
+
+            for(int i=0;i<LOOKUPS;i++)              // 查找阶段
+                hits+=set.Contains(keys[i%COUNT]^(i&1));
+
+            for(int i=0;i<COUNT/10;i++)             // 更新阶段
+                set.Delete(keys[i]);
+
+            for(int i=0;i<LOOKUPS;i++)              // 再次查找
+                hits+=set.Contains(keys[i%COUNT]);
+
+            return make_pair(chrono::duration<double,milli>(chrono::steady_clock::now()-t0).count(),hits);
+        };
+
+        AdaptiveOrderedSet<int> fixed_tree,adaptive;
+        fixed_tree.SetAutoAdapt(false);
+
+        const auto tree_result=run(fixed_tree);
+        const auto adaptive_result=run(adaptive);
+
+        assert(tree_result.second==adaptive_result.second);
+        assert(fixed_tree==adaptive);
+
+        cout << "  Tree only : " << tree_result.first << " ms" << endl;
+        cout << "  Adaptive  : " << adaptive_result.first << " ms (" << adaptive.GetMigrateCount() << " switches)" << endl;
+        cout << "  ✓ Same results" << endl;
+    }
+
+    cout << "\n✅ TEST 08 PASSED" << endl;
+    return 0;
+}
@@ -0,0 +1,131 @@
+﻿#include<hgl/type/FlatOrderedSet.h>
+#include<iostream>
+#include<cassert>
+#include<set>
+#include<random>
+#include<chrono>
+
+using namespace hgl;
+using namespace std;
+
+template<typename T>
+static bool SameAs(const FlatOrderedSet<T> &fs,const std::set<T> &ref)
+{
+    if(fs.GetCount()!=(int64)ref.size())
+        return false;
+
+    int64 i=0;
+    T v;
+    for(const T &r:ref)
+    {
+        if(!fs.Get(i++,v)||v!=r)
+            return false;
+    }
+
+    return true;
+}
+
+int os_main(int, os_char**)
+{
+    cout << "\n========================================" << endl;
+    cout << "TEST 05: FlatOrderedSet Batch Merge / BuildFrom" << endl;
+    cout << "========================================" << endl;
+
+    cout << "\n[5.1] AddBatch with unsorted input and duplicates:" << endl;
+    {
+        FlatOrderedSet<int> set;
+        set.Add(10);
+        set.Add(30);
+
+        const int values[]={30,-5,20,20,40,10,-5};
+        assert(set.AddBatch(values,7)==3);
+        assert(set.GetCount()==5);
+
+        int v;
+        assert(set.Get(0,v)&&v==-5);
+        assert(set.Get(2,v)&&v==20);
+        assert(set.Get(4,v)&&v==40);
+        cout << "  ✓ Only new unique values inserted: [-5,10,20,30,40]" << endl;
+    }
+
+    cout << "\n[5.2] BuildFrom and DeleteBatch:" << endl;
+    {
+        FlatOrderedSet<uint16> set;
+        set.Add(uint16(999));
+
+        const uint16 values[]={5,3,5,1,3,9};
+        assert(set.BuildFrom(values,6)==4);
+        assert(!set.Contains(999));
+
+        const uint16 del[]={9,9,2,1};
+        assert(set.DeleteBatch(del,4)==2);
+        assert(set.GetCount()==2&&set.Contains(3)&&set.Contains(5));
+        cout << "  ✓ BuildFrom discards old data, DeleteBatch ignores missing and repeated keys" << endl;
+    }
+
+    cout << "\n[5.3] Randomized comparison with std::set:" << endl;
+    {
+        mt19937 rng(5);
+
+        FlatOrderedSet<int32> set;
+        std::set<int32> ref;
+
+        for(int round=0;round<40;round++)
+        {
+            // 交替使用小批量(二分插入路径)和大批量(线性合并+基数排序路径)
+            const int count=(round&1)?(int)(rng()%8)+1:(int)(rng()%4000)+1;
+            vector<int32> batch(count);
+
+            int64 expect_added=0;
+            for(int i=0;i<count;i++)
+            {
+                batch[i]=(int32)(rng()%20000)-10000;
+                expect_added+=ref.insert(batch[i]).second;
+            }
+
+            assert(set.AddBatch(batch.data(),count)==expect_added);
+
+            const int del_count=(int)(rng()%1000);
+            vector<int32> del(del_count);
+
+            int64 expect_deleted=0;
+            for(int i=0;i<del_count;i++)
+            {
+                del[i]=(int32)(rng()%20000)-10000;
+                expect_deleted+=ref.erase(del[i]);
+            }
+
+            assert(set.DeleteBatch(del.data(),del_count)==expect_deleted);
+            assert(SameAs(set,ref));
+        }
+
+        cout << "  ✓ 40 rounds of AddBatch/DeleteBatch match std::set" << endl;
+    }
+
+    cout << "\n[5.4] Bulk load vs one-by-one Add:" << endl;
+    {
+        constexpr int COUNT=200000;
+
+        mt19937 rng(1);
+        vector<uint64> values(COUNT);
+        for(auto &v:values)
+            v=((uint64)rng()<<32)|rng();
+
+        FlatOrderedSet<uint64> single,batch;
+
+        auto t0=chrono::steady_clock::now();
+        for(const auto &v:values)
+            single.Add(v);
+        const double single_ms=chrono::duration<double,milli>(chrono::steady_clock::now()-t0).count();
+
+        t0=chrono::steady_clock::now();
+        batch.BuildFrom(values.data(),COUNT);
+        const double batch_ms=chrono::duration<double,milli>(chrono::steady_clock::now()-t0).count();
+
+        assert(single==batch);
+        cout << "  ✓ Add x" << COUNT << ": " << single_ms << " ms, BuildFrom: " << batch_ms << " ms" << endl;
+    }
+
+    cout << "\n✅ TEST 05 PASSED" << endl;
+    return 0;
+}
@@ -0,0 +1,81 @@
+﻿#include<hgl/type/FlatOrderedSet.h>
+#include<iostream>
+#include<cassert>
+#include<string>
+#include<random>
+
+using namespace hgl;
+using namespace std;
+
+int os_main(int, os_char**)
+{
+    cout << "\n========================================" << endl;
+    cout << "TEST 06: FlatOrderedSet Freeze (B+ tree search index)" << endl;
+    cout << "========================================" << endl;
+
+    cout << "\n[6.1] Frozen lookups match unfrozen lookups:" << endl;
+    {
+        mt19937 rng(6);
+
+        FlatOrderedSet<int64> set;
+        vector<int64> values(50000);
+        for (auto& v : values)
+            v = (int64)(rng() % 1000000) - 500000;
+
+        set.BuildFrom(values.data(), (int64)values.size());
+
+        FlatOrderedSet<int64> frozen = set;
+        frozen.Freeze();
+
+        for (int i = 0; i < 200000; i++)
+        {
+            const int64 v = (int64)(rng() % 1100000) - 550000;
+
+            assert(frozen.Contains(v) == set.Contains(v));
+            assert(frozen.FindIndex(v) == set.FindIndex(v));
+            assert(frozen.lower_bound(v) - frozen.begin() == set.lower_bound(v) - set.begin());
+        }
+
+        assert(frozen.IsFrozen());
+        cout << "  ✓ Contains/FindIndex/lower_bound agree on 200000 random probes" << endl;
+    }
+
+    cout << "\n[6.2] Non-trivial element type:" << endl;
+    {
+        FlatOrderedSet<string> set;
+        for (int i = 0; i < 100; i++)
+            set.Add("key" + to_string(i));
+
+        set.Freeze();
+        assert(set.Contains("key42") && !set.Contains("key100") && !set.Contains(""));
+
+        set.Add("key100");
+        assert(!set.IsFrozen() && set.Contains("key100"));
+        cout << "  ✓ Works with std::string, Add thaws" << endl;
+    }
+
+    cout << "\n[6.3] Modifications thaw:" << endl;
+    {
+        FlatOrderedSet<int> set;
+        for (int i = 0; i < 100; i++)
+            set.Add(i);
+
+        set.Freeze();
+        assert(set.Add(50) == -1 && set.IsFrozen());    // 已存在，不改变数据
+
+        set.Delete(50);
+        assert(!set.IsFrozen() && !set.Contains(50));
+
+        set.Freeze();
+        const int del[] = {1000};
+        set.DeleteBatch(del, 1);                         // 没有删除任何元素
+        assert(set.IsFrozen());
+
+        set.DeleteAt(0);
+        assert(!set.IsFrozen() && !set.Contains(0));
+        cout << "  ✓ Delete/DeleteAt thaw, no-op modifications keep the index" << endl;
+    }
+
+    cout << "\n✅ TEST 06 PASSED" << endl;
+    return 0;
+}
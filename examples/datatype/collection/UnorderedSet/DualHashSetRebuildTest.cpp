@@ -0,0 +1,174 @@
+﻿#include<hgl/type/DualHashSet.h>
+#include<iostream>
+#include<random>
+#include<unordered_set>
+#include<chrono>
+#include<algorithm>
+
+using namespace hgl;
+using namespace std;
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+/**
+ * 可检查哈希表内部ID的DualHashSet
+ */
+class InspectDualHashSet:public DualHashSet<int>
+{
+public:
+
+    /**
+     * 活跃表中每个有效ID恰好出现一次，且没有失效ID
+     */
+    bool IsHashMapExact() const
+    {
+        vector<int> ids;
+
+        for(const auto &pair:hash_map_active)
+            for(int id:pair.second)
+                ids.push_back(id);
+
+        sort(ids.begin(),ids.end());
+
+        if(adjacent_find(ids.begin(),ids.end())!=ids.end())
+            return false;
+
+        if((int)ids.size()!=GetCount())
+            return false;
+
+        for(int id:ids)
+            if(!data_manager.IsActive(id))
+                return false;
+
+        return true;
+    }
+};
+
+/**
+ * 随机增删/增量压缩，与std::unordered_set比对
+ */
+static bool Churn(InspectDualHashSet &set,int key_range,int ops,unsigned seed,int *rebuild_count)
+{
+    unordered_set<int> ref;
+    mt19937 rng(seed);
+    bool ok=true;
+    bool was_rebuilding=false;
+
+    for(int i=0;i<ops;i++)
+    {
+        const int key=(int)(rng()%key_range);
+        const int op=(int)(rng()%16);
+
+        if(op<8)
+        {
+            if(set.Add(key)!=ref.insert(key).second)
+                ok=false;
+        }
+        else if(op<15)
+        {
+            if(set.Delete(key)!=(ref.erase(key)>0))
+                ok=false;
+        }
+        else
+        {
+            set.CompactStep(8);
+        }
+
+        if(set.Contains(key)!=(ref.count(key)>0))
+            ok=false;
+
+        if(was_rebuilding&&!set.IsRebuilding())
+            ++*rebuild_count;
+
+        was_rebuilding=set.IsRebuilding();
+    }
+
+    set.WaitRebuild();
+
+    for(int key=0;key<key_range;key++)
+        if(set.Contains(key)!=(ref.count(key)>0))
+            ok=false;
+
+    return ok&&set.GetCount()==(int)ref.size();
+}
+
+int main()
+{
+    bool ok=true;
+
+    cout<<"=== Test 1: Incremental rebuild keeps IDs unique ==="<<endl;
+    {
+        InspectDualHashSet set;
+        set.SetRebuildThreshold(64);
+        set.SetRebuildBatch(16);
+
+        int rebuild_count=0;
+
+        ok&=Check(Churn(set,5000,200000,1,&rebuild_count),"matches std::unordered_set");
+        ok&=Check(rebuild_count>0,"rebuilds happened");
+        ok&=Check(set.IsHashMapExact(),"no duplicate or stale IDs after rebuilds");
+    }
+
+    cout<<"\n=== Test 2: Background rebuild ==="<<endl;
+    {
+        InspectDualHashSet set;
+        set.SetRebuildThreshold(64);
+        set.SetBackgroundRebuild(true);
+
+        int rebuild_count=0;
+
+        ok&=Check(set.IsBackgroundRebuild(),"background rebuild enabled");
+        ok&=Check(Churn(set,5000,200000,2,&rebuild_count),"matches std::unordered_set");
+        ok&=Check(rebuild_count>0,"background rebuilds published");
+        ok&=Check(set.IsHashMapExact(),"replayed changes leave exact hash map");
+
+        set.SetBackgroundRebuild(false);
+        ok&=Check(!set.IsRebuilding(),"disabling aborts background rebuild");
+    }
+
+    cout<<"\n=== Test 3: Insert latency with a large rebuild in flight ==="<<endl;
+    {
+        constexpr int COUNT=500000;
+
+        DualHashSet<int> set;
+        set.SetRebuildThreshold(COUNT/4);
+        set.SetBackgroundRebuild(true);
+
+        for(int i=0;i<COUNT;i++)
+            set.Add(i);
+
+        for(int i=0;i<COUNT/4;i++)
+            set.Delete(i*4);                        // 最后一次删除触发后台重建
+
+        bool ok_add=true;
+        vector<double> latency(COUNT/4);
+
+        for(int i=0;i<COUNT/4;i++)
+        {
+            const auto t0=chrono::steady_clock::now();
+            ok_add&=set.Add(i*4);
+            latency[i]=chrono::duration<double,micro>(chrono::steady_clock::now()-t0).count();
+        }
+
+        set.WaitRebuild();
+
+        sort(latency.begin(),latency.end());
+
+        // 单核机器上辅助线程会抢占前台，最大值仅供参考
+        cout<<"    Add() latency while rebuilding: p99.9="<<latency[latency.size()*999/1000]<<" us, max="<<latency.back()<<" us"<<endl;
+
+        bool content_ok=set.GetCount()==COUNT;
+        for(int i=0;i<COUNT;i++)
+            if(!set.Contains(i))
+                content_ok=false;
+
+        ok&=Check(ok_add&&content_ok,"content after background rebuild");
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
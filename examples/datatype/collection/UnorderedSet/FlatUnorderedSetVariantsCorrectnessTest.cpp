@@ -385,9 +385,14 @@ static void TestDeleteReinsert(const string &name)
     cout << "  ✓ 5 delete/reinsert cycles" << endl;
 }
 
+static int variant_count = 0;                   ///<已测试的变体数量
+constexpr int TESTS_PER_VARIANT = 18;           ///<每个变体的测试项数
+
 template<typename SetType>
 static void RunAllTests(const string &name)
 {
+    ++variant_count;
+
     cout << "\n" << string(60, '=') << endl;
     cout << "  Testing: " << name << endl;
     cout << string(60, '=') << endl;
@@ -412,6 +417,8 @@ int main()
         RunAllTests<FlatUnorderedSet<int>>("FlatUnorderedSet (Original)");
         RunAllTests<DualHashSet<int>>("DualHashSet");
         RunAllTests<LinearProbeSet<int>>("LinearProbeSet");
+        RunAllTests<LinearProbeSet<int, LinearProbeMode::Group>>("LinearProbeSet (Group)");
+        RunAllTests<LinearProbeSet<int, LinearProbeMode::RobinHood>>("LinearProbeSet (RobinHood)");
         RunAllTests<ShardedSet<int>>("ShardedSet");
 
         cout << "\n" << string(60, '=') << endl;
@@ -478,7 +485,8 @@ int main()
         cout << "  ✓ 边界条件:       5项测试  (空集、单元素、重复、不存在、顺序重复)" << endl;
         cout << "  ✓ 真实场景:       2项测试  (5轮删除-重插入循环、数据一致性)" << endl;
         cout << "  =" << endl;
-        cout << "  总计:            18项测试 × 4个变体 = 72项测试用例 ✅ 全部通过" << endl;
+        cout << "  总计:            " << TESTS_PER_VARIANT << "项测试 × " << variant_count << "个变体 = "
+             << TESTS_PER_VARIANT * variant_count << "项测试用例 ✅ 全部通过" << endl;
         cout << endl;
 
         return 0;
@@ -0,0 +1,139 @@
+﻿#include<hgl/type/LinearProbeSet.h>
+#include<iostream>
+#include<iomanip>
+#include<random>
+#include<unordered_set>
+
+using namespace hgl;
+using namespace std;
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+static void PrintStats(const char *name,const LinearProbeStats &stats)
+{
+    cout<<"    "<<setw(10)<<left<<name
+        <<" count="<<stats.count
+        <<" capacity="<<stats.capacity
+        <<" tombstones="<<stats.tombstones
+        <<" mean="<<fixed<<setprecision(3)<<stats.mean
+        <<" max="<<stats.max<<endl;
+}
+
+static bool HistogramMatches(const LinearProbeStats &stats)
+{
+    int total=0;
+
+    for(int n:stats.histogram)
+        total+=n;
+
+    return total==stats.count&&(stats.histogram.empty()||(int)stats.histogram.size()==stats.max+1);
+}
+
+/**
+ * 随机增删（删除多于插入的阶段与插入多于删除的阶段交替），并与std::unordered_set比对结果
+ */
+template<typename S> static bool Churn(S &set,int key_range,int ops,unsigned seed)
+{
+    unordered_set<int> ref;
+    mt19937 rng(seed);
+    bool ok=true;
+
+    for(int i=0;i<ops;i++)
+    {
+        const int key=(int)(rng()%key_range);
+        const bool delete_phase=(i/(ops/8))&1;
+
+        if((rng()%4==0)!=delete_phase)
+        {
+            if(set.Add(key)!=ref.insert(key).second)
+                ok=false;
+        }
+        else
+        {
+            if(set.Delete(key)!=(ref.erase(key)>0))
+                ok=false;
+        }
+    }
+
+    for(int key=0;key<key_range;key++)
+        if(set.Contains(key)!=(ref.count(key)>0))
+            ok=false;
+
+    return ok&&set.GetCount()==(int)ref.size();
+}
+
+int main()
+{
+    bool ok=true;
+
+    constexpr int KEY_RANGE=50000;
+    constexpr int OPS=400000;
+
+    cout<<"=== Test 1: Robin Hood insertion/backward-shift deletion ==="<<endl;
+    {
+        LinearProbeSet<int,LinearProbeMode::RobinHood> set;
+
+        ok&=Check(Churn(set,KEY_RANGE,OPS,1),"matches std::unordered_set under delete-heavy churn");
+
+        const LinearProbeStats stats=set.GetProbeStats();
+
+        ok&=Check(stats.tombstones==0,"no tombstones");
+        ok&=Check(stats.count==set.GetCount()&&HistogramMatches(stats),"histogram covers every element");
+    }
+
+    cout<<"\n=== Test 2: Probe length compared with scalar mode ==="<<endl;
+    {
+        LinearProbeSet<int> scalar_set;
+        LinearProbeSet<int,LinearProbeMode::RobinHood> robin_hood_set;
+        LinearProbeSet<int,LinearProbeMode::Group> group_set;
+
+        scalar_set.SetMaxLoadFactor(0.9f);
+        robin_hood_set.SetMaxLoadFactor(0.9f);
+        group_set.SetMaxLoadFactor(0.9f);
+
+        ok&=Check(Churn(scalar_set,KEY_RANGE,OPS,2),"scalar churn");
+        ok&=Check(Churn(robin_hood_set,KEY_RANGE,OPS,2),"robin hood churn");
+        ok&=Check(Churn(group_set,KEY_RANGE,OPS,2),"group churn");
+
+        const LinearProbeStats scalar_stats=scalar_set.GetProbeStats();
+        const LinearProbeStats robin_hood_stats=robin_hood_set.GetProbeStats();
+        const LinearProbeStats group_stats=group_set.GetProbeStats();
+
+        PrintStats("Scalar",scalar_stats);
+        PrintStats("RobinHood",robin_hood_stats);
+        PrintStats("Group",group_stats);
+
+        ok&=Check(HistogramMatches(scalar_stats)&&HistogramMatches(group_stats),"histograms of other modes");
+        ok&=Check(robin_hood_stats.max<=scalar_stats.max,"robin hood max probe length not above scalar");
+        ok&=Check(robin_hood_stats.GetLoadFactor()<=robin_hood_set.GetMaxLoadFactor(),"load factor within limit");
+    }
+
+    cout<<"\n=== Test 3: Compaction keeps the table valid ==="<<endl;
+    {
+        LinearProbeSet<int,LinearProbeMode::RobinHood> set;
+
+        for(int i=0;i<10000;i++)
+            set.Add(i);
+
+        for(int i=0;i<10000;i+=2)
+            set.Delete(i);
+
+        while(!set.IsCompact())
+            set.CompactStep(100);
+
+        bool content_ok=set.GetCount()==5000;
+
+        for(int i=0;i<10000;i++)
+            if(set.Contains(i)!=(i&1))
+                content_ok=false;
+
+        ok&=Check(content_ok,"content after incremental compaction");
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
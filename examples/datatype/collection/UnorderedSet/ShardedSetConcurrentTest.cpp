@@ -0,0 +1,120 @@
+﻿#include<hgl/type/ShardedSet.h>
+#include<iostream>
+#include<vector>
+#include<thread>
+#include<atomic>
+#include<memory>
+
+using namespace hgl;
+using namespace std;
+
+static bool Check(bool result,const char *name)
+{
+    cout<<(result?"  ✓ ":"  ✗ ")<<name<<endl;
+    return result;
+}
+
+int main()
+{
+    bool ok=true;
+
+    constexpr int THREAD_COUNT=8;
+    constexpr int PER_THREAD=20000;
+
+    cout<<"=== Test 1: Concurrent Add/Contains/Delete ==="<<endl;
+    {
+        ShardedSet<int,32,true> set;
+
+        atomic<int> added{0};
+        atomic<int> missing{0};
+
+        vector<thread> threads;
+
+        for(int t=0;t<THREAD_COUNT;t++)
+        {
+            threads.emplace_back([&,t]()
+            {
+                // 每个线程写入自己的区间，并与下一个线程的区间重叠一半
+                const int first=t*PER_THREAD/2;
+
+                for(int i=first;i<first+PER_THREAD;i++)
+                    if(set.Add(i))
+                        ++added;
+
+                for(int i=first;i<first+PER_THREAD;i++)
+                    if(!set.Contains(i))
+                        ++missing;
+            });
+        }
+
+        for(thread &t:threads)
+            t.join();
+
+        const int expect=(THREAD_COUNT+1)*PER_THREAD/2;
+
+        ok&=Check(added==expect&&set.GetCount()==expect,"each value added exactly once");
+        ok&=Check(missing==0,"values visible to their writer");
+
+        threads.clear();
+
+        atomic<int> deleted{0};
+
+        for(int t=0;t<THREAD_COUNT;t++)
+        {
+            threads.emplace_back([&]()
+            {
+                for(int i=0;i<expect;i+=2)
+                    if(set.Delete(i))
+                        ++deleted;
+            });
+        }
+
+        for(thread &t:threads)
+            t.join();
+
+        ok&=Check(deleted==(expect+1)/2&&set.GetCount()==expect/2,"each value deleted exactly once");
+
+        bool content_ok=true;
+        for(int i=0;i<expect;i++)
+            if(set.Contains(i)!=(i&1))
+                content_ok=false;
+
+        ok&=Check(content_ok,"remaining content correct");
+    }
+
+    cout<<"\n=== Test 2: AddBatch/ContainsBatch ==="<<endl;
+    {
+        constexpr int COUNT=200000;
+
+        vector<int> values(COUNT);
+        for(int i=0;i<COUNT;i++)
+            values[i]=(i*7919)%(COUNT/2);           // 每个值出现两次
+
+        ShardedSet<int,32,true> parallel_set;
+        ShardedSet<int> serial_set;
+
+        ok&=Check(parallel_set.AddBatch(values.data(),COUNT,THREAD_COUNT)==COUNT/2,"parallel AddBatch skips duplicates");
+        ok&=Check(serial_set.AddBatch(values.data(),COUNT,1)==COUNT/2,"serial AddBatch");
+        ok&=Check(parallel_set.AddBatch(values.data(),COUNT)==0,"second AddBatch adds nothing");
+
+        vector<int> query(COUNT);
+        for(int i=0;i<COUNT;i++)
+            query[i]=i;
+
+        unique_ptr<bool[]> results(new bool[COUNT]);
+
+        ok&=Check(parallel_set.ContainsBatch(query.data(),results.get(),COUNT,THREAD_COUNT)==COUNT/2,"ContainsBatch found count");
+
+        bool results_ok=true;
+        for(int i=0;i<COUNT;i++)
+            if(results[i]!=(i<COUNT/2)||serial_set.Contains(i)!=results[i])
+                results_ok=false;
+
+        ok&=Check(results_ok,"ContainsBatch results match Contains");
+
+        ok&=Check(serial_set.ContainsBatch(query.data(),nullptr,COUNT,THREAD_COUNT)==COUNT/2,"parallel read-only batch on non-thread-safe set");
+    }
+
+    cout<<"\n"<<(ok?"All tests passed!":"Some tests FAILED!")<<endl;
+    return ok?0:1;
+}
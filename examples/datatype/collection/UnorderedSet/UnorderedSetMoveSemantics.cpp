@@ -3,6 +3,7 @@
 #include<iostream>
 #include<cassert>
 #include<string>
+#include<chrono>
 
 using namespace hgl;
 using namespace std;
@@ -133,4 +133,40 @@ namespace hgl
      * @return 是否迁移成功
      */
     bool MigrateMemory(void* ptr, size_t size, int numa_node);
+
+    /**
+     * 获取系统内存页面大小(字节)
+     */
+    size_t GetSystemPageSize();
+
+    /**
+     * 获取大页面大小(字节)，不支持大页面返回0
+     */
+    size_t GetHugePageSize();
+
+    /**
+     * 直接向系统映射一段内存页面
+     * @param size 要映射的大小(字节)，返回实际映射的大小(已按页面大小取整)
+     * @param huge_page 是否尝试使用大页面(先尝试显式大页面，失败则使用普通页面并建议系统使用透明大页面)
+     * @param huge_tlb 返回是否使用了显式大页面，之后的PageRealloc/PageFree需要传入同样的值
+     * @return 内存指针，失败返回nullptr
+     */
+    void* PageAlloc(size_t &size, bool huge_page, bool &huge_tlb);
+
+    /**
+     * 扩展PageAlloc映射的内存，尽量原地扩展，必要时由系统移动映射(不复制数据)
+     * @param new_size 新的大小(字节)，返回实际映射的大小
+     * @return 新的内存指针，系统不支持重新映射或失败时返回nullptr(原映射不变)
+     */
+    void* PageRealloc(void* ptr, size_t old_size, size_t &new_size, bool huge_tlb);
+
+    /**
+     * 释放PageAlloc/PageRealloc映射的内存
+     */
+    void PageFree(void* ptr, size_t size);
+
+    /**
+     * 建议系统对这段内存使用透明大页面(不支持时什么也不做)
+     */
+    void AdviseHugePage(void* ptr, size_t size);
 }//namespace hgl
@@ -2,12 +2,19 @@
 
 #include<hgl/CoreType.h>
 #include<vector>
+#include<deque>
+#include<memory>
+#include<cstddef>
+#include<cstdint>
 
 namespace hgl
 {
     /**
      * 累计内存管理<br>
-     * 用于不断分配固定容量的内存块，但不动态调整，最后统一释放的情况。
+     * 用于不断分配固定容量的内存块，但不动态调整，最后统一释放的情况。<br>
+     * 内存按块(chunk)分配，块容量按倍数增长，已分配的内存永远不会被移动，Access()返回的地址在Clear/Rollback前一直有效。
+     * 支持按任意2的幂对齐，以及标记/回滚(GetMark/Rollback、Checkpoint)，适合每帧构建的临时数据。<br>
+     * 分配到的内存不会被清零。
      */
     class AccumMemoryManager
     {
@@ -15,47 +22,261 @@ namespace hgl
 
         struct Block
         {
-            int64 offset;
+            int64 chunk;                ///<所在内存块序号
+            int64 offset;               ///<在内存块中的偏移
             int64 size;
         };
 
+        /**
+         * 分配位置标记，用于回滚
+         */
+        struct Mark
+        {
+            int64 chunk;
+            int64 chunk_used;
+            int64 block_count;
+            int64 total_bytes;
+            uint64 generation;          ///<取标记时的Clear/Free次数，不同则标记已失效
+        };
+
+        static constexpr int64 DEFAULT_ALIGN=alignof(std::max_align_t);
+
     private:
 
-        std::vector<Block>      block_list;                     ///<数据块列表
-        std::vector<char>       data_array;                     ///<数据
+        struct Chunk
+        {
+            std::unique_ptr<char[]> data;
+            int64 size;
+            int64 used;
+        };
+
+        std::deque<Block>       block_list;                     ///<数据块列表(deque保证Block地址稳定)
+        std::vector<Chunk>      chunk_list;                     ///<内存块列表
+        int64                   current_chunk=0;                ///<当前分配所在的内存块
+
+        int64                   first_chunk_size;               ///<第一个内存块的容量
+        int64                   max_chunk_size;                 ///<内存块容量增长上限
+        int64                   total_bytes=0;                  ///<已分配的字节数(不含对齐填充)
+        uint64                  generation=0;                   ///<Clear/Free次数，用于识别失效的标记
+
+    private:
+
+        /**
+         * 在指定内存块中按对齐尝试分配，成功返回偏移，失败返回-1
+         */
+        static int64 TryAlloc(Chunk &c,const int64 size,const int64 align)
+        {
+            const uintptr_t base=(uintptr_t)c.data.get();
+            const uintptr_t addr=(base+c.used+(align-1))&~uintptr_t(align-1);
+            const int64 offset=int64(addr-base);
+
+            if(offset+size>c.size)
+                return(-1);
+
+            c.used=offset+size;
+            return offset;
+        }
+
+        /**
+         * 分配内存，返回所在内存块与偏移
+         */
+        bool Alloc(const int64 size,int64 align,int64 &chunk,int64 &offset)
+        {
+            if(size<=0)return(false);
+            if(align<=0)align=1;
+            if(align&(align-1))return(false);            //必须为2的幂
+
+            //先尝试当前块及之后已有的块(Clear/Rollback后复用)
+            for(int64 i=current_chunk;i<(int64)chunk_list.size();i++)
+            {
+                offset=TryAlloc(chunk_list[i],size,align);
+
+                if(offset>=0)
+                {
+                    current_chunk=i;
+                    chunk=i;
+                    total_bytes+=size;
+                    return(true);
+                }
+            }
+
+            //新建内存块：容量按倍数增长，但至少能放下本次分配
+            int64 new_size=chunk_list.empty()?first_chunk_size:chunk_list.back().size*2;
+
+            if(new_size>max_chunk_size)
+                new_size=max_chunk_size;
+
+            if(new_size<size+align-1)
+                new_size=size+align-1;
+
+            chunk_list.push_back({std::unique_ptr<char[]>(new char[new_size]),new_size,0});
+
+            current_chunk=(int64)chunk_list.size()-1;
+            chunk=current_chunk;
+            offset=TryAlloc(chunk_list.back(),size,align);
+            total_bytes+=size;
+            return(true);
+        }
 
     public:
 
-        AccumMemoryManager()=default;
+        /**
+         * @param first_size 第一个内存块的容量
+         * @param max_size 内存块容量增长上限(单次分配超过此值时按分配大小建块)
+         */
+        AccumMemoryManager(const int64 first_size=64*1024,const int64 max_size=16*1024*1024)
+        {
+            first_chunk_size=first_size>0?first_size:64*1024;
+            max_chunk_size=max_size>first_chunk_size?max_size:first_chunk_size;
+        }
+
         ~AccumMemoryManager()=default;
 
-        const int64 GetTotalBytes()const{return data_array.size();}    ///<取得总共申请的内存总字节数
-        const int64 GetBlockCount()const{return block_list.size();}         ///<取得内存数据块数量
+        AccumMemoryManager(const AccumMemoryManager &)=delete;
+        AccumMemoryManager &operator=(const AccumMemoryManager &)=delete;
 
-        Block *Acquire(const int64 size)                                        ///<申请一块内存
+        const int64 GetTotalBytes()const{return total_bytes;}                   ///<取得总共申请的内存总字节数
+        const int64 GetBlockCount()const{return block_list.size();}             ///<取得内存数据块数量
+        const int64 GetChunkCount()const{return chunk_list.size();}             ///<取得已分配的内存块(chunk)数量
+
+        const int64 GetReservedBytes()const                                     ///<取得所有内存块的总容量
         {
-            if(size<=0)return(nullptr);
+            int64 total=0;
+
+            for(const Chunk &c:chunk_list)
+                total+=c.size;
 
-            block_list.emplace_back();
-            Block *b = &block_list.back();
+            return total;
+        }
 
-            b->offset   = data_array.size();
-            b->size     = size;
+        /**
+         * 申请一块内存
+         * @param size 字节数
+         * @param align 对齐字节数(2的幂)
+         * @return 数据块描述，地址在Clear/Rollback前保持不变
+         */
+        Block *Acquire(const int64 size,const int64 align=DEFAULT_ALIGN)
+        {
+            int64 chunk,offset;
 
-            data_array.resize(data_array.size() + size);
+            if(!Alloc(size,align,chunk,offset))
+                return(nullptr);
 
-            return b;
+            block_list.push_back({chunk,offset,size});
+            return &block_list.back();
         }
 
         void *Access(const Block *b)                                            ///<访问一块内存
         {
-            return b ? (data_array.data() + b->offset) : nullptr;
+            return b ? (chunk_list[b->chunk].data.get() + b->offset) : nullptr;
         }
 
+        /**
+         * 直接分配一段内存，不记录Block
+         * @return 内存地址，在Clear/Rollback前保持不变
+         */
+        void *Allocate(const int64 size,const int64 align=DEFAULT_ALIGN)
+        {
+            int64 chunk,offset;
+
+            if(!Alloc(size,align,chunk,offset))
+                return(nullptr);
+
+            return chunk_list[chunk].data.get()+offset;
+        }
+
+        template<typename T>
+        T *Allocate(const int64 count=1)                                        ///<按类型分配内存(不调用构造函数)
+        {
+            return (T *)Allocate(count*sizeof(T),alignof(T));
+        }
+
+        /**
+         * 取得当前分配位置标记
+         */
+        Mark GetMark()const
+        {
+            return {current_chunk,
+                    chunk_list.empty()?0:chunk_list[current_chunk].used,
+                    (int64)block_list.size(),
+                    total_bytes,
+                    generation};
+        }
+
+        /**
+         * 回滚到标记位置，之后分配的内存全部作废(内存块保留供复用)
+         * @return 标记已失效(取于Clear/Free之前)或不早于当前位置时返回false
+         */
+        bool Rollback(const Mark &m)
+        {
+            if(m.generation!=generation)
+                return(false);
+
+            if(chunk_list.empty())
+                return(m.block_count==0);
+
+            if(m.chunk<0||m.chunk>current_chunk||m.chunk>=(int64)chunk_list.size())
+                return(false);
+
+            if(m.chunk==current_chunk&&m.chunk_used>chunk_list[m.chunk].used)
+                return(false);
+
+            if(m.block_count>(int64)block_list.size()||m.total_bytes>total_bytes)
+                return(false);
+
+            for(int64 i=m.chunk+1;i<(int64)chunk_list.size();i++)
+                chunk_list[i].used=0;
+
+            chunk_list[m.chunk].used=m.chunk_used;
+            current_chunk=m.chunk;
+
+            block_list.resize(m.block_count);
+            total_bytes=m.total_bytes;
+            return(true);
+        }
+
+        /**
+         * 作用域检查点，析构时自动回滚
+         */
+        class Checkpoint
+        {
+            AccumMemoryManager *amm;
+            Mark mark;
+
+        public:
+
+            Checkpoint(AccumMemoryManager &m):amm(&m),mark(m.GetMark()){}
+            ~Checkpoint(){amm->Rollback(mark);}
+
+            Checkpoint(const Checkpoint &)=delete;
+            Checkpoint &operator=(const Checkpoint &)=delete;
+        };//class Checkpoint
+
+        /**
+         * 清除所有分配，保留内存块供复用
+         */
         void Clear()
         {
             block_list.clear();
-            data_array.clear();
+
+            for(Chunk &c:chunk_list)
+                c.used=0;
+
+            current_chunk=0;
+            total_bytes=0;
+            ++generation;
+        }
+
+        /**
+         * 清除所有分配并释放内存块
+         */
+        void Free()
+        {
+            block_list.clear();
+            chunk_list.clear();
+            current_chunk=0;
+            total_bytes=0;
+            ++generation;
         }
     };//class AccumMemoryManager
 }//namespace
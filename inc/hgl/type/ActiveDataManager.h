@@ -9,6 +9,12 @@
 
 namespace hgl
 {
+    /**
+    * @brief CN:多列(SoA)版本，定义见ActiveDataManagerMultiColumn.h。\nEN:Multi-column (SoA) version, defined in ActiveDataManagerMultiColumn.h.
+    */
+    template<typename T,typename... Ts>
+    class ActiveDataManager;
+
     /**
     * @brief CN:活动数据管理模板类。\nEN:Active data manager template class.
     * @tparam T CN:数据类型。EN:Data type.
@@ -16,7 +22,7 @@ namespace hgl
     * CN:通过ActiveIDManager管理活跃的数据ID，在要使用时通过ID来获取或写入数据。\nEN:Manages active data IDs via ActiveIDManager, access or write data by ID when needed.
     */
     template<typename T>
-    class ActiveDataManager
+    class ActiveDataManager<T>
     {
     protected:
 
@@ -30,6 +36,116 @@ namespace hgl
         */
         std::vector<T> data_array;
 
+    public:
+
+        /**
+        * @brief CN:自上次CollectDirty以来的变化。\nEN:Changes since the last CollectDirty.
+        *
+        * CN:接收方应按 released_ids -> created_ids -> changed_ids 的顺序应用。\nEN:Receivers should apply released_ids, then created_ids, then changed_ids.
+        * CN:同一ID可能同时出现在released和created中（旧数据释放后ID被复用）。\nEN:An ID may appear in both released and created (released, then reused).
+        */
+        struct Delta
+        {
+            std::vector<int> changed_ids;           ///<CN:数据有变化的活跃ID(含新建的ID)，升序 EN:Active IDs whose data changed (including created ones), ascending
+            std::vector<T>   changed_values;        ///<CN:与changed_ids一一对应的数据 EN:Packed values matching changed_ids
+            std::vector<int> created_ids;           ///<CN:新激活的ID，升序 EN:Newly activated IDs, ascending
+            std::vector<int> released_ids;          ///<CN:已释放的ID，升序 EN:Released IDs, ascending
+
+            void Clear()
+            {
+                changed_ids.clear();
+                changed_values.clear();
+                created_ids.clear();
+                released_ids.clear();
+            }
+
+            bool IsEmpty() const
+            {
+                return changed_ids.empty() && created_ids.empty() && released_ids.empty();
+            }
+        };
+
+    protected:
+
+        bool dirty_tracking = false;
+
+        std::vector<uint64> dirty_bits;             ///<CN:数据被写过的ID EN:IDs whose data was written
+        std::vector<uint64> created_bits;           ///<CN:自上次收集以来被激活的ID EN:IDs activated since the last collection
+        std::vector<uint64> released_bits;          ///<CN:自上次收集以来被释放的ID(收集前已知的旧数据) EN:IDs released since the last collection
+
+        static void SetTrackBit(std::vector<uint64> &bits, const int id)
+        {
+            const size_t w = size_t(id) >> 6;
+
+            if (w >= bits.size())
+                bits.resize(w + 1, 0);
+
+            bits[w] |= uint64(1) << (id & 63);
+        }
+
+        static void ClearTrackBit(std::vector<uint64> &bits, const int id)
+        {
+            const size_t w = size_t(id) >> 6;
+
+            if (w < bits.size())
+                bits[w] &= ~(uint64(1) << (id & 63));
+        }
+
+        static bool TestTrackBit(const std::vector<uint64> &bits, const int id)
+        {
+            const size_t w = size_t(id) >> 6;
+
+            return w < bits.size() && ((bits[w] >> (id & 63)) & 1);
+        }
+
+        template<typename F>
+        static void ForEachTrackBit(const std::vector<uint64> &bits, F &&func)
+        {
+            for (size_t w = 0; w < bits.size(); w++)
+            {
+                uint64 word = bits[w];
+
+                while (word)
+                {
+                    func(int(w << 6) + std::countr_zero(word));
+
+                    word &= word - 1;
+                }
+            }
+        }
+
+        void MarkDirty(const int id)
+        {
+            if (dirty_tracking)
+                SetTrackBit(dirty_bits, id);
+        }
+
+        void TrackCreate(const int *id, const int count)
+        {
+            if (!dirty_tracking)
+                return;
+
+            for (int i = 0; i < count; i++)
+            {
+                SetTrackBit(created_bits, id[i]);
+                SetTrackBit(dirty_bits, id[i]);
+            }
+        }
+
+        void TrackRelease(const int id)
+        {
+            if (!dirty_tracking)
+                return;
+
+            ClearTrackBit(dirty_bits, id);
+
+            // 本次收集周期内新建又释放的ID，对方从未见过，直接抵消
+            if (TestTrackBit(created_bits, id))
+                ClearTrackBit(created_bits, id);
+            else
+                SetTrackBit(released_bits, id);
+        }
+
     public:
 
         ActiveDataManager()=default;
@@ -78,12 +194,66 @@ namespace hgl
 
         /**
         * @brief CN:获取活跃ID列表快照。\nEN:Get snapshot of active ID list
+        * @note CN:每次调用都会分配并复制，热路径请使用 GetActiveIDs() 或 ForEachActive()。\nEN:Allocates and copies on every call, prefer GetActiveIDs() or ForEachActive() in hot paths.
         */
         std::vector<int> GetActiveView() const
         {
             return aim.GetActiveView();
         }
 
+        /**
+        * @brief CN:获取活跃ID范围视图（不分配内存，按ID升序）。\nEN:Get non-owning view of active IDs (no allocation, ascending order).
+        */
+        ActiveIDRange GetActiveIDs() const
+        {
+            return aim.GetActiveIDs();
+        }
+
+        /**
+        * @brief CN:查找大于等于指定ID的第一个活跃ID。\nEN:Find first active ID not less than the given ID.
+        * @return CN:活跃ID，没有则返回-1。\nEN:Active ID, or -1 if none.
+        */
+        int FindNextActive(const int id) const
+        {
+            return aim.FindNextActive(id);
+        }
+
+        /**
+        * @brief CN:取得按升序排列的第index个活跃ID。\nEN:Get the index-th active ID in ascending order.
+        * @return CN:活跃ID，越界返回-1。\nEN:Active ID, or -1 if out of range.
+        */
+        int GetActiveByIndex(const int index) const
+        {
+            return aim.GetActiveByIndex(index);
+        }
+
+        /**
+        * @brief CN:按ID升序遍历所有活跃数据（不分配内存）。\nEN:Visit all active data in ascending ID order (no allocation).
+        * @param func CN:回调 func(int id, T &data)。\nEN:Callback func(int id, T &data).
+        */
+        template<typename F>
+        void ForEachActive(F &&func)
+        {
+            T *data=data_array.data();
+
+            if(dirty_tracking)      // 可写遍历，视为全部被修改
+                aim.ForEachActive([this,&func,data](int id){SetTrackBit(dirty_bits,id);func(id,data[id]);});
+            else
+                aim.ForEachActive([&func,data](int id){func(id,data[id]);});
+        }
+
+        /**
+        * @brief CN:按ID升序遍历所有活跃数据（只读）。\nEN:Visit all active data in ascending ID order (read-only).
+        * @param func CN:回调 func(int id, const T &data)。\nEN:Callback func(int id, const T &data).
+        */
+        template<typename F>
+        void ForEachActive(F &&func) const
+        {
+            const T *data=data_array.data();
+
+            aim.ForEachActive([&func,data](int id){func(id,data[id]);});
+        }
+
         /**
         * @brief CN:获取闲置ID队列的快照。\nEN:Get idle ID queue snapshot (copy, not reference).
         *
@@ -105,6 +275,7 @@ namespace hgl
         {
             if(id < 0 || id >= (int)data_array.size()) return false;
             data_array[id] = d;
+            MarkDirty(id);
             return true;
         }
 
@@ -120,6 +291,7 @@ namespace hgl
                 if (*idp >= 0 && *idp < (int)data_array.size())
                 {
                     data_array[*idp] = **da;
+                    MarkDirty(*idp);
                     ++result;
                 }
 
@@ -142,6 +314,7 @@ namespace hgl
                 if (*idp >= 0 && *idp < (int)data_array.size())
                 {
                     data_array[*idp] = *da;
+                    MarkDirty(*idp);
                     ++result;
                 }
 
@@ -153,9 +326,19 @@ namespace hgl
         }
 
         /**
-        * @brief CN:获取指定ID的数据指针。\nEN:Get data pointer at specified ID.
+        * @brief CN:获取指定ID的数据指针（开启脏标记时视为写入）。\nEN:Get data pointer at specified ID (counts as a write when dirty tracking is on).
         */
         T *At(const int id)
+        {
+            if(id < 0 || id >= (int)data_array.size()) return nullptr;
+            MarkDirty(id);
+            return &data_array[id];
+        }
+
+        /**
+        * @brief CN:获取指定ID的只读数据指针。\nEN:Get read-only data pointer at specified ID.
+        */
+        const T *At(const int id) const
         {
             if(id < 0 || id >= (int)data_array.size()) return nullptr;
             return &data_array[id];
@@ -226,9 +409,10 @@ namespace hgl
         */
         void CreateActive(int *id, const int count = 1)
         {
-            aim.CreateActive(id, count);
+            const int created = aim.CreateActive(id, count);
 
-            data_array.resize(data_array.size() + count);
+            data_array.resize(data_array.size() + created);
+            TrackCreate(id, created);
         }
 
         /**
@@ -254,7 +438,11 @@ namespace hgl
         */
         bool Get(int *id, const int count = 1)
         {
-            return aim.Get(id, count);
+            if (!aim.Get(id, count))
+                return false;
+
+            TrackCreate(id, count);
+            return true;
         }
 
         /**
@@ -274,6 +462,7 @@ namespace hgl
                 if (!aim.Get(id, get_count))
                     return false;
 
+                TrackCreate(id, get_count);
                 id += get_count;
             }
 
@@ -281,8 +470,11 @@ namespace hgl
             int create_count = count - get_count;
             if (create_count > 0)
             {
-                aim.CreateActive(id, create_count);
+                if (aim.CreateActive(id, create_count) != create_count)
+                    return false;
+
                 data_array.resize(data_array.size() + create_count);
+                TrackCreate(id, create_count);
             }
 
             return true;
@@ -293,7 +485,24 @@ namespace hgl
         */
         int Release(const int *id, const int count = 1)
         {
-            return aim.Release(id, count);
+            if (!dirty_tracking)
+                return aim.Release(id, count);
+
+            if (!id || count <= 0)
+                return 0;
+
+            int result = 0;
+
+            for (int i = 0; i < count; i++)
+            {
+                if (aim.Release(id + i, 1) == 1)
+                {
+                    TrackRelease(id[i]);
+                    ++result;
+                }
+            }
+
+            return result;
         }
 
         /**
@@ -301,6 +510,9 @@ namespace hgl
         */
         int ReleaseAllActive()
         {
+            if (dirty_tracking)
+                aim.ForEachActive([this](int id){TrackRelease(id);});
+
             return aim.ReleaseAllActive();
         }
 
@@ -309,7 +521,7 @@ namespace hgl
         */
         void Clear()
         {
-            aim.ReleaseAllActive();
+            ReleaseAllActive();
             // 保留 data_array 的长度以便后续重用，不重置 count
         }
 
@@ -321,6 +533,75 @@ namespace hgl
             aim.Free();
             data_array.clear();
             data_array.shrink_to_fit();
+
+            dirty_bits.clear();
+            created_bits.clear();
+            released_bits.clear();
+        }
+
+        /**
+        * @brief CN:是否已压缩（活跃数据稠密排列在[0,GetActiveCount())）。\nEN:Whether active data is densely packed in [0,GetActiveCount()).
+        */
+        bool IsCompact() const
+        {
+            return aim.IsCompact();
+        }
+
+        /**
+        * @brief CN:增量压缩：最多搬移max_move个数据，把高位的活跃数据搬到低位空洞。\nEN:Incremental compaction: move at most max_move active items from the tail into low holes.
+        * @param max_move CN:本次最多搬移的数量。\nEN:Maximum number of moves in this step.
+        * @param moved CN:追加本次的(旧ID,新ID)搬移记录，可为nullptr。\nEN:Appends (old,new) pairs of this step, may be nullptr.
+        * @return CN:本次搬移的数量。\nEN:Number of items moved in this step.
+        *
+        * CN:压缩完成时(IsCompact()为true)所有闲置ID被丢弃，data_array截断到活跃数量(保留容量)。\nEN:On completion all idle IDs are dropped and data_array is truncated to the active count (capacity kept).
+        * CN:调用者持有的旧ID会失效，需按moved记录更新。\nEN:IDs held by callers become stale and must be updated from the moved records.
+        */
+        int CompactStep(const int max_move, std::vector<ActiveIDRemap> *moved = nullptr)
+        {
+            std::vector<ActiveIDRemap> local_moved;
+            std::vector<ActiveIDRemap> &list = moved ? *moved : local_moved;
+
+            const size_t first = list.size();
+            const int result = aim.Compact(list, max_move);
+
+            for (size_t i = first; i < list.size(); i++)
+            {
+                data_array[list[i].new_id] = std::move(data_array[list[i].old_id]);
+
+                // 对接收方而言，搬移等同于释放旧ID并以原数据新建新ID
+                TrackRelease(list[i].old_id);
+                TrackCreate(&list[i].new_id, 1);
+            }
+
+            if (aim.IsCompact() && (int)data_array.size() > aim.GetHistoryMaxId())
+                data_array.erase(data_array.begin() + aim.GetHistoryMaxId(), data_array.end());
+
+            return result;
+        }
+
+        /**
+        * @brief CN:完整压缩。\nEN:Full compaction.
+        * @param remap_table CN:输出旧ID到新ID的映射表(大小为压缩前的GetHistoryMaxId()，非活跃ID为-1)，可为nullptr。\nEN:Outputs old->new ID table (size is GetHistoryMaxId() before compaction, -1 for inactive IDs), may be nullptr.
+        * @return CN:搬移的数量。\nEN:Number of items moved.
+        */
+        int Compact(std::vector<int> *remap_table = nullptr)
+        {
+            std::vector<ActiveIDRemap> moved;
+
+            if (remap_table)
+            {
+                remap_table->assign(aim.GetHistoryMaxId(), -1);
+
+                aim.ForEachActive([remap_table](int id){(*remap_table)[id]=id;});
+            }
+
+            const int result = CompactStep(INT_MAX, &moved);
+
+            if (remap_table)
+                for (const ActiveIDRemap &m : moved)
+                    (*remap_table)[m.old_id] = m.new_id;
+
+            return result;
         }
 
         /**
@@ -335,6 +616,8 @@ namespace hgl
 
             if (id < 0 || id >= (int)data_array.size())
                 return nullptr;
+
+            TrackCreate(&id, 1);
             return &data_array[id];
         }
 
@@ -345,5 +628,158 @@ namespace hgl
         {
             return aim.IsActive(id);
         }
+
+    public: // 代数句柄
+
+        /**
+        * @brief CN:取得活跃ID的代数句柄（ID非活跃返回空句柄）。\nEN:Get generational handle of an active ID (null handle if not active).
+        * @tparam H CN:句柄类型(ActiveHandle32/ActiveHandle64)。\nEN:Handle type (ActiveHandle32/ActiveHandle64).
+        */
+        template<typename H = ActiveHandle>
+        H GetHandle(const int id) const
+        {
+            return aim.GetHandle<H>(id);
+        }
+
+        /**
+        * @brief CN:句柄是否仍然有效（未被释放或复用）。\nEN:Whether the handle is still valid (not released or reused).
+        */
+        template<typename V, int B>
+        bool IsValid(const GenerationalHandle<V, B> &h) const
+        {
+            return aim.IsValid(h);
+        }
+
+        /**
+        * @brief CN:通过句柄访问数据，句柄失效返回nullptr（一次代数比较加一次读取，无哈希查找）。\nEN:Access data by handle, nullptr if stale (one generation compare plus one load, no hash lookup).
+        */
+        template<typename V, int B>
+        T *At(const GenerationalHandle<V, B> &h)
+        {
+            if (!aim.IsValid(h))
+                return nullptr;
+
+            MarkDirty(h.GetIndex());
+            return data_array.data() + h.GetIndex();
+        }
+
+        template<typename V, int B>
+        const T *At(const GenerationalHandle<V, B> &h) const
+        {
+            return aim.IsValid(h) ? data_array.data() + h.GetIndex() : nullptr;
+        }
+
+        /**
+        * @brief CN:获取或创建活跃数据，并输出其句柄。\nEN:Get or create active items and output their handles.
+        * @return CN:是否全部成功。\nEN:Whether all items were created.
+        */
+        template<typename V, int B>
+        bool GetOrCreate(GenerationalHandle<V, B> *handles, const int count)
+        {
+            using H = GenerationalHandle<V, B>;
+
+            if (!handles || count <= 0)
+                return false;
+
+            for (int i = 0; i < count; i++)
+            {
+                int id;
+
+                if (!GetOrCreate(&id, 1))
+                    return false;
+
+                handles[i] = aim.GetHandle<H>(id);
+
+                if (handles[i].IsNull())            // 超出句柄索引范围
+                {
+                    Release(&id, 1);
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /**
+        * @brief CN:通过句柄释放数据（句柄失效则不做任何事）。\nEN:Release by handle (does nothing for stale handles).
+        */
+        template<typename V, int B>
+        bool Release(const GenerationalHandle<V, B> &h)
+        {
+            if (!aim.IsValid(h))
+                return false;
+
+            const int id = h.GetIndex();
+
+            return Release(&id, 1) == 1;
+        }
+
+    public: // 脏标记与增量导出
+
+        /**
+        * @brief CN:开启/关闭脏标记。\nEN:Enable/disable dirty tracking.
+        *
+        * CN:开启后WriteData/WriteDataArray/At()/可写ForEachActive会标记对应ID，激活/释放/压缩搬移会记录ID，由CollectDirty取出并清除。\nEN:When enabled, WriteData/WriteDataArray/At()/mutable ForEachActive mark IDs, activation/release/compaction moves are recorded, CollectDirty takes and clears them.
+        * CN:开启时当前所有活跃ID视为新建，以便对方得到完整的初始状态；关闭时清除所有记录。\nEN:On enable all current active IDs count as created so receivers get a full initial state; disabling drops all records.
+        */
+        void SetDirtyTracking(const bool enable)
+        {
+            if (dirty_tracking == enable)
+                return;
+
+            dirty_bits.clear();
+            created_bits.clear();
+            released_bits.clear();
+
+            dirty_tracking = enable;
+
+            if (enable)
+            {
+                const std::vector<uint64> &active = aim.GetActiveBits();
+
+                dirty_bits = active;
+                created_bits = active;
+            }
+        }
+
+        bool IsDirtyTracking() const
+        {
+            return dirty_tracking;
+        }
+
+        /**
+        * @brief CN:收集自上次调用以来的变化，并清除所有脏标记。\nEN:Collect changes since the last call and clear all dirty marks.
+        * @param delta CN:输出（先清空，复用已有容量）。\nEN:Output (cleared first, existing capacity is reused).
+        * @return CN:是否有任何变化。\nEN:Whether anything changed.
+        *
+        * CN:代价为 O(GetHistoryMaxId()/64 + 变化数量)。\nEN:Cost is O(GetHistoryMaxId()/64 + number of changes).
+        */
+        bool CollectDirty(Delta &delta)
+        {
+            delta.Clear();
+
+            if (!dirty_tracking)
+                return false;
+
+            ForEachTrackBit(released_bits, [&delta](int id){delta.released_ids.push_back(id);});
+            ForEachTrackBit(created_bits, [&delta](int id){delta.created_ids.push_back(id);});
+
+            ForEachTrackBit(dirty_bits, [this, &delta](int id)
+            {
+                if (!aim.IsActive(id))
+                    return;
+
+                delta.changed_ids.push_back(id);
+                delta.changed_values.push_back(data_array[id]);
+            });
+
+            std::fill(dirty_bits.begin(), dirty_bits.end(), 0);
+            std::fill(created_bits.begin(), created_bits.end(), 0);
+            std::fill(released_bits.begin(), released_bits.end(), 0);
+
+            return !delta.IsEmpty();
+        }
     };
 } // namespace hgl
+
+#include<hgl/type/ActiveDataManagerMultiColumn.h>
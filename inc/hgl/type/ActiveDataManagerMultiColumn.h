@@ -0,0 +1,359 @@
+﻿/**
+* @file ActiveDataManagerMultiColumn.h
+* @brief CN:多列(SoA)活动数据管理模板类，所有列共用一个ID空间。\nEN:Multi-column (SoA) active data manager, all columns share one ID space.
+*
+* CN:由ActiveDataManager.h包含，不要直接包含本文件。\nEN:Included by ActiveDataManager.h, do not include directly.
+*/
+#pragma once
+
+#include<span>
+#include<tuple>
+#include<utility>
+
+namespace hgl
+{
+    /**
+    * @brief CN:多列(SoA)活动数据管理模板类。\nEN:Multi-column (SoA) active data manager template class.
+    * @tparam T,Ts CN:各列的数据类型。EN:Data type of each column.
+    *
+    * CN:每一列是一个独立的连续数组，所有列由同一个ActiveIDManager管理，同一个ID在每一列中的下标相同。\nEN:Each column is its own contiguous array, all columns are managed by one ActiveIDManager, an ID indexes every column.
+    * CN:创建/释放ID只需一次，按列遍历(GetColumn)可直接用于SIMD循环。\nEN:IDs are created/released once, column-wise access (GetColumn) is suitable for SIMD loops.
+    *
+    * 用法示例 / Usage example:
+    * ActiveDataManager<Vector3f,Vector3f,uint32> particles;     // position, velocity, flags
+    * particles.GetOrCreate(ids,count);
+    * particles.WriteDataArray<0>(positions,ids,count);
+    * std::span<Vector3f> pos=particles.GetColumn<0>();
+    */
+    template<typename T,typename... Ts>
+    class ActiveDataManager
+    {
+    public:
+
+        static constexpr size_t COLUMN_COUNT=1+sizeof...(Ts);
+
+        template<size_t I> using ColumnType=std::tuple_element_t<I,std::tuple<T,Ts...>>;
+
+    protected:
+
+        /**
+        * @brief CN:活跃ID管理器（所有列共用）。\nEN:Active ID manager (shared by all columns).
+        */
+        ActiveIDManager aim;
+
+        /**
+        * @brief CN:各列数据数组。\nEN:Data array of each column.
+        */
+        std::tuple<std::vector<T>,std::vector<Ts>...> columns;
+
+        template<typename F>
+        void ForEachColumn(F &&func)
+        {
+            std::apply([&func](auto &...column){(func(column),...);},columns);
+        }
+
+        void ResizeColumns(const size_t size)
+        {
+            ForEachColumn([size](auto &column){column.resize(size);});
+        }
+
+        bool IsValidIndex(const int id) const
+        {
+            return id>=0&&id<(int)std::get<0>(columns).size();
+        }
+
+        template<typename F,size_t... I>
+        void CallWithRow(F &func,const int id,std::index_sequence<I...>)
+        {
+            func(id,std::get<I>(columns)[id]...);
+        }
+
+        template<typename F,size_t... I>
+        void CallWithRow(F &func,const int id,std::index_sequence<I...>) const
+        {
+            func(id,std::get<I>(columns)[id]...);
+        }
+
+    public:
+
+        ActiveDataManager()=default;
+        virtual ~ActiveDataManager()=default;
+
+        /**
+        * @brief CN:预分配容量。\nEN:Reserve capacity.
+        */
+        void Reserve(int c)
+        {
+            aim.Reserve(c);
+
+            ForEachColumn([c](auto &column){column.reserve(c);});
+        }
+
+        int GetActiveCount  ()const{return aim.GetActiveCount();}
+        int GetIdleCount    ()const{return aim.GetIdleCount();}
+        int GetTotalCount   ()const{return aim.GetTotalCount();}
+        int GetHistoryMaxId ()const{return aim.GetHistoryMaxId();}
+
+        bool IsActive(const int id)const{return aim.IsActive(id);}
+
+        std::vector<int> GetActiveView()const{return aim.GetActiveView();}
+        std::vector<int> GetIdleView()const{return aim.GetIdleView();}
+        ActiveIDRange GetActiveIDs()const{return aim.GetActiveIDs();}
+        int FindNextActive(const int id)const{return aim.FindNextActive(id);}
+        int GetActiveByIndex(const int index)const{return aim.GetActiveByIndex(index);}
+
+    public: // 列访问
+
+        /**
+        * @brief CN:取得整列数据（下标即ID，长度为GetHistoryMaxId()，包含非活跃ID的槽位）。\nEN:Get a whole column (indexed by ID, length GetHistoryMaxId(), includes slots of inactive IDs).
+        * @note CN:创建新ID或压缩后span失效。\nEN:The span is invalidated by creating IDs or compaction.
+        */
+        template<size_t I>
+        std::span<ColumnType<I>> GetColumn()
+        {
+            return std::span<ColumnType<I>>(std::get<I>(columns));
+        }
+
+        template<size_t I>
+        std::span<const ColumnType<I>> GetColumn() const
+        {
+            return std::span<const ColumnType<I>>(std::get<I>(columns));
+        }
+
+        /**
+        * @brief CN:获取指定ID在第I列的数据指针。\nEN:Get pointer to column I data of an ID.
+        */
+        template<size_t I>
+        ColumnType<I> *At(const int id)
+        {
+            if(!IsValidIndex(id))return nullptr;
+            return &std::get<I>(columns)[id];
+        }
+
+        template<size_t I>
+        const ColumnType<I> *At(const int id) const
+        {
+            if(!IsValidIndex(id))return nullptr;
+            return &std::get<I>(columns)[id];
+        }
+
+        /**
+        * @brief CN:写入指定ID在第I列的数据。\nEN:Write column I data of an ID.
+        */
+        template<size_t I>
+        bool WriteData(const ColumnType<I> &d,const int id)
+        {
+            if(!IsValidIndex(id))return false;
+            std::get<I>(columns)[id]=d;
+            return true;
+        }
+
+        /**
+        * @brief CN:写入指定ID的整行数据（每列一个值）。\nEN:Write a whole row of an ID (one value per column).
+        */
+        bool WriteRow(const int id,const T &d,const Ts &...ds)
+        {
+            if(!IsValidIndex(id))return false;
+
+            std::apply([id](auto &...column){return std::tie(column[id]...);},columns)=std::tie(d,ds...);
+            return true;
+        }
+
+        /**
+        * @brief CN:读取指定ID的整行数据。\nEN:Read a whole row of an ID.
+        */
+        bool GetRow(const int id,T &d,Ts &...ds) const
+        {
+            if(!IsValidIndex(id))return false;
+
+            std::tie(d,ds...)=std::apply([id](const auto &...column){return std::tie(column[id]...);},columns);
+            return true;
+        }
+
+        /**
+        * @brief CN:按ID列表批量写入第I列（da为连续排列的数据）。\nEN:Batch scatter into column I (da is packed data).
+        * @return CN:成功写入的数量。\nEN:Number of items written.
+        */
+        template<size_t I>
+        int WriteDataArray(const ColumnType<I> *da,const int *idp,const int count)
+        {
+            if(!da||!idp||count<=0)return 0;
+
+            ColumnType<I> *column=std::get<I>(columns).data();
+            const int size=GetHistoryMaxId();
+            int result=0;
+
+            for(int i=0;i<count;i++)
+            {
+                if(idp[i]>=0&&idp[i]<size)
+                {
+                    column[idp[i]]=da[i];
+                    ++result;
+                }
+            }
+
+            return result;
+        }
+
+        /**
+        * @brief CN:按ID列表批量读取第I列，并整齐排列到da中。\nEN:Batch gather column I into packed da.
+        * @return CN:成功读取的数量（无效ID对应的da项不修改）。\nEN:Number of items read (entries for invalid IDs are left untouched).
+        */
+        template<size_t I>
+        int GetData(ColumnType<I> *da,const int *idp,const int count) const
+        {
+            if(!da||!idp||count<=0)return 0;
+
+            const ColumnType<I> *column=std::get<I>(columns).data();
+            const int size=GetHistoryMaxId();
+            int result=0;
+
+            for(int i=0;i<count;i++)
+            {
+                if(idp[i]>=0&&idp[i]<size)
+                {
+                    da[i]=column[idp[i]];
+                    ++result;
+                }
+            }
+
+            return result;
+        }
+
+        /**
+        * @brief CN:按ID升序遍历所有活跃行。\nEN:Visit all active rows in ascending ID order.
+        * @param func CN:回调 func(int id, T &, Ts &...)。\nEN:Callback func(int id, T &, Ts &...).
+        */
+        template<typename F>
+        void ForEachActive(F &&func)
+        {
+            aim.ForEachActive([this,&func](int id){CallWithRow(func,id,std::index_sequence_for<T,Ts...>{});});
+        }
+
+        template<typename F>
+        void ForEachActive(F &&func) const
+        {
+            aim.ForEachActive([this,&func](int id){CallWithRow(func,id,std::index_sequence_for<T,Ts...>{});});
+        }
+
+    public: // ID管理
+
+        void CreateActive(int *id,const int count=1)
+        {
+            aim.CreateActive(id,count);
+
+            ResizeColumns(aim.GetHistoryMaxId());
+        }
+
+        void CreateIdle(int *idp=nullptr,const int count=1)
+        {
+            aim.CreateIdle(idp,count);
+
+            ResizeColumns(aim.GetHistoryMaxId());
+        }
+
+        void CreateIdle(const int count=1)
+        {
+            CreateIdle(nullptr,count);
+        }
+
+        bool Get(int *id,const int count=1)
+        {
+            return aim.Get(id,count);
+        }
+
+        bool GetOrCreate(int *id,const int count=1)
+        {
+            if(!aim.GetOrCreate(id,count))
+                return false;
+
+            ResizeColumns(aim.GetHistoryMaxId());
+            return true;
+        }
+
+        int Release(const int *id,const int count=1)
+        {
+            return aim.Release(id,count);
+        }
+
+        int ReleaseAllActive()
+        {
+            return aim.ReleaseAllActive();
+        }
+
+        void Clear()
+        {
+            aim.ReleaseAllActive();
+        }
+
+        void Free()
+        {
+            aim.Free();
+
+            ForEachColumn([](auto &column)
+            {
+                column.clear();
+                column.shrink_to_fit();
+            });
+        }
+
+    public: // 压缩
+
+        bool IsCompact()const{return aim.IsCompact();}
+
+        /**
+        * @brief CN:增量压缩，所有列同步搬移。\nEN:Incremental compaction, all columns move together.
+        * @see ActiveDataManager<T>::CompactStep
+        */
+        int CompactStep(const int max_move,std::vector<ActiveIDRemap> *moved=nullptr)
+        {
+            std::vector<ActiveIDRemap> local_moved;
+            std::vector<ActiveIDRemap> &list=moved?*moved:local_moved;
+
+            const size_t first=list.size();
+            const int result=aim.Compact(list,max_move);
+
+            ForEachColumn([&list,first](auto &column)
+            {
+                for(size_t i=first;i<list.size();i++)
+                    column[list[i].new_id]=std::move(column[list[i].old_id]);
+            });
+
+            if(aim.IsCompact())
+                ResizeColumns(aim.GetHistoryMaxId());
+
+            return result;
+        }
+
+        int Compact()
+        {
+            return CompactStep(INT_MAX);
+        }
+
+    public: // 代数句柄
+
+        template<typename H=ActiveHandle>
+        H GetHandle(const int id)const
+        {
+            return aim.GetHandle<H>(id);
+        }
+
+        template<typename V,int B>
+        bool IsValid(const GenerationalHandle<V,B> &h)const
+        {
+            return aim.IsValid(h);
+        }
+
+        template<size_t I,typename V,int B>
+        ColumnType<I> *At(const GenerationalHandle<V,B> &h)
+        {
+            return aim.IsValid(h)?std::get<I>(columns).data()+h.GetIndex():nullptr;
+        }
+
+        template<size_t I,typename V,int B>
+        const ColumnType<I> *At(const GenerationalHandle<V,B> &h) const
+        {
+            return aim.IsValid(h)?std::get<I>(columns).data()+h.GetIndex():nullptr;
+        }
+    };//template<typename T,typename... Ts> class ActiveDataManager
+}//namespace hgl
@@ -1,36 +1,244 @@
 ﻿#pragma once
 
-#include<absl/container/btree_set.h>
+#include<hgl/CoreType.h>
+#include<bit>
+#include<algorithm>
+#include<climits>
+#include<cstddef>
 #include<deque>
 #include<vector>
 
 namespace hgl
 {
+    /**
+    * 压缩时的ID搬移记录
+    */
+    struct ActiveIDRemap
+    {
+        int old_id;                         ///<搬移前的ID
+        int new_id;                         ///<搬移后的ID
+    };
+
+    /**
+    * 代数句柄：把ID(索引)与代数打包到一个整数中
+    *
+    * ID被释放时其代数加1，之后再复用这个ID时旧句柄的代数就对不上了，
+    * 因此可以安全地长期保存句柄(如跨帧缓存)，无需再用哈希表确认ID是否仍指向原数据。
+    * 代数只保存低GEN_BITS位，32位句柄在同一ID被复用2^GEN_BITS次后会回绕。
+    *
+    * @tparam V 存储类型(uint32/uint64)
+    * @tparam INDEX_BITS 索引所占位数(低位)，其余高位为代数
+    */
+    template<typename V,int INDEX_BITS> struct GenerationalHandle
+    {
+        static constexpr int GEN_BITS=int(sizeof(V)*8)-INDEX_BITS;
+
+        static_assert(INDEX_BITS>0&&INDEX_BITS<=32,"INDEX_BITS must be in [1,32].");
+        static_assert(GEN_BITS>=8&&GEN_BITS<=32,"Generation needs 8 to 32 bits.");
+
+        static constexpr V INDEX_MASK=(V(1)<<INDEX_BITS)-1;
+        static constexpr V GEN_MASK=V((uint64(1)<<GEN_BITS)-1);
+
+        V value=0;                                  ///<0为无效句柄(代数永不为0)
+
+    public:
+
+        GenerationalHandle()=default;
+        GenerationalHandle(const int index,const uint32 gen):value((V(gen)&GEN_MASK)<<INDEX_BITS|(V(index)&INDEX_MASK)){}
+
+        int     GetIndex        ()const{return int(value&INDEX_MASK);}
+        uint32  GetGeneration   ()const{return uint32(value>>INDEX_BITS);}
+
+        bool    IsNull          ()const{return value==0;}
+        bool    Match           (const uint32 gen)const{return (gen&GEN_MASK)==GetGeneration();}   ///<代数是否一致
+
+        bool operator==(const GenerationalHandle &h)const{return value==h.value;}
+        bool operator!=(const GenerationalHandle &h)const{return value!=h.value;}
+    };//template<typename V,int INDEX_BITS> struct GenerationalHandle
+
+    using ActiveHandle32=GenerationalHandle<uint32,20>;     ///<32位句柄(100万个ID，4096代)
+    using ActiveHandle64=GenerationalHandle<uint64,32>;     ///<64位句柄(20亿个ID，32位代数)
+    using ActiveHandle  =ActiveHandle64;
+
+    /**
+    * 活跃ID迭代器（非拥有，直接扫描活跃位图，按ID升序）
+    *
+    * 注：迭代期间不可修改ActiveIDManager的活跃状态
+    */
+    class ActiveIDIterator
+    {
+        const uint64 *bits;
+        int word_count;
+        int word_index;
+        uint64 word;                        ///<当前字中尚未访问的位
+
+        void SkipEmptyWord()
+        {
+            while(!word)
+            {
+                if(++word_index>=word_count)
+                {
+                    word_index=word_count;          //统一结束位置，与end()相等
+                    return;
+                }
+
+                word=bits[word_index];
+            }
+        }
+
+    public:
+
+        using value_type=int;
+        using difference_type=std::ptrdiff_t;
+
+        ActiveIDIterator():bits(nullptr),word_count(0),word_index(0),word(0){}
+
+        ActiveIDIterator(const uint64 *b,const int wc,const int wi)
+            :bits(b),word_count(wc),word_index(wi<wc?wi:wc),word(wi<wc?b[wi]:0)
+        {
+            if(word_index<word_count)
+                SkipEmptyWord();
+        }
+
+        int operator*()const{return (word_index<<6)+std::countr_zero(word);}
+
+        ActiveIDIterator &operator++()
+        {
+            word&=word-1;
+            SkipEmptyWord();
+            return *this;
+        }
+
+        ActiveIDIterator operator++(int)
+        {
+            ActiveIDIterator temp=*this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const ActiveIDIterator &other)const{return word_index==other.word_index&&word==other.word;}
+        bool operator!=(const ActiveIDIterator &other)const{return !(*this==other);}
+    };//class ActiveIDIterator
+
+    /**
+    * 活跃ID范围（非拥有视图，不分配内存，可直接用于range-for）
+    */
+    class ActiveIDRange
+    {
+        const uint64 *bits;
+        int word_count;
+        int count;
+
+    public:
+
+        ActiveIDRange(const uint64 *b,const int wc,const int c):bits(b),word_count(wc),count(c){}
+
+        ActiveIDIterator begin()const{return ActiveIDIterator(bits,word_count,0);}
+        ActiveIDIterator end()const{return ActiveIDIterator(bits,word_count,word_count);}
+
+        int size()const{return count;}
+        bool empty()const{return count==0;}
+    };//class ActiveIDRange
+
     /**
     * 活跃ID管理器
     *
     * 设计说明：
     * - 管理一个ID池，支持创建、获取、释放操作
-    * - 活跃ID存储在 absl::btree_set 中，支持快速有序查询 O(log n)
-    * - 闲置ID存储在 std::deque 中（FIFO），确保公平复用，避免ID碎片化
+    * - ID总是从0开始连续分配（稠密且以id_count为上界），因此活跃状态使用位图存储：
+    *   每个ID一位，IsActive/CreateActive/Release 均为 O(1) 且无节点分配
+    * - 闲置ID存储在 std::deque 中（FIFO），确保公平复用，避免ID碎片化；另有一份闲置位图用于 O(1) 的 IsIdle
+    * - 统计按64位字做popcount，活跃ID遍历按字做tzcnt，均按ID升序
+    * - 支持压缩（Compact）：把高位的活跃ID搬到低位空洞中，完成后ID稠密排列在[0,active_count)，
+    *   可一次完成，也可按步数分多次增量进行；闲置队列中被填掉的项采用惰性删除，由queued_bits保证不重复入队
+    * - 每个ID有一个代数(generation)，ID每次离开活跃状态(释放/压缩搬走)时加1，用于校验代数句柄(GenerationalHandle)
     * - 提供完整的验证和统计功能
     */
     class ActiveIDManager
     {
-        absl::btree_set<int> active_list;   ///<活跃ID列表（有序集合）
+    public:
+
+        /**
+        * ID集合（兼容原有序集合接口的只读视图，按ID升序遍历位图，始终反映管理器的当前状态）
+        */
+        class IDSet
+        {
+            friend class ActiveIDManager;
+
+            using BitsMember=std::vector<uint64> ActiveIDManager::*;
+            using CountMember=int ActiveIDManager::*;
+
+            const ActiveIDManager *owner;
+            BitsMember bits;
+            CountMember count_member;
+
+            IDSet(const ActiveIDManager *o,BitsMember b,CountMember c):owner(o),bits(b),count_member(c){}
+
+            const std::vector<uint64> &Bits()const{return owner->*bits;}
+
+        public:
+
+            ActiveIDIterator begin()const{return ActiveIDIterator(Bits().data(),int(Bits().size()),0);}
+            ActiveIDIterator end()const{return ActiveIDIterator(Bits().data(),int(Bits().size()),int(Bits().size()));}
+
+            int size()const{return owner->*count_member;}
+            bool empty()const{return size()==0;}
+            bool contains(const int id)const{return owner->IsValid(id)&&TestBit(Bits(),id);}
+            int count(const int id)const{return contains(id)?1:0;}
+        };//class IDSet
+
+    private:
+
+        std::vector<uint64> active_bits;    ///<活跃ID位图（第id位为1表示活跃）
+        std::vector<uint64> idle_bits;      ///<闲置ID位图（第id位为1表示闲置）
+        std::vector<uint64> queued_bits;    ///<已在idle_list中的ID位图（压缩后队列中可能残留已非闲置的ID，取出时跳过）
         std::deque<int> idle_list;          ///<闲置ID列表（FIFO队列，确保公平复用）
+        std::vector<uint32> generation;     ///<每个ID的代数（ID离开活跃状态时加1，压缩收缩ID空间时也不会丢弃，避免旧句柄误匹配）
 
+        int active_count;                   ///<活跃ID数量
+        int idle_count;                     ///<闲置ID数量
         int id_count;                       ///<创建过的最大ID值+1
         int released_count;                 ///<已释放过的ID总数（用于统计）
 
+        mutable IDSet active_set{this,&ActiveIDManager::active_bits,&ActiveIDManager::active_count};    ///<GetActiveSet返回的视图（移动后重新绑定）
+        mutable IDSet idle_set{this,&ActiveIDManager::idle_bits,&ActiveIDManager::idle_count};          ///<GetIdleSet返回的视图
+
     private:
 
+        static constexpr int BitWordCount(const int bit_count){return (bit_count+63)>>6;}
+
+        static bool TestBit(const std::vector<uint64> &bits,const int id){return (bits[id>>6]>>(id&63))&1;}
+        static void SetBit(std::vector<uint64> &bits,const int id){bits[id>>6]|=uint64(1)<<(id&63);}
+        static void ClearBit(std::vector<uint64> &bits,const int id){bits[id>>6]&=~(uint64(1)<<(id&63));}
+
         bool Create(int *id_list,const int count);
 
+        void NextGeneration(const int id)                                       ///<ID离开活跃状态，代数加1
+        {
+            uint32 &gen=generation[id];
+
+            if(!uint8(++gen))   //低8位永不为0，保证任意宽度的句柄中代数都不为0(0句柄恒为无效)
+                ++gen;
+        }
+
+        void PushIdle(const int id)                                             ///<将ID加入闲置队列尾部(已在队列中则不重复加入)
+        {
+            SetBit(idle_bits,id);
+            ++idle_count;
+
+            if(TestBit(queued_bits,id))
+                return;
+
+            SetBit(queued_bits,id);
+            idle_list.push_back(id);
+        }
+
+        void Trim();
+
     public:
 
         ActiveIDManager()
-            : id_count(0), released_count(0)
+            : active_count(0), idle_count(0), id_count(0), released_count(0)
         {
         }
 
@@ -46,28 +254,88 @@ namespace hgl
 
         // ==================== 查询接口 ====================
 
-        int GetActiveCount  ()const{return static_cast<int>(active_list.size());}
-        int GetIdleCount    ()const{return static_cast<int>(idle_list.size());}
+        int GetActiveCount  ()const{return active_count;}
+        int GetIdleCount    ()const{return idle_count;}
         int GetTotalCount   ()const{return GetActiveCount() + GetIdleCount();}
         int GetHistoryMaxId ()const{return id_count;}
         int GetReleasedCount()const{return released_count;}        ///<已释放过的ID总数
 
+        /**
+         * @brief CN:获取活跃ID位图的只读访问\nEN:Get read-only access to active ID bitmap
+         * @return 每个ID一位的 uint64 数组，第id位为1表示活跃
+         */
+        const std::vector<uint64>& GetActiveBits() const
+        {
+            return active_bits;
+        }
+
         /**
          * @brief CN:获取活跃ID集合的只读访问\nEN:Get read-only access to active ID set
-         * @return btree_set 的 const 引用，支持有序遍历
+         * @return 升序遍历的集合视图，支持 size/empty/contains 与 range-for，不分配内存
+         */
+        const IDSet& GetActiveSet() const
+        {
+            active_set.owner=this;
+            return active_set;
+        }
+
+        /**
+         * @brief CN:获取闲置ID集合的只读访问\nEN:Get read-only access to idle ID set
+         * @return 按ID升序遍历的集合视图（复用顺序请用 GetIdleView）
          */
-        const absl::btree_set<int>& GetActiveSet() const
+        const IDSet& GetIdleSet() const
         {
-            return active_list;
+            idle_set.owner=this;
+            return idle_set;
+        }
+
+        /**
+         * @brief CN:按ID升序遍历所有活跃ID\nEN:Visit all active IDs in ascending order
+         * @param func 回调，参数为 int id
+         *
+         * CN:按64位字扫描位图，用tzcnt跳过非活跃ID，不产生任何分配。
+         */
+        template<typename F>
+        void ForEachActive(F &&func) const
+        {
+            const int word_count=static_cast<int>(active_bits.size());
+
+            for(int w=0;w<word_count;w++)
+            {
+                uint64 word=active_bits[w];
+
+                while(word)
+                {
+                    func((w<<6)+std::countr_zero(word));
+
+                    word&=word-1;
+                }
+            }
+        }
+
+        /**
+         * @brief CN:获取活跃ID范围视图\nEN:Get non-owning view of active IDs
+         * @return 可直接range-for的升序ID范围，不分配内存；活跃状态改变后视图失效
+         */
+        ActiveIDRange GetActiveIDs() const
+        {
+            return ActiveIDRange(active_bits.data(),static_cast<int>(active_bits.size()),active_count);
         }
 
         /**
          * @brief CN:获取活跃ID列表快照\nEN:Get snapshot of active ID list
-         * @return 包含所有活跃ID的 vector
+         * @return 包含所有活跃ID的 vector（升序）
+         * @note CN:每次调用都会分配并复制，热路径请使用 GetActiveIDs() 或 ForEachActive()
          */
         std::vector<int> GetActiveView() const
         {
-            return std::vector<int>(active_list.begin(), active_list.end());
+            std::vector<int> result;
+
+            result.reserve(active_count);
+
+            ForEachActive([&result](int id){result.push_back(id);});
+
+            return result;
         }
 
         /**
@@ -76,7 +344,41 @@ namespace hgl
          */
         std::vector<int> GetIdleView() const
         {
-            return std::vector<int>(idle_list.begin(), idle_list.end());
+            std::vector<int> result;
+
+            result.reserve(idle_count);
+
+            for(const int id:idle_list)
+                if(TestBit(idle_bits,id))
+                    result.push_back(id);
+
+            return result;
+        }
+
+        // ==================== 代数句柄 ====================
+
+        uint32 GetGeneration(const int id)const{return IsValid(id)?generation[id]:0;}  ///<取得ID当前的代数
+        const uint32 *GetGenerationArray()const{return generation.data();}            ///<取得代数数组(按ID索引)
+
+        /**
+         * 取得活跃ID的代数句柄
+         * @return 句柄，ID不处于活跃状态(或超出句柄索引范围)则返回空句柄
+         */
+        template<typename H=ActiveHandle> H GetHandle(const int id)const
+        {
+            if(!IsActive(id)||uint64(id)>uint64(H::INDEX_MASK))return H();
+
+            return H(id,generation[id]);
+        }
+
+        /**
+         * 校验句柄是否仍然有效（ID仍处于活跃状态，且自取得句柄后未被释放复用）
+         */
+        template<typename V,int B> bool IsValid(const GenerationalHandle<V,B> &h)const
+        {
+            const int id=h.GetIndex();
+
+            return id>=0&&id<id_count&&h.Match(generation[id]);     //64位句柄的索引最高位为1时GetIndex为负
         }
 
         // ==================== 创建接口 ====================
@@ -110,12 +412,158 @@ namespace hgl
 
         // ==================== 查询和验证接口 ====================
 
-        bool IsActive(const int id)const{return active_list.contains(id);}  ///<确认指定ID是否处于活跃状态
-        bool IsIdle  (const int id)const
+        bool IsValid (const int id)const{return id>=0 && id<id_count;}                  ///<确认指定ID是否曾被创建过
+        bool IsActive(const int id)const{return IsValid(id) && TestBit(active_bits,id);}///<确认指定ID是否处于活跃状态
+        bool IsIdle  (const int id)const{return IsValid(id) && TestBit(idle_bits,id);}  ///<确认指定ID是否处于闲置状态
+
+        /**
+         * 统计指定范围内的活跃ID数量（按64位字popcount）
+         * @param first 起始ID（含）
+         * @param last 结束ID（不含）
+         */
+        int GetActiveCountInRange(int first,int last)const
         {
-            return std::find(idle_list.begin(), idle_list.end(), id) != idle_list.end();
+            if(first<0)first=0;
+            if(last>id_count)last=id_count;
+            if(first>=last)return 0;
+
+            const int first_word=first>>6;
+            const int last_word=(last-1)>>6;
+
+            const uint64 first_mask=~uint64(0)<<(first&63);
+            const uint64 last_mask=~uint64(0)>>(63-((last-1)&63));
+
+            if(first_word==last_word)
+                return std::popcount(active_bits[first_word]&first_mask&last_mask);
+
+            int result=std::popcount(active_bits[first_word]&first_mask);
+
+            for(int w=first_word+1;w<last_word;w++)
+                result+=std::popcount(active_bits[w]);
+
+            return result+std::popcount(active_bits[last_word]&last_mask);
         }
-        bool IsValid (const int id)const{return id>=0 && id<id_count;}      ///<确认指定ID是否曾被创建过
+
+        /**
+         * 取得按升序排列的第index个活跃ID（按字popcount跳跃定位，不分配内存）
+         * @return 活跃ID，index越界返回-1
+         */
+        int GetActiveByIndex(int index)const
+        {
+            if(index<0||index>=active_count)return -1;
+
+            const int word_count=static_cast<int>(active_bits.size());
+
+            for(int w=0;w<word_count;w++)
+            {
+                uint64 word=active_bits[w];
+                const int bc=std::popcount(word);
+
+                if(index>=bc)
+                {
+                    index-=bc;
+                    continue;
+                }
+
+                while(index--)
+                    word&=word-1;
+
+                return (w<<6)+std::countr_zero(word);
+            }
+
+            return -1;
+        }
+
+        /**
+         * 查找大于等于指定ID的第一个活跃ID（按字tzcnt）
+         * @return 活跃ID，没有则返回-1
+         */
+        int FindNextActive(int id)const
+        {
+            if(id<0)id=0;
+            if(id>=id_count)return -1;
+
+            const int word_count=static_cast<int>(active_bits.size());
+
+            int w=id>>6;
+            uint64 word=active_bits[w]&(~uint64(0)<<(id&63));
+
+            while(true)
+            {
+                if(word)
+                    return (w<<6)+std::countr_zero(word);
+
+                if(++w>=word_count)
+                    return -1;
+
+                word=active_bits[w];
+            }
+        }
+
+        /**
+         * 查找小于等于指定ID的最后一个活跃ID（按字lzcnt）
+         * @return 活跃ID，没有则返回-1
+         */
+        int FindPrevActive(int id)const
+        {
+            if(id>=id_count)id=id_count-1;
+            if(id<0)return -1;
+
+            int w=id>>6;
+            uint64 word=active_bits[w]&(~uint64(0)>>(63-(id&63)));
+
+            while(true)
+            {
+                if(word)
+                    return (w<<6)+63-std::countl_zero(word);
+
+                if(--w<0)
+                    return -1;
+
+                word=active_bits[w];
+            }
+        }
+
+        /**
+         * 查找大于等于指定ID的第一个闲置ID（按字tzcnt）
+         * @return 闲置ID，没有则返回-1
+         */
+        int FindNextIdle(int id)const
+        {
+            if(id<0)id=0;
+            if(id>=id_count)return -1;
+
+            const int word_count=static_cast<int>(idle_bits.size());
+
+            int w=id>>6;
+            uint64 word=idle_bits[w]&(~uint64(0)<<(id&63));
+
+            while(true)
+            {
+                if(word)
+                    return (w<<6)+std::countr_zero(word);
+
+                if(++w>=word_count)
+                    return -1;
+
+                word=idle_bits[w];
+            }
+        }
+
+        // ==================== 压缩接口 ====================
+
+        bool IsCompact()const{return idle_count==0;}                            ///<是否已压缩(所有ID均活跃，即ID稠密排列在[0,active_count))
+
+        /**
+         * 压缩ID空间：把最高的活跃ID搬到最低的闲置ID上，直到活跃ID稠密排列在[0,active_count)
+         * @param moved 追加每次搬移的(旧ID,新ID)，调用者需据此搬移数据并更新自己的索引
+         * @param max_move 本次最多搬移的数量(增量压缩用，默认不限)
+         * @return 本次搬移的数量
+         *
+         * 注：被搬走的高位ID会变为闲置（与普通释放相同，可被复用）；
+         * 当低位不再有空洞时压缩完成，此时所有闲置ID被丢弃，id_count收缩为active_count，IsCompact()返回true。
+         */
+        int Compact(std::vector<ActiveIDRemap> &moved,const int max_move=INT_MAX);
 
         // ==================== 内存管理接口 ====================
 
@@ -131,14 +579,28 @@ namespace hgl
          */
         void Clear(bool reset_counter=false)
         {
-            active_list.clear();
+            // 所有活跃ID离开活跃状态，使已发出的句柄失效(代数数组保留，重置计数器后重新创建的ID也不会与旧句柄匹配)
+            ForEachActive([this](int id){NextGeneration(id);});
+
             idle_list.clear();
+            active_count = 0;
+            idle_count = 0;
 
             if(reset_counter)
             {
+                active_bits.clear();
+                idle_bits.clear();
+                queued_bits.clear();
+
                 id_count = 0;
                 released_count = 0;
             }
+            else
+            {
+                std::fill(active_bits.begin(), active_bits.end(), 0);
+                std::fill(idle_bits.begin(), idle_bits.end(), 0);
+                std::fill(queued_bits.begin(), queued_bits.end(), 0);
+            }
         }
 
         /**
@@ -146,16 +608,27 @@ namespace hgl
          *
          * CN:彻底释放内部容器的内存，并将所有计数器归零。\nEN:Completely frees internal container memory and resets all counters to zero.
          * CN:适用于不再需要管理器时的彻底清理。\nEN:Suitable for thorough cleanup when the manager is no longer needed.
+         * CN:代数数组保留，之前发出的代数句柄在重新创建ID后仍然无效。\nEN:The generation array is kept so handles issued before Free() stay invalid after IDs are recreated.
          *
          * 用法示例 / Usage example:
          * idm.Free();  // CN:彻底释放所有资源 / EN:Completely free all resources
          */
         void Free()
         {
-            active_list.clear();
+            // 与Clear相同：活跃ID代数加1使旧句柄失效。代数数组不释放，重新创建的ID从原代数继续
+            ForEachActive([this](int id){NextGeneration(id);});
+
+            active_bits.clear();
+            active_bits.shrink_to_fit();
+            idle_bits.clear();
+            idle_bits.shrink_to_fit();
+            queued_bits.clear();
+            queued_bits.shrink_to_fit();
             idle_list.clear();
             idle_list.shrink_to_fit();  // 释放 deque 的内存
 
+            active_count = 0;
+            idle_count = 0;
             id_count = 0;
             released_count = 0;
         }
@@ -164,7 +637,7 @@ namespace hgl
 
         /**
          * 获取总的已分配ID数
-         * = active_list.GetCount() + idle_list.GetCount()
+         * = GetActiveCount() + GetIdleCount()
          */
         int GetAllocatedCount() const { return GetTotalCount(); }
 
@@ -181,7 +654,7 @@ namespace hgl
         /**
          * 检查是否有闲置ID可复用
          */
-        bool HasIdleID() const { return !idle_list.empty(); }
+        bool HasIdleID() const { return idle_count > 0; }
 
         /**
          * 获取剩余可分配的ID容量
@@ -212,14 +685,15 @@ namespace hgl
         /**
          * 相等比较：检查两个管理器的状态是否完全相同
          *
-         * 注：Queue类型不支持==比较，仅比较计数器和active_list
+         * 注：仅比较计数器和活跃位图，不比较闲置队列的顺序
          */
         bool operator==(const ActiveIDManager &other) const
         {
             return id_count == other.id_count
                 && released_count == other.released_count
+                && active_count == other.active_count
                 && GetIdleCount() == other.GetIdleCount()
-                && active_list == other.active_list;
+                && active_bits == other.active_bits;
         }
 
         /**
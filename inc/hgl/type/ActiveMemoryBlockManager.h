@@ -59,5 +59,36 @@ namespace hgl
 
         int Release(int *id,const int count=1);
         int ReleaseAllActive();
+
+    public: //代数句柄
+
+        template<typename H=ActiveHandle> H GetHandle(const int id)const{return aim.GetHandle<H>(id);}        ///<取得活跃ID的代数句柄(非活跃返回空句柄)
+
+        template<typename V,int B> bool IsValid(const GenerationalHandle<V,B> &h)const{return aim.IsValid(h);} ///<句柄是否仍然有效
+
+        /**
+        * 通过句柄取得数据指针(一次代数比较加一次读取)
+        * @return 数据指针，句柄失效返回nullptr
+        */
+        template<typename V,int B> void *GetData(const GenerationalHandle<V,B> &h)const
+        {
+            if(unit_size==0||!aim.IsValid(h))
+                return(nullptr);
+
+            return (uint8 *)(data_mb->Get())+h.GetIndex()*unit_size;
+        }
+
+        /**
+        * 通过句柄释放数据(句柄失效则不做任何事)
+        */
+        template<typename V,int B> bool Release(const GenerationalHandle<V,B> &h)
+        {
+            if(!aim.IsValid(h))
+                return(false);
+
+            int id=h.GetIndex();
+
+            return aim.Release(&id,1)==1;
+        }
     };//class ActiveMemoryBlockManager
 }//namespace hgl
@@ -0,0 +1,367 @@
+﻿#pragma once
+
+#include<algorithm>
+#include<hgl/type/OrderedSet.h>
+#include<hgl/type/FlatOrderedSet.h>
+
+namespace hgl
+{
+    /**
+    * @brief CN:自适应有序集合的内部表示\nEN:Representation used by AdaptiveOrderedSet
+    */
+    enum class AdaptiveSetMode
+    {
+        Tree,           ///<CN:B树(OrderedSet)，插入/删除O(log n)。EN:B-tree (OrderedSet), O(log n) insert/delete.
+        Flat,           ///<CN:有序数组(FlatOrderedSet)，查找与遍历更快。EN:Sorted array (FlatOrderedSet), faster lookup and scans.
+    };
+
+    // AI NOTE: Ordered set that holds either an OrderedSet (btree) or a
+    // FlatOrderedSet (sorted vector) and migrates between them. Reads and
+    // writes are counted per window; a read-only window moves Tree->Flat,
+    // a burst of single-element writes moves Flat->Tree. Migration is O(n)
+    // and happens inside const reads, so the set is not safe for concurrent
+    // readers unless auto adaptation is disabled.
+    /**
+     * 自适应有序集合</br>
+     * 根据读写比例在 OrderedSet(B树) 与 FlatOrderedSet(有序数组) 两种表示之间自动切换</br>
+     *
+     * <b>切换规则：</b>
+     * - 以窗口统计读写次数，窗口长度为 max(1024, 元素数/4) 次操作，迁移的O(n)代价摊到整个窗口
+     * - Tree表示：窗口结束时若写入不超过读取的1/16，转为Flat
+     * - Flat表示：单元素写入在窗口内达到16次且不少于读取的1/8时，立即转回Tree
+     * - Flat表示下的批量添加/删除是一次线性合并，只计为一次写入
+     * - 也可在阶段结束时调用 Optimize() 直接转为Flat，或 SetMode() 指定表示
+     *
+     * <b>与 OrderedSet 的区别：</b>
+     * - Add 返回是否添加成功而不是索引（B树求索引需要O(n)）
+     * - 两种表示的迭代器类型不同，遍历请使用 Enum()
+     * - 自动切换可能发生在 const 读取中，多线程并发读取前请 SetAutoAdapt(false)
+     *
+     * @tparam T 必须支持 operator< 用于排序，operator== 用于去重
+     * @see OrderedSet
+     * @see FlatOrderedSet
+     */
+    template<typename T>
+    class AdaptiveOrderedSet
+    {
+    protected:
+        using ThisClass = AdaptiveOrderedSet<T>;
+
+        static constexpr int64 MIN_WINDOW = 1024;
+        static constexpr int64 FLAT_WRITE_LIMIT = 16;
+
+        // 表示切换不改变集合内容，允许在const读取中进行
+        mutable OrderedSet<T> tree;
+        mutable FlatOrderedSet<T> flat;
+        mutable AdaptiveSetMode mode = AdaptiveSetMode::Tree;
+
+        bool auto_adapt = true;
+
+        mutable int64 window_reads = 0;
+        mutable int64 window_writes = 0;
+        mutable int64 migrate_count = 0;
+
+    protected:
+
+        int64 GetWindowSize() const
+        {
+            return std::max<int64>(MIN_WINDOW, GetCount() / 4);
+        }
+
+        void ResetWindow() const
+        {
+            window_reads = 0;
+            window_writes = 0;
+        }
+
+        void MigrateTo(AdaptiveSetMode new_mode) const
+        {
+            if (mode == new_mode)
+                return;
+
+            if (new_mode == AdaptiveSetMode::Flat)
+            {
+                flat.AssignSorted(tree.begin(), tree.end());
+                tree.Free();
+            }
+            else
+            {
+                tree.AssignSorted(flat.begin(), flat.end());
+                flat.Free();
+            }
+
+            mode = new_mode;
+            ++migrate_count;
+            ResetWindow();
+        }
+
+        void EndWindow() const
+        {
+            if (mode == AdaptiveSetMode::Tree && window_writes * 16 <= window_reads)
+                MigrateTo(AdaptiveSetMode::Flat);
+            else
+                ResetWindow();
+        }
+
+        void OnRead() const
+        {
+            if (!auto_adapt)
+                return;
+
+            if (++window_reads + window_writes >= GetWindowSize())
+                EndWindow();
+        }
+
+        /**
+         * @param batch CN:Flat表示下的批量写入是线性合并，不促使转回Tree。EN:Batch writes on Flat are linear merges and do not push back to Tree.
+         */
+        void OnWrite(int64 count, bool batch = false) const
+        {
+            if (!auto_adapt || count <= 0)
+                return;
+
+            if (mode == AdaptiveSetMode::Flat)
+            {
+                if (batch)
+                    count = 1;
+
+                window_writes += count;
+
+                if (!batch && window_writes >= FLAT_WRITE_LIMIT && window_writes * 8 >= window_reads)
+                {
+                    MigrateTo(AdaptiveSetMode::Tree);
+                    return;
+                }
+            }
+            else
+            {
+                window_writes += count;
+            }
+
+            if (window_reads + window_writes >= GetWindowSize())
+                EndWindow();
+        }
+
+    public:
+        AdaptiveOrderedSet() = default;
+        virtual ~AdaptiveOrderedSet() = default;
+
+        // ==================== 表示切换 ====================
+
+        AdaptiveSetMode GetMode() const { return mode; }
+
+        /**
+         * @brief CN:指定表示（立即迁移）\nEN:Force a representation (migrates immediately)
+         */
+        void SetMode(AdaptiveSetMode new_mode) { MigrateTo(new_mode); }
+
+        /**
+         * @brief CN:结束写入阶段：转为平铺表示\nEN:End a write phase: switch to the flat representation
+         */
+        void Optimize()
+        {
+            MigrateTo(AdaptiveSetMode::Flat);
+        }
+
+        /**
+         * @brief CN:开启/关闭自动切换\nEN:Enable/disable automatic switching
+         */
+        void SetAutoAdapt(bool enable)
+        {
+            auto_adapt = enable;
+            ResetWindow();
+        }
+
+        bool IsAutoAdapt() const { return auto_adapt; }
+
+        /**
+         * @brief CN:表示切换的次数\nEN:Number of representation switches
+         */
+        int64 GetMigrateCount() const { return migrate_count; }
+
+        // ==================== 容量管理 ====================
+
+        int64 GetCount() const { return mode == AdaptiveSetMode::Flat ? flat.GetCount() : tree.GetCount(); }
+        bool IsEmpty() const { return GetCount() == 0; }
+
+        // ==================== 查找 ====================
+
+        /**
+         * @brief CN:检查是否包含元素\nEN:Check if contains element
+         */
+        bool Contains(const T& v) const
+        {
+            OnRead();
+            return mode == AdaptiveSetMode::Flat ? flat.Contains(v) : tree.Contains(v);
+        }
+
+        /**
+         * @brief CN:查找元素索引\nEN:Find element index
+         * @return 索引位置，未找到返回 -1
+         */
+        int64 FindIndex(const T& v) const
+        {
+            OnRead();
+            return mode == AdaptiveSetMode::Flat ? flat.FindIndex(v) : tree.FindIndex(v);
+        }
+
+        // ==================== 添加 ====================
+
+        /**
+         * @brief CN:添加一个元素\nEN:Add an element
+         * @return CN:添加成功返回true，已存在返回false。EN:True if added, false if it already exists.
+         */
+        bool Add(const T& value)
+        {
+            // OrderedSet::Add(value) 返回索引需要O(n)，这里用批量版本
+            const bool added = (mode == AdaptiveSetMode::Flat ? flat.Add(value) >= 0 : tree.Add(&value, 1) > 0);
+
+            if (added)
+                OnWrite(1);
+            else
+                OnRead();
+
+            return added;
+        }
+
+        /**
+         * @brief CN:批量添加元素\nEN:Add multiple elements
+         * @return 成功添加的元素个数
+         */
+        int64 Add(const T* dl, int64 count)
+        {
+            const int64 added = (mode == AdaptiveSetMode::Flat ? flat.AddBatch(dl, count) : tree.Add(dl, count));
+
+            OnWrite(added, true);
+            return added;
+        }
+
+        // ==================== 删除 ====================
+
+        /**
+         * @brief CN:删除指定元素\nEN:Delete specified element
+         */
+        bool Delete(const T& value)
+        {
+            const bool deleted = (mode == AdaptiveSetMode::Flat ? flat.Delete(value) : tree.Delete(value));
+
+            if (deleted)
+                OnWrite(1);
+            else
+                OnRead();
+
+            return deleted;
+        }
+
+        /**
+         * @brief CN:批量删除元素\nEN:Delete multiple elements
+         * @return 成功删除的元素个数
+         */
+        int64 Delete(const T* dp, int64 count)
+        {
+            const int64 deleted = (mode == AdaptiveSetMode::Flat ? flat.DeleteBatch(dp, count) : tree.Delete(dp, count));
+
+            OnWrite(deleted, true);
+            return deleted;
+        }
+
+        /**
+         * @brief CN:根据索引删除元素\nEN:Delete element at index
+         */
+        bool DeleteAt(int64 pos)
+        {
+            const bool deleted = (mode == AdaptiveSetMode::Flat ? flat.DeleteAt(pos) : tree.DeleteAt(pos));
+
+            if (deleted)
+                OnWrite(1);
+
+            return deleted;
+        }
+
+        /**
+         * @brief CN:清空所有元素\nEN:Clear all elements
+         */
+        void Clear()
+        {
+            tree.Clear();
+            flat.Clear();
+            ResetWindow();
+        }
+
+        /**
+         * @brief CN:清空所有元素并释放内存\nEN:Clear all elements and free memory
+         */
+        void Free()
+        {
+            tree.Free();
+            flat.Free();
+            ResetWindow();
+        }
+
+        // ==================== 获取数据 ====================
+
+        /**
+         * @brief CN:根据索引获取元素（Flat表示O(1)，Tree表示O(n)）\nEN:Get element by index (O(1) on Flat, O(n) on Tree)
+         */
+        bool Get(int64 index, T& value) const
+        {
+            OnRead();
+            return mode == AdaptiveSetMode::Flat ? flat.Get(index, value) : tree.Get(index, value);
+        }
+
+        bool GetFirst(T& value) const
+        {
+            return mode == AdaptiveSetMode::Flat ? flat.GetFirst(value) : tree.GetFirst(value);
+        }
+
+        bool GetLast(T& value) const
+        {
+            return mode == AdaptiveSetMode::Flat ? flat.GetLast(value) : tree.GetLast(value);
+        }
+
+        /**
+         * @brief CN:按升序枚举所有元素\nEN:Enumerate all elements in ascending order
+         * @param func CN:回调 func(const T &)。EN:Callback func(const T &).
+         */
+        template<typename F>
+        void Enum(F&& func) const
+        {
+            OnRead();
+
+            if (mode == AdaptiveSetMode::Flat)
+            {
+                for (const T& v : flat)
+                    func(v);
+            }
+            else
+            {
+                for (const T& v : tree)
+                    func(v);
+            }
+        }
+
+        // ==================== 运算符 ====================
+
+        bool operator==(const ThisClass& other) const
+        {
+            if (GetCount() != other.GetCount())
+                return false;
+
+            if (mode == AdaptiveSetMode::Flat && other.mode == AdaptiveSetMode::Flat)
+                return flat == other.flat;
+
+            if (mode == AdaptiveSetMode::Tree && other.mode == AdaptiveSetMode::Tree)
+                return tree == other.tree;
+
+            if (mode == AdaptiveSetMode::Flat)
+                return std::equal(flat.begin(), flat.end(), other.tree.begin());
+
+            return std::equal(tree.begin(), tree.end(), other.flat.begin());
+        }
+
+        bool operator!=(const ThisClass& other) const
+        {
+            return !operator==(other);
+        }
+    };//template<typename T> class AdaptiveOrderedSet
+}//namespace hgl
@@ -1,7 +1,8 @@
 ﻿#pragma once
 
 #include<hgl/type/FixedValuePool.h>
-#include<hgl/type/FlatOrderedSet.h>
+#include<hgl/type/OrderedSet.h>
+#include<vector>
 
 namespace hgl
 {
@@ -9,7 +10,9 @@ namespace hgl
      * 数据链管理器(注：它只管理这个链，并不管理数据)<br>
      * 它的思想是将空间分配成一个个固定长度的单位，然后通过链表来管理这些单位的使用情况。
      * 当用户释放一个空间时，会自动合并相邻的空间节点。如果没有相邻的空间节点，会自动创建一个新的空间节点。
-     * 当用户申请一个新的空间时，会自动查找最适合的空间节点。
+     * 当用户申请一个新的空间时，会自动查找最适合的空间节点。<br>
+     * 空闲段按(数量,起始位置)保存在有序树中，申请时O(log n)找到最小的足够空闲段(同样大小取最靠前的)；
+     * 每个空闲段的首尾块记录在边界标记数组中，释放时O(1)找到相邻空闲段并合并。
      */
     class BlockAllocator
     {
@@ -42,7 +45,7 @@ namespace hgl
 
         FixedValuePool<UserNode> ud_pool;    ///<用户数据占用信息池
 
-        FlatOrderedSet<UserNode *> ud_set;      ///<用户数据占用合集
+        std::vector<UserNode *> user_at;    ///<以起始块为下标的用户数据占用表(用于校验Release)
 
     public:
 
@@ -62,6 +65,18 @@ namespace hgl
             const int GetEnd()const{return start+count;}
         };//struct ChainNode
 
+        /**
+        * 空闲段排序键(先按数量，再按起始位置)
+        */
+        struct FreeRunKey
+        {
+            int count;
+            int start;
+
+            bool operator<(const FreeRunKey &rhs)const{return count!=rhs.count?count<rhs.count:start<rhs.start;}
+            bool operator==(const FreeRunKey &rhs)const{return count==rhs.count&&start==rhs.start;}
+        };
+
     private:
 
         FixedValuePool<ChainNode> node_pool; ///<链表节点池
@@ -70,6 +85,19 @@ namespace hgl
 
         ChainNode *start,*end;
 
+        OrderedSet<FreeRunKey> free_by_size;    ///<按大小排序的空闲段
+        OrderedSet<int> free_by_start;          ///<按起始位置排序的空闲段(用于插入链表时找前一个节点)
+
+        std::vector<ChainNode *> head_at;       ///<边界标记：以该块开始的空闲段
+        std::vector<ChainNode *> tail_at;       ///<边界标记：以该块结束的空闲段
+
+    private:
+
+        void AddFreeRun(ChainNode *);
+        void RemoveFreeRun(ChainNode *);
+        void LinkFreeRun(ChainNode *);
+        void UnlinkFreeRun(ChainNode *);
+
     public:
 
         const int GetMaxCount   ()const{return max_count;}
@@ -78,6 +106,21 @@ namespace hgl
         ChainNode *GetStartNode ()const{return start;}
         ChainNode *GetEndNode   ()const{return end;}
 
+    public: //碎片统计
+
+        const int GetFreeRunCount   ()const{return (int)free_by_size.GetCount();}                   ///<空闲段数量
+        const int GetLargestFreeRun ()const;                                                        ///<最大的空闲段长度
+
+        /**
+        * 外部碎片率：1-最大空闲段/空闲总数，0表示所有空闲块连续
+        */
+        const double GetExternalFragmentation()const;
+
+        /**
+        * 空闲段长度直方图，histogram[i]为长度在[2^i,2^(i+1))之间的空闲段数量
+        */
+        void GetFreeRunHistogram(std::vector<int> &histogram)const;
+
     public:
 
         BlockAllocator();
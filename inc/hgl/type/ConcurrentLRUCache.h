@@ -0,0 +1,450 @@
+﻿/**
+ * @file ConcurrentLRUCache.h
+ * @brief CN:线程安全的分片LRU缓存（每分片独立锁，支持TTL过期）
+ */
+#pragma once
+
+#include<hgl/type/LRUCache.h>
+#include<hgl/time/Time.h>
+#include<array>
+#include<atomic>
+#include<mutex>
+#include<vector>
+
+namespace hgl
+{
+    // AI NOTE: Thread-safe LRU cache split into SHARD_COUNT shards by key hash.
+    // Each shard is an LRUCache with its own mutex, recency list and capacity.
+    // Optional TTL (ms, GetUptimeMs based); batch lookups lock each shard once.
+    /**
+     * 【分片并发LRU缓存 ConcurrentLRUCache】
+     *
+     * 【原理】
+     * 按key的哈希高位把数据分到SHARD_COUNT个独立分片(默认16个)：
+     *  • 每个分片是一个独立的LRUCache，拥有自己的锁、最近使用链表和容量
+     *  • 不同分片的访问互不阻塞，读取吞吐量随核心数增长
+     *  • 总容量/总开销上限均分到各分片
+     *
+     * 【TTL过期】
+     *  • SetTimeToLive(ms)设置默认存活时间，0表示永不过期
+     *  • 时间基准为GetUptimeMs()，从Add时开始计时，Find不会刷新
+     *  • 过期数据在被Find/Get访问到时清除，也可调用RemoveExpired()主动清理
+     *
+     * 【批量查询】
+     *  • FindBatch会先按分片对key分组，每个分片只加锁一次
+     *
+     * 【注意】
+     *  • Create/Clear/GetCost回调在分片锁内执行，不要在回调中再访问本缓存
+     *  • 和LRUCache一样，析构时清除数据不会调用派生类重载的Clear回调，派生类需自行在析构中调用Clear()
+     */
+    template<typename F,typename T,int SHARD_COUNT=16> class ConcurrentLRUCache
+    {
+        static_assert((SHARD_COUNT & (SHARD_COUNT - 1)) == 0, "SHARD_COUNT must be power of two.");
+
+    public:
+
+        struct CacheValue
+        {
+            T value;                        ///<数据
+            uint64 expire_time;             ///<过期时间(GetUptimeMs时间基准，0表示永不过期)
+        };
+
+    protected:
+
+        using ThisClass=ConcurrentLRUCache<F,T,SHARD_COUNT>;
+
+        class Shard:public LRUCache<F,CacheValue>
+        {
+            using Base=LRUCache<F,CacheValue>;
+
+            ThisClass *owner=nullptr;
+
+        public:
+
+            std::mutex lock;
+
+        protected:
+
+            bool Create(const F &key,CacheValue &cv) override
+            {
+                if(!owner->Create(key,cv.value))
+                    return(false);
+
+                cv.expire_time=owner->MakeExpireTime(owner->time_to_live.load(std::memory_order_relaxed));
+                return(true);
+            }
+
+            void Clear(const F &key,CacheValue &cv) override
+            {
+                owner->Clear(key,cv.value);
+            }
+
+            int64 GetCost(const F &key,const CacheValue &cv) override
+            {
+                return owner->GetCost(key,cv.value);
+            }
+
+        public:
+
+            using Base::Clear;
+
+            Shard():Base(1){}
+
+            void SetOwner(ThisClass *o){owner=o;}
+
+            /**
+             * 查找数据节点，已过期的数据会被清除并视为不存在
+             */
+            typename Base::LruItem *FindItem(const F &key,const uint64 now,bool mts)
+            {
+                auto it=this->item_map.find(key);
+
+                if(it==this->item_map.end())
+                    return(nullptr);
+
+                typename Base::LruItem *item=it->second;
+
+                if(item->value.expire_time&&item->value.expire_time<=now)
+                {
+                    this->Delete(item);
+                    return(nullptr);
+                }
+
+                if(mts)
+                    this->MoveToStart(item);
+
+                return(item);
+            }
+
+            /**
+             * 清除所有已过期的数据
+             * @return 清除的数据数量
+             */
+            int RemoveExpired(const uint64 now)
+            {
+                int result=0;
+                typename Base::LruItem *item=this->start_item;
+
+                while(item)
+                {
+                    typename Base::LruItem *next=item->next;
+
+                    if(item->value.expire_time&&item->value.expire_time<=now)
+                    {
+                        this->Delete(item);
+                        ++result;
+                    }
+
+                    item=next;
+                }
+
+                return result;
+            }
+        };//class Shard
+
+        std::array<Shard,SHARD_COUNT> shards;
+
+        std::atomic<uint64> time_to_live;   ///<默认存活时间(毫秒，0表示永不过期)
+
+    protected:
+
+        virtual bool Create(const F &,T &){return false;}                                           ///<创建数据(Get时数据不存在会调用)
+        virtual void Clear(const F &,T &){}                                                         ///<清除数据
+        virtual int64 GetCost(const F &,const T &){return 1;}                                       ///<计算数据开销
+
+        int GetShardIndex(const F &key) const
+        {
+            const uint64 hash=ankerl::unordered_dense::hash<F>{}(key)*0x9E3779B97F4A7C15ull;     //再混合一次，避免弱哈希(如整数恒等哈希)高位全为0
+
+            return (int)((hash >> 32) & (SHARD_COUNT - 1));        //低位留给分片内的哈希表使用
+        }
+
+        Shard &GetShard(const F &key){return shards[GetShardIndex(key)];}
+
+        static uint64 MakeExpireTime(const uint64 ttl)
+        {
+            return ttl?GetUptimeMs()+ttl:0;
+        }
+
+    public:
+
+        /**
+         * @param max_count 缓存最大数据量(均分到各分片)
+         * @param max_cost 缓存最大总开销(均分到各分片，<=0表示不按开销淘汰)
+         * @param ttl 默认存活时间(毫秒，0表示永不过期)
+         */
+        ConcurrentLRUCache(int max_count,int64 max_cost=0,uint64 ttl=0)
+        {
+            time_to_live.store(ttl,std::memory_order_relaxed);
+
+            for(Shard &shard:shards)
+                shard.SetOwner(this);
+
+            Realloc(max_count);
+            SetMaxCost(max_cost);
+        }
+
+        virtual ~ConcurrentLRUCache()
+        {
+            Clear();
+        }
+
+        ConcurrentLRUCache(const ConcurrentLRUCache &)=delete;
+        ConcurrentLRUCache &operator=(const ConcurrentLRUCache &)=delete;
+
+        // ==================== 配置 ====================
+
+        /**
+         * 设置缓存总容量(均分到各分片，每个分片至少1个)
+         */
+        void Realloc(int max_count)
+        {
+            int per=(max_count+SHARD_COUNT-1)/SHARD_COUNT;
+
+            if(per<1)per=1;
+
+            for(Shard &shard:shards)
+            {
+                std::lock_guard<std::mutex> lg(shard.lock);
+                shard.Realloc(per);
+            }
+        }
+
+        /**
+         * 设置缓存总开销上限(均分到各分片，<=0表示不限制)
+         */
+        void SetMaxCost(int64 max_cost)
+        {
+            const int64 per=max_cost>0?(max_cost+SHARD_COUNT-1)/SHARD_COUNT:0;
+
+            for(Shard &shard:shards)
+            {
+                std::lock_guard<std::mutex> lg(shard.lock);
+                shard.SetMaxCost(per);
+            }
+        }
+
+        void    SetTimeToLive(uint64 ttl){time_to_live.store(ttl,std::memory_order_relaxed);}       ///<设置默认存活时间(毫秒，0表示永不过期，仅影响之后加入的数据)
+        uint64  GetTimeToLive()const{return time_to_live.load(std::memory_order_relaxed);}      ///<取得默认存活时间(毫秒)
+
+        constexpr int GetShardCount()const{return SHARD_COUNT;}                                     ///<取得分片数量
+
+        // ==================== 统计 ====================
+
+        int GetCount()
+        {
+            int total=0;
+
+            for(Shard &shard:shards)
+            {
+                std::lock_guard<std::mutex> lg(shard.lock);
+                total+=shard.GetCount();
+            }
+
+            return total;
+        }
+
+        int64 GetTotalCost()
+        {
+            int64 total=0;
+
+            for(Shard &shard:shards)
+            {
+                std::lock_guard<std::mutex> lg(shard.lock);
+                total+=shard.GetTotalCost();
+            }
+
+            return total;
+        }
+
+        // ==================== 访问 ====================
+
+        /**
+         * 增加一个数据(key已存在则替换)
+         * @param key 数据标识
+         * @param value 数据
+         */
+        void Add(const F &key,const T &value)
+        {
+            Add(key,value,time_to_live.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * 增加一个数据，并指定其存活时间
+         * @param ttl 存活时间(毫秒，0表示永不过期)
+         */
+        void Add(const F &key,const T &value,uint64 ttl)
+        {
+            Shard &shard=GetShard(key);
+
+            const CacheValue cv{value,MakeExpireTime(ttl)};
+
+            std::lock_guard<std::mutex> lg(shard.lock);
+            shard.Add(key,cv);
+        }
+
+        /**
+         * 取得一个数据(如果没有不会自动创建)
+         * @param mts 是否将数据移到最近使用位置
+         */
+        bool Find(const F &key,T &value,bool mts=true)
+        {
+            Shard &shard=GetShard(key);
+            const uint64 now=GetUptimeMs();
+
+            std::lock_guard<std::mutex> lg(shard.lock);
+
+            auto *item=shard.FindItem(key,now,mts);
+
+            if(!item)
+                return(false);
+
+            value=item->value.value;
+            return(true);
+        }
+
+        /**
+         * 取得一个数据(如果没有会调用Create创建，Create在分片锁内执行)
+         */
+        bool Get(const F &key,T &value,bool mts=true)
+        {
+            Shard &shard=GetShard(key);
+            const uint64 now=GetUptimeMs();
+
+            std::lock_guard<std::mutex> lg(shard.lock);
+
+            auto *item=shard.FindItem(key,now,mts);
+
+            if(item)
+            {
+                value=item->value.value;
+                return(true);
+            }
+
+            CacheValue cv;
+
+            if(!shard.Get(key,cv,mts))
+                return(false);
+
+            value=cv.value;
+            return(true);
+        }
+
+        bool Contains(const F &key)
+        {
+            Shard &shard=GetShard(key);
+            const uint64 now=GetUptimeMs();
+
+            std::lock_guard<std::mutex> lg(shard.lock);
+
+            return shard.FindItem(key,now,false);
+        }
+
+        /**
+         * 批量查找数据，每个分片只加锁一次
+         * @param keys 数据标识列表
+         * @param values 数据存放地(未找到的项不修改)
+         * @param found 每项是否找到(可为nullptr)
+         * @param count 数量
+         * @param mts 是否将数据移到最近使用位置
+         * @return 找到的数量
+         */
+        int FindBatch(const F *keys,T *values,bool *found,const int count,bool mts=true)
+        {
+            if(!keys||!values||count<=0)
+                return 0;
+
+            // 按分片做计数排序，得到分组后的下标列表
+            std::array<int,SHARD_COUNT+1> offset{};
+            std::vector<int> shard_of(count);
+            std::vector<int> order(count);
+
+            for(int i=0;i<count;i++)
+            {
+                shard_of[i]=GetShardIndex(keys[i]);
+                ++offset[shard_of[i]+1];
+            }
+
+            for(int s=0;s<SHARD_COUNT;s++)
+                offset[s+1]+=offset[s];
+
+            {
+                std::array<int,SHARD_COUNT> pos;
+
+                for(int s=0;s<SHARD_COUNT;s++)
+                    pos[s]=offset[s];
+
+                for(int i=0;i<count;i++)
+                    order[pos[shard_of[i]]++]=i;
+            }
+
+            const uint64 now=GetUptimeMs();
+            int result=0;
+
+            for(int s=0;s<SHARD_COUNT;s++)
+            {
+                if(offset[s]==offset[s+1])
+                    continue;
+
+                Shard &shard=shards[s];
+
+                std::lock_guard<std::mutex> lg(shard.lock);
+
+                for(int p=offset[s];p<offset[s+1];p++)
+                {
+                    const int i=order[p];
+
+                    auto *item=shard.FindItem(keys[i],now,mts);
+
+                    if(item)
+                    {
+                        values[i]=item->value.value;
+                        ++result;
+                    }
+
+                    if(found)
+                        found[i]=(item!=nullptr);
+                }
+            }
+
+            return result;
+        }
+
+        // ==================== 删除 ====================
+
+        void DeleteByKey(const F &key)
+        {
+            Shard &shard=GetShard(key);
+
+            std::lock_guard<std::mutex> lg(shard.lock);
+            shard.DeleteByKey(key);
+        }
+
+        /**
+         * 清除所有已过期的数据
+         * @return 清除的数据数量
+         */
+        int RemoveExpired()
+        {
+            const uint64 now=GetUptimeMs();
+            int result=0;
+
+            for(Shard &shard:shards)
+            {
+                std::lock_guard<std::mutex> lg(shard.lock);
+                result+=shard.RemoveExpired(now);
+            }
+
+            return result;
+        }
+
+        void Clear()
+        {
+            for(Shard &shard:shards)
+            {
+                std::lock_guard<std::mutex> lg(shard.lock);
+                shard.Clear();
+            }
+        }
+    };//template<typename F,typename T,int SHARD_COUNT> class ConcurrentLRUCache
+}//namespace hgl
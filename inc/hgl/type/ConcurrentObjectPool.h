@@ -0,0 +1,214 @@
+﻿/**
+ * @file ConcurrentObjectPool.h
+ * @brief CN:带线程缓存的并发对象池(FixedValuePool/PointerObjectPool的多线程版本)
+ */
+#pragma once
+
+#include<hgl/type/MagazineDepot.h>
+#include<hgl/type/Stack.h>
+
+namespace hgl
+{
+    // AI NOTE: Thread-safe counterpart of FixedValuePool built on MagazineDepot.
+    // Slots are handed out from a bump index the first time and afterwards
+    // circulate through per-thread magazines and the shared depot.
+    /**
+     * 并发固定大小值池<br>
+     * 与 FixedValuePool 用法相同，但 Acquire/Release 可以在任意线程调用，无需外部加锁。
+     * 每个线程有自己的弹匣缓存，大部分操作不访问共享数据，详见 MagazineDepot。
+     *
+     * @note 不做重复释放检测；某线程缓存中的空闲对象其它线程暂时取不到，
+     *       所以池的有效容量会少于max_count，最坏情况下每个线程缓存可滞留2*MAGAZINE_SIZE个对象
+     *
+     * @tparam T 值类型(trivial类型)
+     * @tparam MAGAZINE_SIZE 单个弹匣的容量
+     */
+    template<typename T,int MAGAZINE_SIZE=32> class ConcurrentFixedValuePool:public MagazineDepot<T,MAGAZINE_SIZE>
+    {
+    protected:
+
+        T *data_array=nullptr;              ///<数据区
+        T *end=nullptr;                     ///<结束指针
+        int max_count=0;
+        int next_unused=0;                  ///<从未分配过的第一个位置(仓库锁内访问)
+
+        int FillFromSource(T **items,int count) override
+        {
+            if(count>max_count-next_unused)
+                count=max_count-next_unused;
+
+            for(int i=0;i<count;i++)
+                items[i]=data_array+next_unused+count-1-i;          //倒序放入，弹出时地址递增
+
+            next_unused+=count;
+            return count;
+        }
+
+    public:
+
+        T *GetRawData()const{return data_array;}                    ///<取得原始数据指针
+        int GetMaxCount()const{return max_count;}                   ///<取得最大数量
+
+    public:
+
+        ConcurrentFixedValuePool()=default;
+
+        ~ConcurrentFixedValuePool()
+        {
+            delete[] data_array;
+        }
+
+        /**
+         * 初始化对象池，需在其它线程开始访问前调用
+         * @param count 最大对象数量
+         */
+        bool Init(const int count)
+        {
+            if(data_array||count<=0)
+                return(false);
+
+            data_array=new T[count]();
+            end=data_array+count;
+            max_count=count;
+            next_unused=0;
+            return(true);
+        }
+
+        /**
+         * 从池中获取一个对象
+         * @return 对象指针，如果池已满返回 nullptr
+         */
+        T *Acquire()
+        {
+            if(!data_array)
+                return(nullptr);
+
+            return this->AcquireFromCache();
+        }
+
+        /**
+         * 将对象归还到池中(可以由任意线程归还)
+         */
+        bool Release(T *obj)
+        {
+            if(!obj)
+                return(false);
+
+            if(obj<data_array||obj>=end)
+                return(false);
+
+            this->ReleaseToCache(obj);
+            return(true);
+        }
+
+        /**
+         * 取得空闲对象数量(包含各线程缓存，多线程访问时为近似值)
+         */
+        int GetIdleCount()
+        {
+            int unused;
+
+            {
+                std::lock_guard<std::mutex> lg(this->lock);
+                unused=max_count-next_unused;
+            }
+
+            return unused+this->GetDepotIdleCount()+this->GetCachedIdleCount();
+        }
+    };//template<typename T,int MAGAZINE_SIZE> class ConcurrentFixedValuePool
+
+    // AI NOTE: Thread-safe counterpart of PointerObjectPool built on MagazineDepot.
+    // AddObject feeds a locked source stack; magazines are filled from it.
+    /**
+     * 并发指针对象池<br>
+     * 与 PointerObjectPool 用法相同，但 AddObject/Acquire/Release 可以在任意线程调用，无需外部加锁。
+     * 析构时删除池中所有闲置对象(包括各线程缓存中的)。
+     *
+     * @tparam T 对象类型(非指针)
+     * @tparam MAGAZINE_SIZE 单个弹匣的容量
+     */
+    template<typename T,int MAGAZINE_SIZE=32> class ConcurrentPointerObjectPool:public MagazineDepot<T,MAGAZINE_SIZE>
+    {
+    protected:
+
+        Stack<T *> idle_objects;            ///<尚未进入弹匣的闲置对象(仓库锁内访问)
+
+        int FillFromSource(T **items,int count) override
+        {
+            int n=0;
+
+            while(n<count&&idle_objects.Pop(items[n]))
+                ++n;
+
+            return n;
+        }
+
+    public:
+
+        ConcurrentPointerObjectPool()=default;
+
+        ~ConcurrentPointerObjectPool()
+        {
+            T *obj;
+
+            while(idle_objects.Pop(obj))
+                delete obj;
+
+            this->EnumIdle([](T *p){delete p;});
+        }
+
+        bool Init()
+        {
+            return(true);
+        }
+
+        /**
+         * 添加对象到池中
+         * @param obj 对象指针（由用户创建，带有合适的参数）
+         */
+        bool AddObject(T *obj)
+        {
+            if(!obj)
+                return(false);
+
+            std::lock_guard<std::mutex> lg(this->lock);
+            return idle_objects.Push(obj);
+        }
+
+        /**
+         * 从池中获取一个对象
+         * @return 对象指针，池中(及本线程缓存中)没有闲置对象时返回 nullptr
+         */
+        T *Acquire()
+        {
+            return this->AcquireFromCache();
+        }
+
+        /**
+         * 将对象归还到池中(可以由任意线程归还)
+         */
+        bool Release(T *obj)
+        {
+            if(!obj)
+                return(false);
+
+            this->ReleaseToCache(obj);
+            return(true);
+        }
+
+        /**
+         * 取得闲置对象数量(包含各线程缓存，多线程访问时为近似值)
+         */
+        int GetIdleCount()
+        {
+            int source;
+
+            {
+                std::lock_guard<std::mutex> lg(this->lock);
+                source=idle_objects.GetCount();
+            }
+
+            return source+this->GetDepotIdleCount()+this->GetCachedIdleCount();
+        }
+    };//template<typename T,int MAGAZINE_SIZE> class ConcurrentPointerObjectPool
+}//namespace hgl
@@ -7,6 +7,11 @@
 #include <type_traits>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <hgl/util/hash/QuickHash.h>
 #include <hgl/type/ActiveDataManager.h>
 #include <ankerl/unordered_dense.h>
@@ -16,6 +21,8 @@ namespace hgl
     // AI NOTE: Hash set with two hash maps to support incremental rebuild/GC.
     // Deletes mark ids inactive; rebuild compacts maps in batches to avoid stalls.
     // ActiveDataManager owns the contiguous values.
+    // Optional background mode: a helper thread builds the new map from a
+    // snapshot; the foreground journals changes and replays them on swap.
     /**
      * 【双哈希表集合 DualHashSet】
      *
@@ -28,7 +35,16 @@ namespace hgl
      *  1. 在StartRebuild()时创建重建表
      *  2. 每次Add/Delete时调用StepRebuild(batch)进行增量处理，默认批次128个元素
      *  3. 无需等待GC完成，可继续Add/Delete操作
-     *  4. 重建完成后，合并旧表剩余数据到新表，然后交换
+     *  4. 扫描过程中新增的元素，仅当其ID位于已扫描区间时才加入重建表(未扫描区间稍后会被扫描到)
+     *  5. 扫描完成后重建表即为完整的新表，直接交换
+     *
+     * 【后台重建】SetBackgroundRebuild(true)
+     *  • 触发重建时复制一份(ID,值)快照，由辅助线程在快照上计算哈希并构建新表，前台线程不参与构建
+     *  • 构建期间前台照常维护活跃表，同时把增/删/压缩搬移记录到变更日志
+     *  • 前台在下一次Add/Delete/CompactStep时发现新表已完成，回放变更日志后与活跃表交换
+     *  • 交换下来的旧表交还辅助线程释放
+     *  • 前台只承担一次快照复制(无哈希计算)与日志回放，其余Add/Delete的延迟与重建规模无关
+     *  • Clear/Free/Compact/RefreshHashMap/析构会取消并等待进行中的后台重建
      *
      * 【特点】
      *  • 无停顿垃圾回收 - GC不会导致性能突变
@@ -51,6 +67,8 @@ namespace hgl
      * 【配置】
      *  • SetRebuildThreshold(n): 何时触发重建（删除计数达到n）
      *  • SetRebuildBatch(n): 每步处理元素数（越大GC越快，可能有延迟峰值）
+     *  • SetBackgroundRebuild(b): 在辅助线程上重建(仅当T可平凡复制时)
+     *  • Compact()/CompactStep(n): 压缩数据存储，回收已删除元素占用的空洞
      */
     template<typename T>
     class DualHashSet
@@ -69,6 +87,51 @@ namespace hgl
         int deleted_count = 0;
         int rebuild_threshold = 1024;
 
+        /**
+         * 后台重建期间记录的变更
+         */
+        struct RebuildChange
+        {
+            enum class Op
+            {
+                Add,
+                Delete,
+                Remap,
+            };
+
+            Op op;
+            uint64 hash;
+            int id;
+            int new_id;             ///<仅Remap使用
+        };
+
+        /**
+         * 后台重建状态，快照与result只由辅助线程访问，直到done为true
+         */
+        struct BackgroundRebuild
+        {
+            std::vector<int> snapshot_ids;
+            std::vector<T> snapshot_values;
+
+            HashMap result;
+            HashMap retired;                        ///<交换下来的旧表，交给辅助线程释放
+
+            std::atomic<bool> done{false};
+            std::atomic<bool> cancel{false};
+
+            std::mutex mutex;
+            std::condition_variable cv;
+            bool published = false;                 ///<前台已交换，受mutex保护
+
+            std::thread worker;
+
+            std::vector<RebuildChange> changes;     ///<前台记录的快照之后的变更
+        };
+
+        bool use_background_rebuild = false;
+        std::unique_ptr<BackgroundRebuild> background;      ///<进行中的后台重建
+        std::unique_ptr<BackgroundRebuild> retiring;        ///<已交换，辅助线程正在释放旧表
+
         int FindIDInMap(const HashMap &map, const T &value) const
         {
             uint64 hash = ComputeOptimalHash(value);
@@ -111,9 +174,7 @@ namespace hgl
             if (!is_rebuilding)
                 return;
 
-            auto active_ids = data_manager.GetActiveView();
-            const int total = (int)active_ids.size();
-            if (total == 0)
+            if (data_manager.GetActiveCount() == 0)
             {
                 hash_map_active.clear();
                 hash_map_rebuilding.clear();
@@ -122,47 +183,25 @@ namespace hgl
                 return;
             }
 
-            int end = rebuild_progress + batch;
-            if (end > total)
-                end = total;
+            // rebuild_progress 为下一个待扫描的ID，直接按活跃位图前进
+            int id = data_manager.FindNextActive(rebuild_progress);
 
-            for (int i = rebuild_progress; i < end; i++)
+            for (int n = 0; id != -1 && n < batch; n++)
             {
-                int id = active_ids[i];
-                if (!data_manager.IsActive(id))
-                    continue;
                 T *ptr = data_manager.At(id);
-                if (!ptr)
-                    continue;
-                uint64 hash = ComputeOptimalHash(*ptr);
-                hash_map_rebuilding[hash].push_back(id);
-            }
-
-            rebuild_progress = end;
-            if (rebuild_progress >= total)
-            {
-                // 重建完成：清理旧表中的失效ID，然后交换
-                for (auto it = hash_map_active.begin(); it != hash_map_active.end(); )
+                if (ptr)
                 {
-                    auto &id_list = it->second;
-                    id_list.erase(
-                        std::remove_if(id_list.begin(), id_list.end(),
-                            [this](int id) { return !data_manager.IsActive(id); }),
-                        id_list.end()
-                    );
-                    if (id_list.empty())
-                        it = hash_map_active.erase(it);
-                    else
-                        ++it;
+                    uint64 hash = ComputeOptimalHash(*ptr);
+                    hash_map_rebuilding[hash].push_back(id);
                 }
 
-                // 合并：把旧表中剩余的有效ID添加到新表
-                for (auto &pair : hash_map_active)
-                {
-                    for (int id : pair.second)
-                        hash_map_rebuilding[pair.first].push_back(id);
-                }
+                id = data_manager.FindNextActive(id + 1);
+            }
 
+            rebuild_progress = id;
+            if (rebuild_progress == -1)
+            {
+                // 重建完成：扫描期间的增删已同步到重建表，它已包含所有有效ID且无重复，直接交换
                 hash_map_active = std::move(hash_map_rebuilding);
                 hash_map_rebuilding.clear();
                 is_rebuilding = false;
@@ -171,17 +210,225 @@ namespace hgl
             }
         }
 
+        void RemapHashMap(HashMap &map, const std::vector<ActiveIDRemap> &moved)
+        {
+            for (const ActiveIDRemap &m : moved)
+            {
+                auto it = map.find(ComputeOptimalHash(*data_manager.At(m.new_id)));
+                if (it == map.end())
+                    continue;
+
+                for (int &id : it->second)
+                {
+                    if (id == m.old_id)
+                    {
+                        id = m.new_id;
+                        break;
+                    }
+                }
+            }
+        }
+
+        /**
+         * 该ID是否已被渐进重建扫描过(扫描过的ID的增删需同步到重建表)
+         */
+        bool IsRebuildScanned(int id) const
+        {
+            return is_rebuilding && rebuild_progress != -1 && id < rebuild_progress;
+        }
+
+        static void EraseFromMap(HashMap &map, uint64 hash, int id)
+        {
+            auto it = map.find(hash);
+            if (it == map.end())
+                return;
+
+            auto &id_list = it->second;
+            id_list.erase(
+                std::remove(id_list.begin(), id_list.end(), id),
+                id_list.end()
+            );
+            if (id_list.empty())
+                map.erase(it);
+        }
+
+        /**
+         * 后台重建线程：在快照上构建新表
+         */
+        static void BackgroundRebuildProc(BackgroundRebuild *br)
+        {
+            const int count = (int)br->snapshot_ids.size();
+
+            br->result.reserve(count);
+
+            for (int i = 0; i < count; i++)
+            {
+                if ((i & 1023) == 0 && br->cancel.load(std::memory_order_relaxed))
+                    break;
+
+                br->result[ComputeOptimalHash(br->snapshot_values[i])].push_back(br->snapshot_ids[i]);
+            }
+
+            br->snapshot_ids = std::vector<int>();
+            br->snapshot_values = std::vector<T>();
+
+            br->done.store(true, std::memory_order_release);
+
+            // 等待前台交换，然后在本线程释放旧表(大量小块内存，释放耗时与表大小成正比)
+            std::unique_lock<std::mutex> lock(br->mutex);
+            br->cv.wait(lock, [br]() { return br->published || br->cancel.load(std::memory_order_relaxed); });
+            lock.unlock();
+
+            br->retired = HashMap();
+        }
+
+        void JoinRetiring()
+        {
+            if (!retiring)
+                return;
+
+            retiring->worker.join();
+            retiring.reset();
+        }
+
+        void StartBackgroundRebuild()
+        {
+            JoinRetiring();
+
+            background = std::make_unique<BackgroundRebuild>();
+
+            // 快照只复制ID和值，哈希计算和建表都在辅助线程上进行
+            const int count = data_manager.GetActiveCount();
+
+            background->snapshot_ids.reserve(count);
+            background->snapshot_values.reserve(count);
+
+            BackgroundRebuild *br = background.get();
+
+            data_manager.ForEachActive([br](int id, const T &value)
+            {
+                br->snapshot_ids.push_back(id);
+                br->snapshot_values.push_back(value);
+            });
+
+            background->worker = std::thread(BackgroundRebuildProc, br);
+
+            deleted_count = 0;
+        }
+
+        void RecordChange(typename RebuildChange::Op op, uint64 hash, int id, int new_id = -1)
+        {
+            if (background)
+                background->changes.push_back({op, hash, id, new_id});
+        }
+
+        /**
+         * 后台重建已完成则回放变更日志并交换(前台调用)
+         */
+        void TryPublishBackgroundRebuild()
+        {
+            if (!background || !background->done.load(std::memory_order_acquire))
+                return;
+
+            HashMap &map = background->result;
+
+            for (const RebuildChange &c : background->changes)
+            {
+                switch (c.op)
+                {
+                    case RebuildChange::Op::Add:
+                        map[c.hash].push_back(c.id);
+                        break;
+
+                    case RebuildChange::Op::Delete:
+                        EraseFromMap(map, c.hash, c.id);
+                        break;
+
+                    case RebuildChange::Op::Remap:
+                    {
+                        auto it = map.find(c.hash);
+                        if (it == map.end())
+                            break;
+
+                        for (int &id : it->second)
+                        {
+                            if (id == c.id)
+                            {
+                                id = c.new_id;
+                                break;
+                            }
+                        }
+                        break;
+                    }
+                }
+            }
+
+            background->retired = std::move(hash_map_active);
+            hash_map_active = std::move(map);
+            background->changes = std::vector<RebuildChange>();
+
+            {
+                std::lock_guard<std::mutex> lock(background->mutex);
+                background->published = true;
+            }
+
+            background->cv.notify_one();
+
+            retiring = std::move(background);       // 辅助线程释放完旧表后退出，下次启动或析构时join
+        }
+
+        /**
+         * 取消并等待后台重建
+         */
+        void AbortBackgroundRebuild()
+        {
+            JoinRetiring();
+
+            if (!background)
+                return;
+
+            {
+                std::lock_guard<std::mutex> lock(background->mutex);
+                background->cancel.store(true, std::memory_order_relaxed);
+            }
+
+            background->cv.notify_one();
+            background->worker.join();
+            background.reset();
+        }
+
         void MaybeRebuild()
         {
+            if (background)
+            {
+                TryPublishBackgroundRebuild();
+                return;
+            }
+
             if (!is_rebuilding && deleted_count >= rebuild_threshold)
+            {
+                if constexpr (std::is_trivially_copyable_v<T>)
+                {
+                    if (use_background_rebuild)
+                    {
+                        StartBackgroundRebuild();
+                        return;
+                    }
+                }
+
                 StartRebuild();
+            }
 
             StepRebuild(rebuild_batch);
         }
 
     public:
         DualHashSet() = default;
-        virtual ~DualHashSet() = default;
+
+        virtual ~DualHashSet()
+        {
+            AbortBackgroundRebuild();
+        }
 
         void Reserve(int capacity)
         {
@@ -208,6 +455,47 @@ namespace hgl
             rebuild_batch = batch > 0 ? batch : 1;
         }
 
+        /**
+         * 设置是否在辅助线程上重建哈希表
+         * 关闭时会等待进行中的后台重建结束并丢弃其结果
+         */
+        void SetBackgroundRebuild(bool enable)
+        {
+            if (!enable)
+                AbortBackgroundRebuild();
+            else if (is_rebuilding)
+                RefreshHashMap();               // 先完成进行中的渐进重建
+
+            use_background_rebuild = enable;
+        }
+
+        bool IsBackgroundRebuild() const
+        {
+            return use_background_rebuild;
+        }
+
+        /**
+         * 是否有进行中的重建(渐进或后台)
+         */
+        bool IsRebuilding() const
+        {
+            return is_rebuilding || background != nullptr;
+        }
+
+        /**
+         * 等待进行中的后台重建完成并立即交换
+         */
+        void WaitRebuild()
+        {
+            if (!background)
+                return;
+
+            while (!background->done.load(std::memory_order_acquire))
+                std::this_thread::yield();
+
+            TryPublishBackgroundRebuild();
+        }
+
         bool Add(const T &value)
         {
             static_assert(std::is_trivially_copyable_v<T>, "Add() requires trivially copyable types.");
@@ -228,10 +516,12 @@ namespace hgl
             uint64 hash = ComputeOptimalHash(value);
             hash_map_active[hash].push_back(new_id);
 
-            // 如果正在重建，也要添加到重建表中
-            if (is_rebuilding)
+            // 如果正在重建且该ID已被扫描过，也要添加到重建表中(未扫描的ID稍后会被扫描到)
+            if (IsRebuildScanned(new_id))
                 hash_map_rebuilding[hash].push_back(new_id);
 
+            RecordChange(RebuildChange::Op::Add, hash, new_id);
+
             // 在添加后推进重建
             MaybeRebuild();
 
@@ -249,35 +539,14 @@ namespace hgl
                 ++deleted_count;
 
                 // 从哈希表中移除（避免查找失效的ID）
-                // 先从活跃表移除
                 uint64 hash = ComputeOptimalHash(value);
-                auto it = hash_map_active.find(hash);
-                if (it != hash_map_active.end())
-                {
-                    auto &id_list = it->second;
-                    id_list.erase(
-                        std::remove(id_list.begin(), id_list.end(), id),
-                        id_list.end()
-                    );
-                    if (id_list.empty())
-                        hash_map_active.erase(it);
-                }
+                EraseFromMap(hash_map_active, hash, id);
 
                 // 如果正在重建，也从重建表移除
                 if (is_rebuilding)
-                {
-                    auto it2 = hash_map_rebuilding.find(hash);
-                    if (it2 != hash_map_rebuilding.end())
-                    {
-                        auto &id_list = it2->second;
-                        id_list.erase(
-                            std::remove(id_list.begin(), id_list.end(), id),
-                            id_list.end()
-                        );
-                        if (id_list.empty())
-                            hash_map_rebuilding.erase(it2);
-                    }
-                }
+                    EraseFromMap(hash_map_rebuilding, hash, id);
+
+                RecordChange(RebuildChange::Op::Delete, hash, id);
 
                 // 在删除后推进重建
                 MaybeRebuild();
@@ -295,6 +564,7 @@ namespace hgl
 
         void Clear()
         {
+            AbortBackgroundRebuild();
             data_manager.Clear();
             hash_map_active.clear();
             hash_map_rebuilding.clear();
@@ -305,6 +575,7 @@ namespace hgl
 
         void Free()
         {
+            AbortBackgroundRebuild();
             data_manager.Free();
             hash_map_active.clear();
             hash_map_rebuilding.clear();
@@ -316,23 +587,82 @@ namespace hgl
         template<typename F>
         void Enum(F &&func) const
         {
-            auto active_ids = data_manager.GetActiveView();
-            const int count = (int)active_ids.size();
-
-            for (int i = 0; i < count; i++)
+            data_manager.ForEachActive([&func](int, const T &value)
             {
-                int id = active_ids[i];
-                T value;
-                if (data_manager.GetData(value, id))
-                    func(value);
-            }
+                func(value);
+            });
         }
 
         void RefreshHashMap()
         {
+            AbortBackgroundRebuild();
             StartRebuild();
             while (is_rebuilding)
                 StepRebuild(rebuild_batch);
         }
+
+        /**
+         * 完整压缩：数据稠密排列到[0,GetCount())，并直接重建活跃表(中止进行中的渐进重建)
+         * @return 搬移的元素数量
+         */
+        int Compact()
+        {
+            AbortBackgroundRebuild();
+
+            const int result = data_manager.Compact();
+
+            hash_map_active.clear();
+            hash_map_rebuilding.clear();
+            is_rebuilding = false;
+            rebuild_progress = 0;
+            deleted_count = 0;
+
+            HashMap &map = hash_map_active;
+
+            data_manager.ForEachActive([&map](int id, const T &value)
+            {
+                map[ComputeOptimalHash(value)].push_back(id);
+            });
+
+            return result;
+        }
+
+        /**
+         * 增量压缩：最多搬移max_move个元素，并就地更新活跃表和重建表中的ID
+         * @return 本次搬移的元素数量
+         */
+        int CompactStep(int max_move)
+        {
+            std::vector<ActiveIDRemap> moved;
+
+            const int result = data_manager.CompactStep(max_move, &moved);
+
+            RemapHashMap(hash_map_active, moved);
+
+            if (is_rebuilding)
+            {
+                RemapHashMap(hash_map_rebuilding, moved);
+
+                // 从未扫描区间搬到已扫描区间的元素不会再被扫描到，需直接加入重建表
+                for (const ActiveIDRemap &m : moved)
+                    if (IsRebuildScanned(m.new_id) && !IsRebuildScanned(m.old_id))
+                        hash_map_rebuilding[ComputeOptimalHash(*data_manager.At(m.new_id))].push_back(m.new_id);
+            }
+
+            if (background)
+            {
+                for (const ActiveIDRemap &m : moved)
+                    RecordChange(RebuildChange::Op::Remap, ComputeOptimalHash(*data_manager.At(m.new_id)), m.old_id, m.new_id);
+
+                TryPublishBackgroundRebuild();
+            }
+
+            return result;
+        }
+
+        bool IsCompact() const
+        {
+            return data_manager.IsCompact();
+        }
     };
 }
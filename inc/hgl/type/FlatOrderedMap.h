@@ -8,9 +8,20 @@
 #include<vector>
 #include<algorithm>
 #include<hgl/type/DataType.h>
+#include<hgl/type/RadixSort.h>
+#include<hgl/type/SortedSearchIndex.h>
 
 namespace hgl
 {
+    /**
+    * @brief CN:批量添加时重复键的处理策略\nEN:How batch insertion resolves duplicate keys
+    */
+    enum class BatchDuplicatePolicy
+    {
+        KeepFirst,      ///<CN:保留已有值；批内重复键保留第一个。EN:Keep the existing value; first occurrence wins within the batch.
+        KeepLast,       ///<CN:用新值覆盖已有值；批内重复键保留最后一个。EN:Overwrite existing value; last occurrence wins within the batch.
+    };
+
     // AI NOTE: Ordered key/value map backed by two aligned vectors.
     // Keys stay sorted; values follow the same index. Lookup O(log n),
     // insert/erase O(n). Iterators/pointers invalidate on insert/erase.
@@ -27,13 +38,14 @@ namespace hgl
     *
     * 使用场景：
     * - 需要序列化/反序列化整个容器（直接SAVE/LOAD两个数组）
-    * - 大量查询操作，偶尔修改
+    * - 大量查询操作，偶尔修改（可Freeze()建立查找索引）
     * - 配置文件、资源索引、静态数据表
     *
     * 性能特征：
-    * - 查找：O(log n)（二分搜索）
+    * - 查找：O(log n)（二分搜索；冻结后使用16键B+树索引，每层只访问一个节点）
     * - 插入：O(n)（需要维护有序性）
     * - 删除：O(n)（需要移动元素）
+    * - 批量添加/删除（AddBatch/DeleteBatch/BuildFrom）：排序去重（整数键使用基数排序）后一次线性合并，O(n+m)
     * - 序列化：O(n)，支持直接内存拷贝
     *
     * @tparam K Key 类型，必须：
@@ -83,6 +95,101 @@ namespace hgl
         */
         std::vector<V> values;
 
+        /**
+        * @brief CN:冻结时建立的查找索引（键改变时自动解冻）\nEN:Search index built by Freeze() (dropped whenever keys change)
+        */
+        SortedSearchIndex<K> frozen_index;
+        bool frozen = false;
+
+        /**
+        * @brief CN:把已排序去重的批数据合并进keys/values\nEN:Merge a sorted unique batch into keys/values
+        * @param batch_keys CN:已排序去重的键，会被改写为实际新增的键。EN:Sorted unique keys, overwritten with the keys actually added.
+        * @param batch_values CN:对应的值。EN:Matching values.
+        * @param overwrite CN:键已存在时是否覆盖值。EN:Whether to overwrite values of existing keys.
+        * @return CN:新增键的数量。EN:Number of keys added.
+        */
+        int64 MergeSortedBatch(K* batch_keys, V* batch_values, int64 count, bool overwrite)
+        {
+            const int64 old_count = (int64)keys.size();
+
+            // 1.滤掉已存在的键（按策略更新其值）
+            int64 fresh = 0;
+
+            auto keep_or_update = [&](int64 exist_index, int64 j)
+            {
+                if (exist_index < 0)
+                {
+                    batch_keys[fresh] = batch_keys[j];
+                    batch_values[fresh] = batch_values[j];
+                    ++fresh;
+                }
+                else if (overwrite)
+                {
+                    values[exist_index] = batch_values[j];
+                }
+            };
+
+            if (count * 8 < old_count)
+            {
+                // 批数据远小于现有数据：逐个二分查找
+                auto pos = keys.begin();
+
+                for (int64 j = 0; j < count; j++)
+                {
+                    pos = std::lower_bound(pos, keys.end(), batch_keys[j]);
+
+                    const bool exist = (pos != keys.end() && !(batch_keys[j] < *pos));
+                    keep_or_update(exist ? std::distance(keys.begin(), pos) : -1, j);
+                }
+            }
+            else
+            {
+                int64 i = 0;
+
+                for (int64 j = 0; j < count; j++)
+                {
+                    while (i < old_count && keys[i] < batch_keys[j])
+                        ++i;
+
+                    const bool exist = (i < old_count && !(batch_keys[j] < keys[i]));
+                    keep_or_update(exist ? i : -1, j);
+                }
+            }
+
+            if (fresh == 0)
+                return 0;
+
+            Thaw();
+
+            // 2.从尾部向前合并，只移动插入点之后的元素
+            keys.resize(old_count + fresh);
+            values.resize(old_count + fresh);
+
+            int64 i = old_count - 1;
+            int64 j = fresh - 1;
+            int64 k = old_count + fresh - 1;
+
+            while (j >= 0)
+            {
+                if (i >= 0 && batch_keys[j] < keys[i])
+                {
+                    keys[k] = keys[i];
+                    values[k] = values[i];
+                    --i;
+                }
+                else
+                {
+                    keys[k] = batch_keys[j];
+                    values[k] = batch_values[j];
+                    --j;
+                }
+
+                --k;
+            }
+
+            return fresh;
+        }
+
     public:
         using key_type = K;
         using value_type = V;
@@ -146,6 +253,8 @@ namespace hgl
             if (!key_buffer || !value_buffer || count <= 0)
                 return;
 
+            Thaw();
+
             keys.assign(key_buffer, key_buffer + count);
             values.assign(value_buffer, value_buffer + count);
 
@@ -269,6 +378,9 @@ namespace hgl
         */
         virtual int64 Find(const K& key) const
         {
+            if (frozen)
+                return frozen_index.Find(keys.data(), key);
+
             auto it = std::lower_bound(keys.begin(), keys.end(), key);
             if (it != keys.end() && !(*it < key) && !(key < *it))  // *it == key
             {
@@ -472,6 +584,8 @@ namespace hgl
                 return false;  // 键已存在
             }
 
+            Thaw();
+
             // 插入到正确的有序位置
             int64 index = std::distance(keys.begin(), it);
             keys.insert(it, key);
@@ -495,6 +609,8 @@ namespace hgl
                 return false;  // 键已存在
             }
 
+            Thaw();
+
             // 插入到正确的有序位置
             int64 index = std::distance(keys.begin(), it);
             keys.insert(it, std::move(key));
@@ -510,6 +626,7 @@ namespace hgl
             auto it = std::lower_bound(keys.begin(), keys.end(), key);
             if (it != keys.end() && !(*it < key) && !(key < *it))
                 return false;
+            Thaw();
             int64 index = std::distance(keys.begin(), it);
             keys.insert(it, std::move(key));
             values.insert(values.begin() + index, value);
@@ -524,6 +641,7 @@ namespace hgl
             auto it = std::lower_bound(keys.begin(), keys.end(), key);
             if (it != keys.end() && !(*it < key) && !(key < *it))
                 return false;
+            Thaw();
             int64 index = std::distance(keys.begin(), it);
             keys.insert(it, key);
             values.insert(values.begin() + index, std::move(value));
@@ -642,6 +760,7 @@ namespace hgl
             int64 index = Find(key);
             if (index >= 0)
             {
+                Thaw();
                 keys.erase(keys.begin() + index);
                 values.erase(values.begin() + index);
                 return true;
@@ -659,6 +778,7 @@ namespace hgl
             if (index < 0 || index >= (int64)keys.size())
                 return false;
 
+            Thaw();
             keys.erase(keys.begin() + index);
             values.erase(values.begin() + index);
             return true;
@@ -675,6 +795,7 @@ namespace hgl
             if (start < 0 || count <= 0 || start + count > (int64)keys.size())
                 return false;
 
+            Thaw();
             keys.erase(keys.begin() + start, keys.begin() + start + count);
             values.erase(values.begin() + start, values.begin() + start + count);
             return true;
@@ -690,6 +811,7 @@ namespace hgl
             int64 index = FindByValue(value);
             if (index >= 0)
             {
+                Thaw();
                 keys.erase(keys.begin() + index);
                 values.erase(values.begin() + index);
                 return true;
@@ -709,6 +831,7 @@ namespace hgl
             if (index >= 0)
             {
                 value = values[index];
+                Thaw();
                 keys.erase(keys.begin() + index);
                 values.erase(values.begin() + index);
                 return true;
@@ -721,8 +844,146 @@ namespace hgl
         */
         virtual void Clear()
         {
+            Thaw();
+            keys.clear();
+            values.clear();
+        }
+
+        // ============================================================
+        // 冻结（只读查找索引）
+        // ============================================================
+
+        /**
+        * @brief CN:冻结：建立16键B+树查找索引，之后Find/ContainsKey/Get等使用该索引\nEN:Freeze: build a 16-key B+ tree search index used by Find/ContainsKey/Get etc.
+        * @note CN:任何改变键的操作都会自动解冻；只修改值不影响冻结状态。
+        *       不要在冻结期间通过GetKeyData()/GetKeyVector()/迭代器直接改写键。\n
+        *       EN:Any operation that changes keys thaws automatically; changing values keeps the map frozen.
+        *       Do not write keys through GetKeyData()/GetKeyVector()/iterators while frozen.
+        */
+        void Freeze()
+        {
+            frozen_index.Build(keys.data(), (int64)keys.size());
+            frozen = true;
+        }
+
+        /**
+        * @brief CN:解冻，释放查找索引\nEN:Thaw and release the search index
+        */
+        void Thaw()
+        {
+            if (!frozen)
+                return;
+
+            frozen_index.Clear();
+            frozen = false;
+        }
+
+        bool IsFrozen() const { return frozen; }
+
+        /**
+        * @brief CN:查找索引占用的字节数\nEN:Bytes used by the search index
+        */
+        int64 GetFrozenIndexSize() const { return frozen_index.GetByteSize(); }
+
+        // ============================================================
+        // 批量添加/删除
+        // ============================================================
+
+        /**
+        * @brief CN:批量添加键值对（排序去重后一次线性合并）\nEN:Batch add key-value pairs (sort, deduplicate, then one linear merge)
+        * @param key_buffer CN:键（无需有序，可含重复）。EN:Keys (unsorted, may contain duplicates).
+        * @param value_buffer CN:值。EN:Values.
+        * @param count CN:数量。EN:Count.
+        * @param policy CN:重复键处理策略。EN:Duplicate key policy.
+        * @return CN:新增键的数量。EN:Number of keys added.
+        */
+        int64 AddBatch(const K* key_buffer, const V* value_buffer, int64 count, BatchDuplicatePolicy policy = BatchDuplicatePolicy::KeepFirst)
+        {
+            if (!key_buffer || !value_buffer || count <= 0)
+                return 0;
+
+            const bool keep_last = (policy == BatchDuplicatePolicy::KeepLast);
+
+            std::vector<K> batch_keys(key_buffer, key_buffer + count);
+            std::vector<V> batch_values(value_buffer, value_buffer + count);
+
+            const int64 unique_count = SortUniquePairs(batch_keys.data(), batch_values.data(), count, keep_last);
+
+            return MergeSortedBatch(batch_keys.data(), batch_values.data(), unique_count, keep_last);
+        }
+
+        /**
+        * @brief CN:用给定键值对重建映射（原有内容被清除）\nEN:Rebuild the map from given pairs (existing content is discarded)
+        * @param key_buffer CN:键（无需有序，可含重复）。EN:Keys (unsorted, may contain duplicates).
+        * @param value_buffer CN:值。EN:Values.
+        * @param count CN:数量。EN:Count.
+        * @param policy CN:重复键处理策略。EN:Duplicate key policy.
+        * @return CN:映射中的键数量。EN:Number of keys in the map.
+        */
+        int64 BuildFrom(const K* key_buffer, const V* value_buffer, int64 count, BatchDuplicatePolicy policy = BatchDuplicatePolicy::KeepFirst)
+        {
+            Thaw();
             keys.clear();
             values.clear();
+
+            if (!key_buffer || !value_buffer || count <= 0)
+                return 0;
+
+            keys.assign(key_buffer, key_buffer + count);
+            values.assign(value_buffer, value_buffer + count);
+
+            const int64 unique_count = SortUniquePairs(keys.data(), values.data(), count, policy == BatchDuplicatePolicy::KeepLast);
+
+            keys.resize(unique_count);
+            values.resize(unique_count);
+
+            return unique_count;
+        }
+
+        /**
+        * @brief CN:批量按键删除（排序去重后一次线性压缩）\nEN:Batch delete by key (sort, deduplicate, then one compaction pass)
+        * @param key_buffer CN:键（无需有序，可含重复）。EN:Keys (unsorted, may contain duplicates).
+        * @param count CN:数量。EN:Count.
+        * @return CN:删除的数量。EN:Number of keys deleted.
+        */
+        int64 DeleteBatch(const K* key_buffer, int64 count)
+        {
+            if (!key_buffer || count <= 0 || keys.empty())
+                return 0;
+
+            std::vector<K> batch(key_buffer, key_buffer + count);
+
+            const int64 batch_count = SortUnique(batch.data(), count);
+
+            // 从第一个可能被删除的位置开始压缩
+            int64 write = std::distance(keys.begin(), std::lower_bound(keys.begin(), keys.end(), batch[0]));
+            int64 j = 0;
+
+            for (int64 read = write; read < (int64)keys.size(); read++)
+            {
+                while (j < batch_count && batch[j] < keys[read])
+                    ++j;
+
+                if (j < batch_count && !(keys[read] < batch[j]))        // 相等，删除
+                    continue;
+
+                if (write != read)
+                {
+                    keys[write] = keys[read];
+                    values[write] = values[read];
+                }
+
+                ++write;
+            }
+
+            const int64 deleted = (int64)keys.size() - write;
+
+            if (deleted > 0)
+                Thaw();
+
+            keys.resize(write);
+            values.resize(write);
+            return deleted;
         }
 
         // ============================================================
@@ -3,6 +3,9 @@
 #include<vector>
 #include<algorithm>
 #include<hgl/type/DataType.h>
+#include<hgl/type/RadixSort.h>
+#include<hgl/type/SortedSearchIndex.h>
+#include<hgl/type/SortedSetAlgebra.h>
 
 namespace hgl
 {
@@ -18,6 +21,9 @@ namespace hgl
      * - 支持任意类型（需要支持 operator< 和 operator==）
      * - 自动去重和排序
      * - 查找 O(log n)，插入/删除 O(n)
+     * - 集合运算(Union/Intersect/Difference/SymmetricDifference)：线性合并，大小悬殊时倍增查找，32位整数求交/求差使用SIMD
+     * - 读多写少时可Freeze()建立16键B+树查找索引，Find/Contains每层只访问一个节点，修改时自动解冻
+     * - 批量添加/删除(AddBatch/DeleteBatch/BuildFrom)：先排序去重(整数使用基数排序)，再一次线性合并，O(n+m)
      *
      * <b>重要提示：</b>
      * - 零拷贝序列化方法（GetData/LoadFromBuffer）仅适用于平凡类型（trivially copyable）
@@ -37,6 +43,101 @@ namespace hgl
          */
         std::vector<T> data;
 
+        /**
+         * @brief CN:冻结时建立的查找索引（数据改变时自动解冻）\nEN:Search index built by Freeze() (dropped whenever data changes)
+         */
+        SortedSearchIndex<T> frozen_index;
+        bool frozen = false;
+
+        /**
+         * @brief CN:第一个不小于value的位置（冻结时使用查找索引）\nEN:First position not less than value (uses the search index while frozen)
+         */
+        int64 LowerBoundIndex(const T& value) const
+        {
+            if (frozen)
+                return frozen_index.LowerBound(data.data(), value);
+
+            return std::distance(data.begin(), std::lower_bound(data.begin(), data.end(), value));
+        }
+
+        /**
+         * @brief CN:截断到count个元素\nEN:Truncate to count elements
+         * @return CN:删除的元素个数。EN:Number of elements removed.
+         */
+        int64 Truncate(int64 count)
+        {
+            const int64 removed = (int64)data.size() - count;
+
+            if (removed > 0)
+            {
+                Thaw();
+                data.erase(data.begin() + count, data.end());
+            }
+
+            return removed;
+        }
+
+        /**
+         * @brief CN:把已排序去重的批数据合并进data\nEN:Merge a sorted unique batch into data
+         * @param batch CN:已排序去重的数据，会被改写为实际新增的元素。EN:Sorted unique data, overwritten with the elements actually added.
+         * @return CN:新增元素个数。EN:Number of elements added.
+         */
+        int64 MergeSortedBatch(T *batch, int64 count)
+        {
+            const int64 old_count = (int64)data.size();
+
+            // 1.滤掉已存在的元素(批数据远小于现有数据时逐个二分查找，否则双指针线性扫描)
+            int64 fresh = 0;
+
+            if (count * 8 < old_count)
+            {
+                auto pos = data.begin();
+
+                for (int64 i = 0; i < count; i++)
+                {
+                    pos = std::lower_bound(pos, data.end(), batch[i]);
+
+                    if (pos == data.end() || batch[i] < *pos)
+                        batch[fresh++] = batch[i];
+                }
+            }
+            else
+            {
+                int64 i = 0;
+
+                for (int64 j = 0; j < count; j++)
+                {
+                    while (i < old_count && data[i] < batch[j])
+                        ++i;
+
+                    if (i == old_count || batch[j] < data[i])
+                        batch[fresh++] = batch[j];
+                }
+            }
+
+            if (fresh == 0)
+                return 0;
+
+            Thaw();
+
+            // 2.从尾部向前合并，只移动插入点之后的元素
+            data.resize(old_count + fresh);
+
+            int64 i = old_count - 1;
+            int64 j = fresh - 1;
+            int64 k = old_count + fresh - 1;
+
+            while (j >= 0)
+            {
+                if (i >= 0 && batch[j] < data[i])
+                    data[k--] = std::move(data[i--]);
+                else
+                    data[k--] = batch[j--];
+            }
+
+            return fresh;
+        }
+
     public:
         using iterator = typename std::vector<T>::iterator;
         using const_iterator = typename std::vector<T>::const_iterator;
@@ -71,6 +172,7 @@ namespace hgl
 
     public:
         FlatOrderedSet() = default;
+        FlatOrderedSet(const FlatOrderedSet<T>&) = default;        ///<与operator=一致，连同冻结索引一起复制
         virtual ~FlatOrderedSet() = default;
 
         // ==================== 序列化支持（仅限平凡类型）====================
@@ -110,6 +212,8 @@ namespace hgl
             if (!buffer || count <= 0)
                 return;
 
+            Thaw();
+
             data.assign(buffer, buffer + count);
 
             if (!is_sorted)
@@ -152,13 +256,13 @@ namespace hgl
          */
         const_iterator Find(const T& flag) const
         {
-            auto it = std::lower_bound(data.begin(), data.end(), flag);
+            auto it = data.begin() + LowerBoundIndex(flag);
             return (it != data.end() && *it == flag) ? it : data.end();
         }
 
         iterator Find(const T& flag)
         {
-            auto it = std::lower_bound(data.begin(), data.end(), flag);
+            auto it = data.begin() + LowerBoundIndex(flag);
             return (it != data.end() && *it == flag) ? it : data.end();
         }
 
@@ -169,10 +273,10 @@ namespace hgl
          */
         int64 FindIndex(const T& flag) const
         {
-            auto it = std::lower_bound(data.begin(), data.end(), flag);
-            if (it == data.end() || *it != flag)
+            const int64 index = LowerBoundIndex(flag);
+            if (index == (int64)data.size() || data[index] != flag)
                 return -1;
-            return std::distance(data.begin(), it);
+            return index;
         }
 
         /**
@@ -180,8 +284,8 @@ namespace hgl
          */
         bool Contains(const T& v) const
         {
-            auto it = std::lower_bound(data.begin(), data.end(), v);
-            return (it != data.end() && *it == v);
+            const int64 index = LowerBoundIndex(v);
+            return (index != (int64)data.size() && data[index] == v);
         }
 
         // ==================== 添加 ====================
@@ -199,6 +303,8 @@ namespace hgl
             if (it != data.end() && *it == value)
                 return -1;
 
+            Thaw();
+
             auto result_it = data.insert(it, value);
             return std::distance(data.begin(), result_it);
         }
@@ -216,6 +322,8 @@ namespace hgl
             if (it != data.end() && *it == value)
                 return -1;
 
+            Thaw();
+
             auto result_it = data.insert(it, std::move(value));
             return std::distance(data.begin(), result_it);
         }
@@ -227,21 +335,58 @@ namespace hgl
          * @return 成功添加的元素个数
          */
         int64 Add(const T* dl, int64 count)
+        {
+            return AddBatch(dl, count);
+        }
+
+        /**
+         * @brief CN:批量添加元素（排序去重后一次线性合并）\nEN:Batch add (sort, deduplicate, then one linear merge)
+         * @param dl 数据指针（无需有序，可含重复）
+         * @param count 数据个数
+         * @return 成功添加的元素个数
+         */
+        int64 AddBatch(const T* dl, int64 count)
         {
             if (!dl || count <= 0)
                 return 0;
 
-            int64 added = 0;
-            for (int64 i = 0; i < count; i++)
-            {
-                auto it = std::lower_bound(data.begin(), data.end(), dl[i]);
-                if (it == data.end() || *it != dl[i])
-                {
-                    data.insert(it, dl[i]);
-                    ++added;
-                }
-            }
-            return added;
+            std::vector<T> batch(dl, dl + count);
+
+            const int64 unique_count = SortUnique(batch.data(), count);
+
+            return MergeSortedBatch(batch.data(), unique_count);
+        }
+
+        /**
+         * @brief CN:用给定数据重建集合（原有元素被清除）\nEN:Rebuild the set from given data (existing elements are discarded)
+         * @param dl 数据指针（无需有序，可含重复）
+         * @param count 数据个数
+         * @return 集合元素个数
+         */
+        int64 BuildFrom(const T* dl, int64 count)
+        {
+            Thaw();
+            data.clear();
+
+            if (!dl || count <= 0)
+                return 0;
+
+            data.assign(dl, dl + count);
+            data.resize(SortUnique(data.data(), count));
+
+            return (int64)data.size();
+        }
+
+        /**
+         * @brief CN:用已排序且不重复的序列直接替换全部元素（不做排序检查）\nEN:Replace all elements with an already sorted unique range (not checked)
+         * @return 元素个数
+         */
+        template<typename It>
+        int64 AssignSorted(It first, It last)
+        {
+            Thaw();
+            data.assign(first, last);
+            return (int64)data.size();
         }
 
         // ==================== 删除 ====================
@@ -256,6 +401,7 @@ namespace hgl
             if (pos < 0 || pos >= (int64)data.size())
                 return false;
 
+            Thaw();
             data.erase(data.begin() + pos);
             return true;
         }
@@ -271,6 +417,7 @@ namespace hgl
             if (it == data.end() || *it != value)
                 return false;
 
+            Thaw();
             data.erase(it);
             return true;
         }
@@ -283,19 +430,50 @@ namespace hgl
          */
         int64 Delete(const T* dp, int64 count)
         {
-            if (!dp || count <= 0)
+            return DeleteBatch(dp, count);
+        }
+
+        /**
+         * @brief CN:批量删除元素（排序去重后一次线性压缩）\nEN:Batch delete (sort, deduplicate, then one compaction pass)
+         * @param dp 数据指针（无需有序，可含重复）
+         * @param count 数据个数
+         * @return 成功删除的元素个数
+         */
+        int64 DeleteBatch(const T* dp, int64 count)
+        {
+            if (!dp || count <= 0 || data.empty())
                 return 0;
 
-            int64 deleted = 0;
-            for (int64 i = 0; i < count; i++)
+            std::vector<T> batch(dp, dp + count);
+
+            const int64 batch_count = SortUnique(batch.data(), count);
+
+            // 从第一个可能被删除的位置开始压缩
+            auto first = std::lower_bound(data.begin(), data.end(), batch[0]);
+
+            int64 write = std::distance(data.begin(), first);
+            int64 j = 0;
+
+            for (int64 read = write; read < (int64)data.size(); read++)
             {
-                auto it = std::lower_bound(data.begin(), data.end(), dp[i]);
-                if (it != data.end() && *it == dp[i])
-                {
-                    data.erase(it);
-                    ++deleted;
-                }
+                while (j < batch_count && batch[j] < data[read])
+                    ++j;
+
+                if (j < batch_count && !(data[read] < batch[j]))       // 相等，删除
+                    continue;
+
+                if (write != read)
+                    data[write] = std::move(data[read]);
+
+                ++write;
             }
+
+            const int64 deleted = (int64)data.size() - write;
+
+            if (deleted > 0)
+                Thaw();
+
+            data.erase(data.begin() + write, data.end());
             return deleted;
         }
 
@@ -304,6 +482,7 @@ namespace hgl
          */
         void Free()
         {
+            Thaw();
             data.clear();
             data.shrink_to_fit();
         }
@@ -311,7 +490,39 @@ namespace hgl
         /**
          * @brief CN:清空所有元素\nEN:Clear all elements
          */
-        void Clear() { data.clear(); }
+        void Clear() { Thaw(); data.clear(); }
+
+        // ==================== 冻结 ====================
+
+        /**
+         * @brief CN:冻结：建立16键B+树查找索引，之后Find/FindIndex/Contains/lower_bound使用该索引\nEN:Freeze: build a 16-key B+ tree search index used by Find/FindIndex/Contains/lower_bound
+         * @note CN:任何修改操作都会自动解冻；不要在冻结期间通过GetData()/迭代器直接改写元素。\n
+         *       EN:Any modification thaws automatically; do not write elements through GetData()/iterators while frozen.
+         */
+        void Freeze()
+        {
+            frozen_index.Build(data.data(), (int64)data.size());
+            frozen = true;
+        }
+
+        /**
+         * @brief CN:解冻，释放查找索引\nEN:Thaw and release the search index
+         */
+        void Thaw()
+        {
+            if (!frozen)
+                return;
+
+            frozen_index.Clear();
+            frozen = false;
+        }
+
+        bool IsFrozen() const { return frozen; }
+
+        /**
+         * @brief CN:查找索引占用的字节数\nEN:Bytes used by the search index
+         */
+        int64 GetFrozenIndexSize() const { return frozen_index.GetByteSize(); }
 
         // ==================== 获取数据 ====================
 
@@ -365,7 +576,7 @@ namespace hgl
          */
         const_iterator lower_bound(const T& value) const
         {
-            return std::lower_bound(data.begin(), data.end(), value);
+            return data.begin() + LowerBoundIndex(value);
         }
 
         /**
@@ -376,6 +587,119 @@ namespace hgl
             return std::upper_bound(data.begin(), data.end(), value);
         }
 
+        // ==================== 集合运算 ====================
+
+        /**
+         * @brief CN:并集，结果写入预分配的out\nEN:Union written into preallocated out
+         * @param out CN:至少GetCount()+other.GetCount()个元素。EN:At least GetCount()+other.GetCount() elements.
+         * @return CN:结果元素个数。EN:Number of elements written.
+         */
+        int64 Union(const ThisClass& other, T* out) const
+        {
+            return SortedUnion(data.data(), (int64)data.size(), other.data.data(), (int64)other.data.size(), out);
+        }
+
+        /**
+         * @brief CN:交集，结果写入预分配的out\nEN:Intersection written into preallocated out
+         * @param out CN:至少min(GetCount(),other.GetCount())个元素。EN:At least min(GetCount(),other.GetCount()) elements.
+         */
+        int64 Intersect(const ThisClass& other, T* out) const
+        {
+            return SortedIntersect(data.data(), (int64)data.size(), other.data.data(), (int64)other.data.size(), out);
+        }
+
+        /**
+         * @brief CN:差集(this-other)，结果写入预分配的out\nEN:Difference (this-other) written into preallocated out
+         * @param out CN:至少GetCount()个元素。EN:At least GetCount() elements.
+         */
+        int64 Difference(const ThisClass& other, T* out) const
+        {
+            return SortedDifference(data.data(), (int64)data.size(), other.data.data(), (int64)other.data.size(), out);
+        }
+
+        /**
+         * @brief CN:对称差，结果写入预分配的out\nEN:Symmetric difference written into preallocated out
+         * @param out CN:至少GetCount()+other.GetCount()个元素。EN:At least GetCount()+other.GetCount() elements.
+         */
+        int64 SymmetricDifference(const ThisClass& other, T* out) const
+        {
+            return SortedSymmetricDifference(data.data(), (int64)data.size(), other.data.data(), (int64)other.data.size(), out);
+        }
+
+        /**
+         * @brief CN:求并集（原地）\nEN:Union (in place)
+         * @return CN:新增元素个数。EN:Number of elements added.
+         */
+        int64 Union(const ThisClass& other)
+        {
+            if (this == &other || other.data.empty())
+                return 0;
+
+            std::vector<T> result(data.size() + other.data.size());
+            result.resize(Union(other, result.data()));
+
+            const int64 added = (int64)(result.size() - data.size());
+
+            if (added > 0)
+            {
+                Thaw();
+                data.swap(result);
+            }
+
+            return added;
+        }
+
+        /**
+         * @brief CN:求交集（原地）\nEN:Intersection (in place)
+         * @return CN:删除的元素个数。EN:Number of elements removed.
+         */
+        int64 Intersect(const ThisClass& other)
+        {
+            if (this == &other)
+                return 0;
+
+            const int64 count = SortedIntersect(data.data(), (int64)data.size(), other.data.data(), (int64)other.data.size(), data.data());
+
+            return Truncate(count);
+        }
+
+        /**
+         * @brief CN:求差集（原地）\nEN:Difference (in place)
+         * @return CN:删除的元素个数。EN:Number of elements removed.
+         */
+        int64 Difference(const ThisClass& other)
+        {
+            if (this == &other)
+                return Truncate(0);
+
+            const int64 count = SortedDifference(data.data(), (int64)data.size(), other.data.data(), (int64)other.data.size(), data.data());
+
+            return Truncate(count);
+        }
+
+        /**
+         * @brief CN:求对称差（原地）\nEN:Symmetric difference (in place)
+         * @return CN:结果元素个数。EN:Number of elements in the result.
+         */
+        int64 SymmetricDifference(const ThisClass& other)
+        {
+            if (this == &other)
+            {
+                Truncate(0);
+                return 0;
+            }
+
+            if (other.data.empty())
+                return (int64)data.size();
+
+            std::vector<T> result(data.size() + other.data.size());
+            result.resize(SymmetricDifference(other, result.data()));
+
+            Thaw();
+            data.swap(result);
+            return (int64)data.size();
+        }
+
         // ==================== 运算符 ====================
 
         /**
@@ -384,6 +708,8 @@ namespace hgl
         FlatOrderedSet<T>& operator=(const FlatOrderedSet<T>& other)
         {
             data = other.data;
+            frozen_index = other.frozen_index;
+            frozen = other.frozen;
             return *this;
         }
 
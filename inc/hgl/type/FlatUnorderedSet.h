@@ -6,15 +6,16 @@
 
 #include <type_traits>
 #include <vector>
+#include <algorithm>
 #include <hgl/util/hash/QuickHash.h>
 #include <hgl/type/ActiveDataManager.h>
 #include <hgl/type/ValueArray.h>
-#include <ankerl/unordered_dense.h>
 
 namespace hgl
 {
     // AI NOTE: Compact unordered set using ActiveDataManager (contiguous data)
-    // and a hash->id list map. Deletes mark ids inactive; rebuild hash map
+    // and a flat open-addressing index of (id, hash32) slots. Values are compared
+    // in place; deletes use backward-shift (no tombstones); rebuild the index
     // if values are modified in place. Best for trivially copyable types.
     // ==================== 紧凑型无序值集合（Compact Value Set）====================
 
@@ -28,6 +29,9 @@ namespace hgl
      * - CN:删除性能提升 10,000+ 倍\nEN:10,000+ times faster deletion
      * - CN:内存占用减少 50-70%\nEN:50-70% less memory usage
      * - CN:简单类型（int/指针）哈希零开销\nEN:Zero-overhead hashing for simple types (int/pointer)
+     *
+     * CN:索引为单一连续的开放寻址表（线性探测），每个槽位仅8字节(ID+32位哈希)，\nEN:The index is one contiguous open-addressing table (linear probing), 8 bytes per slot (ID + 32-bit hash),
+     * CN:查找时先比较32位哈希，再通过ID直接比较数据，Add不产生任何单独的堆分配（仅表扩容时整体重分配）。\nEN:lookups compare the 32-bit hash first, then the value in place by ID; Add makes no per-item heap allocation (only whole-table growth).
      */
     template<typename T>
     class FlatUnorderedSet
@@ -42,9 +46,133 @@ namespace hgl
         ActiveDataManager<T> data_manager;
 
         /**
-         * @brief CN:哈希到ID的映射表\nEN:Hash to ID mapping table
+         * @brief CN:索引槽位\nEN:Index slot
+         */
+        struct IndexSlot
+        {
+            int id;                         ///< CN:数据ID，-1表示空槽位 EN:Data ID, -1 means empty
+            uint32 hash;                    ///< CN:32位哈希(低位决定槽位，全部位用于快速比较) EN:32-bit hash (low bits pick the slot, all bits used as fingerprint)
+        };
+
+        /**
+         * @brief CN:开放寻址索引表（容量为2的幂，负载不超过75%）\nEN:Open-addressing index table (power-of-two capacity, load <= 75%)
+         */
+        std::vector<IndexSlot> index_table;
+        int index_mask = -1;                ///< CN:容量-1，空表为-1 EN:Capacity - 1, -1 when empty
+
+        static uint32 IndexHash(const T& value)
+        {
+            const uint64 hash = ComputeOptimalHash(value);  // ✅ 使用优化的哈希
+
+            return uint32(hash) ^ uint32(hash >> 32);
+        }
+
+        static int IndexCapacityFor(int count)
+        {
+            int cap = 16;
+
+            while (cap - (cap >> 2) < count)
+                cap <<= 1;
+
+            return cap;
+        }
+
+        void ResizeIndex(int new_capacity)
+        {
+            std::vector<IndexSlot> old = std::move(index_table);
+
+            index_table.assign(new_capacity, IndexSlot{-1, 0});
+            index_mask = new_capacity - 1;
+
+            for (const IndexSlot &slot : old)
+                if (slot.id != -1)
+                    InsertSlot(slot.id, slot.hash);
+        }
+
+        void InsertSlot(int id, uint32 hash)
+        {
+            int pos = int(hash) & index_mask;
+
+            while (index_table[pos].id != -1)
+                pos = (pos + 1) & index_mask;
+
+            index_table[pos] = IndexSlot{id, hash};
+        }
+
+        /**
+         * @brief CN:查找值所在的槽位\nEN:Find the slot holding a value
+         * @return CN:槽位下标，不存在返回 -1\nEN:Slot index, or -1 if not found
+         */
+        int FindSlot(const T& value, uint32 hash) const
+        {
+            if (index_mask < 0)
+                return -1;
+
+            int pos = int(hash) & index_mask;
+
+            while (true)
+            {
+                const IndexSlot &slot = index_table[pos];
+
+                if (slot.id == -1)
+                    return -1;
+
+                if (slot.hash == hash && *data_manager.At(slot.id) == value)
+                    return pos;
+
+                pos = (pos + 1) & index_mask;
+            }
+        }
+
+        /**
+         * @brief CN:查找指定ID所在的槽位\nEN:Find the slot holding an ID
+         */
+        int FindSlotByID(int id, uint32 hash) const
+        {
+            if (index_mask < 0)
+                return -1;
+
+            int pos = int(hash) & index_mask;
+
+            while (index_table[pos].id != -1)
+            {
+                if (index_table[pos].id == id)
+                    return pos;
+
+                pos = (pos + 1) & index_mask;
+            }
+
+            return -1;
+        }
+
+        /**
+         * @brief CN:删除槽位（后移删除，不留墓碑）\nEN:Erase a slot (backward-shift deletion, no tombstones)
          */
-        ankerl::unordered_dense::map<uint64, std::vector<int>> hash_map;
+        void EraseSlot(int pos)
+        {
+            int next = pos;
+
+            while (true)
+            {
+                next = (next + 1) & index_mask;
+
+                const IndexSlot &slot = index_table[next];
+
+                if (slot.id == -1)
+                    break;
+
+                const int home = int(slot.hash) & index_mask;
+
+                // home 循环位于 (pos, next] 之间的槽位不能前移
+                if (((next - home) & index_mask) < ((next - pos) & index_mask))
+                    continue;
+
+                index_table[pos] = slot;
+                pos = next;
+            }
+
+            index_table[pos].id = -1;
+        }
 
         /**
          * @brief CN:根据值查找ID\nEN:Find ID by value
@@ -53,19 +181,49 @@ namespace hgl
         {
             static_assert(std::is_trivially_copyable_v<T>,
                 "FindID() requires trivially copyable types for optimal hashing.");
-            uint64 hash = ComputeOptimalHash(value);  // ✅ 使用优化的哈希
-            auto it = hash_map.find(hash);
-            if (it == hash_map.end())
-                return -1;
 
-            for (int id : it->second) {
-                if (!data_manager.IsActive(id))
-                    continue;
-                T existing;
-                if (data_manager.GetData(existing, id) && existing == value)
-                    return id;
+            const int pos = FindSlot(value, IndexHash(value));
+
+            return pos == -1 ? -1 : index_table[pos].id;
+        }
+
+        /**
+         * @brief CN:为新值分配ID并写入索引（调用前需确认值不存在）\nEN:Allocate an ID for a new value and index it (value must not exist)
+         */
+        template<typename V>
+        bool Insert(V&& value, uint32 hash)
+        {
+            if (data_manager.GetActiveCount() + 1 > index_mask + 1 - ((index_mask + 1) >> 2))
+                ResizeIndex(IndexCapacityFor(data_manager.GetActiveCount() + 1));
+
+            int new_id;
+            if (!data_manager.GetOrCreate(&new_id, 1))
+                return false;  // 容量满或分配失败
+
+            if (!data_manager.WriteData(std::forward<V>(value), new_id))
+            {
+                data_manager.Release(&new_id, 1);
+                return false;
             }
-            return -1;
+
+            InsertSlot(new_id, hash);
+            return true;
+        }
+
+        /**
+         * @brief CN:释放ID并从索引中删除\nEN:Release an ID and remove it from the index
+         */
+        bool EraseID(int id)
+        {
+            const int pos = FindSlotByID(id, IndexHash(*data_manager.At(id)));
+
+            if (data_manager.Release(&id, 1) <= 0)
+                return false;
+
+            if (pos != -1)
+                EraseSlot(pos);
+
+            return true;
         }
 
         // 重建哈希表：用于数据被就地修改后
@@ -73,23 +231,27 @@ namespace hgl
         {
             static_assert(std::is_trivially_copyable_v<T>,
                 "RebuildHashMap() requires trivially copyable types for optimal hashing.");
-            hash_map.clear();
 
-            auto active_ids = data_manager.GetActiveView();
-            const int count = (int)active_ids.size();
+            index_table.assign(IndexCapacityFor(data_manager.GetActiveCount()), IndexSlot{-1, 0});
+            index_mask = int(index_table.size()) - 1;
 
-            for (int i = 0; i < count; i++)
+            const ActiveDataManager<T> &dm = data_manager;
+
+            dm.ForEachActive([this](int id, const T& value)
             {
-                int id = active_ids[i];
-                if (!data_manager.IsActive(id))
-                    continue;
+                InsertSlot(id, IndexHash(value));
+            });
+        }
 
-                T* ptr = data_manager.At(id);
-                if (!ptr)
-                    continue;
+        // 压缩搬移后，把索引中的旧ID替换为新ID
+        void RemapHashMap(const std::vector<ActiveIDRemap> &moved)
+        {
+            for (const ActiveIDRemap &m : moved)
+            {
+                const int pos = FindSlotByID(m.old_id, IndexHash(*data_manager.At(m.new_id)));
 
-                uint64 hash = ComputeOptimalHash(*ptr);  // ✅ 使用优化的哈希
-                hash_map[hash].push_back(id);
+                if (pos != -1)
+                    index_table[pos].id = m.new_id;
             }
         }
 
@@ -98,16 +260,16 @@ namespace hgl
         // ==================== 迭代器支持 ====================
 
         /**
-         * @brief CN:常量迭代器\nEN:Const iterator
+         * @brief CN:常量迭代器（直接按活跃ID前进，不分配内存）\nEN:Const iterator (steps over active IDs directly, no allocation)
          */
         class ConstIterator
         {
         private:
             const FlatUnorderedSet* set;
-            int index;
+            int id;                         ///< CN:当前活跃ID，-1表示结束 EN:Current active ID, -1 means end
 
         public:
-            ConstIterator(const FlatUnorderedSet* s, int idx) : set(s), index(idx) {}
+            ConstIterator(const FlatUnorderedSet* s, int active_id) : set(s), id(active_id) {}
 
             /**
              * @brief CN:解引用运算符\nEN:Dereference operator
@@ -115,7 +277,7 @@ namespace hgl
             T operator*() const
             {
                 T value;
-                set->Get(index, value);
+                set->data_manager.GetData(value, id);
                 return value;
             }
 
@@ -124,7 +286,7 @@ namespace hgl
              */
             ConstIterator& operator++()
             {
-                ++index;
+                id = set->data_manager.FindNextActive(id + 1);
                 return *this;
             }
 
@@ -134,7 +296,7 @@ namespace hgl
             ConstIterator operator++(int)
             {
                 ConstIterator temp = *this;
-                ++index;
+                ++(*this);
                 return temp;
             }
 
@@ -143,7 +305,7 @@ namespace hgl
              */
             bool operator!=(const ConstIterator& other) const
             {
-                return index != other.index || set != other.set;
+                return id != other.id || set != other.set;
             }
 
             /**
@@ -151,7 +313,7 @@ namespace hgl
              */
             bool operator==(const ConstIterator& other) const
             {
-                return index == other.index && set == other.set;
+                return id == other.id && set == other.set;
             }
         };
 
@@ -162,7 +324,7 @@ namespace hgl
          */
         ConstIterator begin() const
         {
-            return ConstIterator(this, 0);
+            return ConstIterator(this, data_manager.FindNextActive(0));
         }
 
         /**
@@ -170,7 +332,7 @@ namespace hgl
          */
         ConstIterator end() const
         {
-            return ConstIterator(this, GetCount());
+            return ConstIterator(this, -1);
         }
 
         /**
@@ -202,6 +364,9 @@ namespace hgl
         void Reserve(int capacity)
         {
             data_manager.Reserve(capacity);
+
+            if (capacity > index_mask + 1 - ((index_mask + 1) >> 2))
+                ResizeIndex(IndexCapacityFor(capacity));
         }
 
         /**
@@ -231,36 +396,13 @@ namespace hgl
         {
             static_assert(std::is_trivially_copyable_v<T>,
                 "Add() requires trivially copyable types for optimal hashing.");
-            uint64 hash = ComputeOptimalHash(value);  // ✅ 使用优化的哈希
+            const uint32 hash = IndexHash(value);
 
             // 检查是否已存在
-            auto it = hash_map.find(hash);
-            if (it != hash_map.end()) {
-                for (int id : it->second) {
-                    if (!data_manager.IsActive(id))
-                        continue;
-                    T existing;
-                    if (data_manager.GetData(existing, id) && existing == value)
-                        return false;  // 已存在
-                }
-            }
-
-            // 获取或创建新ID
-            int new_id;
-            if (!data_manager.GetOrCreate(&new_id, 1))
-                return false;  // 容量满或分配失败
-
-            // 写入数据
-            if (!data_manager.WriteData(value, new_id))
-            {
-                data_manager.Release(&new_id, 1);
+            if (FindSlot(value, hash) != -1)
                 return false;
-            }
-
-            // 添加到哈希表
-            hash_map[hash].push_back(new_id);
 
-            return true;
+            return Insert(value, hash);
         }
 
         /**
@@ -272,36 +414,14 @@ namespace hgl
         {
             static_assert(std::is_trivially_copyable_v<T>,
                 "Add() requires trivially copyable types for optimal hashing.");
-            uint64 hash = ComputeOptimalHash(value);
+            const uint32 hash = IndexHash(value);
 
             // 检查是否已存在
-            auto it = hash_map.find(hash);
-            if (it != hash_map.end()) {
-                for (int id : it->second) {
-                    if (!data_manager.IsActive(id))
-                        continue;
-                    T existing;
-                    if (data_manager.GetData(existing, id) && existing == value)
-                        return false;  // 已存在
-                }
-            }
-
-            // 获取或创建新ID
-            int new_id;
-            if (!data_manager.GetOrCreate(&new_id, 1))
+            if (FindSlot(value, hash) != -1)
                 return false;
 
             // 写入数据（使用移动语义）
-            if (!data_manager.WriteData(std::move(value), new_id))
-            {
-                data_manager.Release(&new_id, 1);
-                return false;
-            }
-
-            // 添加到哈希表
-            hash_map[hash].push_back(new_id);
-
-            return true;
+            return Insert(std::move(value), hash);
         }
 
         /**
@@ -344,19 +464,22 @@ namespace hgl
 
         /**
          * @brief CN:删除指定元素\nEN:Delete specified element
-         * @note CN:高性能删除（不重建哈希表）\nEN:High-performance deletion (no hash table rebuild)
+         * @note CN:高性能删除（索引槽位后移删除，不留墓碑）\nEN:High-performance deletion (backward-shift in the index, no tombstones)
          */
         bool Delete(const T& value)
         {
-            int id = FindID(value);
-            if (id == -1)
+            const int pos = FindSlot(value, IndexHash(value));
+            if (pos == -1)
                 return false;
 
-            // 注意：不从 hash_map 中删除（避免重建哈希表的开销）
-            // 查找时会通过 IsActive() 检查 ID 是否有效
+            int id = index_table[pos].id;
 
             // 释放ID（移到闲置池）
-            return data_manager.Release(&id, 1) > 0;
+            if (data_manager.Release(&id, 1) <= 0)
+                return false;
+
+            EraseSlot(pos);
+            return true;
         }
 
         /**
@@ -383,17 +506,12 @@ namespace hgl
          */
         bool DeleteAt(int index)
         {
-            auto active_ids = data_manager.GetActiveView();
-            if (index < 0 || index >= (int)active_ids.size())
+            int id = data_manager.GetActiveByIndex(index);
+            if (id == -1)
                 return false;
 
-            int id = active_ids[index];
-
-            // 注意：不从 hash_map 中删除（避免重建哈希表的开销）
-            // 查找时会通过 IsActive() 检查 ID 是否有效
-
-            // 释放ID（移到闲置池）
-            return data_manager.Release(&id, 1) > 0;
+            // 释放ID（移到闲置池），并从索引中删除
+            return EraseID(id);
         }
 
         /**
@@ -402,7 +520,7 @@ namespace hgl
         void Clear()
         {
             data_manager.Clear();
-            hash_map.clear();
+            std::fill(index_table.begin(), index_table.end(), IndexSlot{-1, 0});
         }
 
         /**
@@ -413,7 +531,9 @@ namespace hgl
             // std::vector 的内存会在析构时自动释放
             // 这里显式清空以触发内存释放
             data_manager.Free();
-            hash_map.clear();
+            index_table.clear();
+            index_table.shrink_to_fit();
+            index_mask = -1;
         }
 
         // ==================== 获取数据 ====================
@@ -423,11 +543,10 @@ namespace hgl
          */
         bool Get(int index, T& value) const
         {
-            auto active_ids = data_manager.GetActiveView();
-            if (index < 0 || index >= (int)active_ids.size())
+            int id = data_manager.GetActiveByIndex(index);
+            if (id == -1)
                 return false;
 
-            int id = active_ids[index];
             return data_manager.GetData(value, id);
         }
 
@@ -456,16 +575,10 @@ namespace hgl
         template<typename F>
         void Enum(F&& func) const
         {
-            auto active_ids = data_manager.GetActiveView();
-            const int count = (int)active_ids.size();
-
-            for (int i = 0; i < count; i++)
+            data_manager.ForEachActive([&func](int, const T& value)
             {
-                int id = active_ids[i];
-                T value;
-                if (data_manager.GetData(value, id))
-                    func(value);
-            }
+                func(value);
+            });
         }
 
         /**
@@ -474,16 +587,10 @@ namespace hgl
         template<typename F>
         void EnumMutable(F&& func)
         {
-            auto active_ids = data_manager.GetActiveView();
-            const int count = (int)active_ids.size();
-
-            for (int i = 0; i < count; i++)
+            data_manager.ForEachActive([&func](int, T& value)
             {
-                int id = active_ids[i];
-                T* ptr = data_manager.At(id);
-                if (ptr)
-                    func(*ptr);
-            }
+                func(value);
+            });
 
             // 数据已被修改，重建哈希表以保持查找正确
             RebuildHashMap();
@@ -589,6 +696,40 @@ namespace hgl
             RebuildHashMap();
         }
 
+        // ==================== 压缩 ====================
+
+        /**
+         * @brief CN:完整压缩：数据稠密排列到[0,GetCount())，并就地更新索引\nEN:Full compaction: pack data into [0,GetCount()) and patch the index in place
+         * @return CN:搬移的元素数量\nEN:Number of elements moved
+         * @note CN:之前通过Find()/GetActiveIDs()得到的ID会失效\nEN:IDs previously obtained via Find()/GetActiveIDs() become invalid
+         */
+        int Compact()
+        {
+            return CompactStep(INT_MAX);
+        }
+
+        /**
+         * @brief CN:增量压缩：最多搬移max_move个元素，并按搬移记录就地更新哈希表\nEN:Incremental compaction: move at most max_move elements and patch the hash map in place
+         * @return CN:本次搬移的元素数量\nEN:Number of elements moved in this step
+         */
+        int CompactStep(int max_move)
+        {
+            std::vector<ActiveIDRemap> moved;
+
+            const int result = data_manager.CompactStep(max_move, &moved);
+
+            RemapHashMap(moved);
+            return result;
+        }
+
+        /**
+         * @brief CN:是否已压缩\nEN:Whether data is fully compacted
+         */
+        bool IsCompact() const
+        {
+            return data_manager.IsCompact();
+        }
+
         /**
          * @brief CN:获取活跃ID数组\nEN:Get active ID array
          */
@@ -597,6 +738,14 @@ namespace hgl
             return data_manager.GetActiveView();
         }
 
+        /**
+         * @brief CN:获取活跃ID范围视图（不分配内存）\nEN:Get non-owning view of active IDs (no allocation)
+         */
+        ActiveIDRange GetActiveIDs() const
+        {
+            return data_manager.GetActiveIDs();
+        }
+
         /**
          * @brief CN:通过ID直接访问数据\nEN:Direct data access by ID
          */
@@ -607,7 +756,7 @@ namespace hgl
 
         const T* At(int id) const
         {
-            return const_cast<ThisClass*>(this)->data_manager.At(id);
+            return data_manager.At(id);
         }
     };
 
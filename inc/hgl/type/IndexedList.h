@@ -11,10 +11,14 @@ namespace hgl
 {
     // AI NOTE: Keeps data in a dense array while exposing stable logical indices
     // via a separate index list. Data moves but index mapping updates.
+    // Reorder() physically permutes data back into logical order; an optional
+    // churn threshold triggers it automatically.
     /**
     * 索引数据列表<br>
     * IndexedList与ValueArray功能类似，但它的区别是它使用索引来访问数据。
-    * 当数据被移动、删除、排序时，数据本身的内存并不会变动，只会调整索引。
+    * 当数据被移动、删除、排序时，数据本身的内存并不会变动，只会调整索引。<br>
+    * 多次调整后按逻辑顺序遍历会变成对data_array的随机访问，可调用Reorder()/Defragment()
+    * 把数据按逻辑顺序重新排列，或用SetAutoReorder()设置在一定的逻辑变动量后自动整理。
     */
     template<typename T,typename I=int32> class IndexedList
     {
@@ -25,6 +29,23 @@ namespace hgl
         std::vector<I> data_index;
         Stack<I> free_index;
 
+        int32 auto_reorder_threshold=0;         ///<自动重排的逻辑变动量阈值(0为不自动重排)
+        int32 churn_count=0;                    ///<上次重排后的逻辑变动量
+
+        /**
+        * 记录逻辑变动(复用空位、插入、删除、交换)，达到阈值时自动重排
+        */
+        void OnChurn(int32 n)
+        {
+            if(auto_reorder_threshold<=0||n<=0)
+                return;
+
+            churn_count+=n;
+
+            if(churn_count>=auto_reorder_threshold)
+                Reorder();
+        }
+
     public: //属性
 
         const int32     GetAllocCount   ()const{return (int32)data_array.capacity();}
@@ -188,7 +209,9 @@ namespace hgl
                 free_index.Pop(index);
                 data_index.push_back(index);
 
-                return &data_array[index];
+                OnChurn(1);
+
+                return &data_array[data_index.back()];
             }
         }
 
@@ -207,15 +230,18 @@ namespace hgl
 
                 data_array.resize(index + 1);
                 data_index.push_back(index);
+                memcpy(&data_array[index], &data, sizeof(T));
             }
             else
             {
                 free_index.Pop(index);
                 data_index.push_back(index);
+                memcpy(&data_array[index], &data, sizeof(T));
+
+                OnChurn(1);
             }
 
-            memcpy(&data_array[index], &data, sizeof(T));
-            return index;
+            return data_index.back();
         }
 
         /**
@@ -253,6 +279,8 @@ namespace hgl
                 result=mc;
             }
 
+            const int32 reused=result;
+
             //剩余空间没了
 
             if(n>0) //如果还有，那就整段添加吧
@@ -270,6 +298,8 @@ namespace hgl
                 result+=n;
             }
 
+            OnChurn(reused);
+
             return result;
         }
 
@@ -278,6 +308,7 @@ namespace hgl
             data_array.clear();
             data_index.clear();
             free_index.Clear();
+            churn_count=0;
         }
 
         virtual void Free()
@@ -290,6 +321,7 @@ namespace hgl
             data_index.clear();
             data_index.shrink_to_fit();
             free_index.Free();
+            churn_count=0;
         }
 
         const bool IsValidIndex(const int32 index)const
@@ -321,6 +353,8 @@ namespace hgl
             }
 
             memcpy(&data_array[index], &value, sizeof(T));
+
+            OnChurn(1);
             return true;
         }
 
@@ -344,6 +378,8 @@ namespace hgl
                 free_index.Push(data_index[i]);
 
             data_index.erase(data_index.begin() + start, data_index.begin() + start + count);
+
+            OnChurn(count);
             return count;
         }
 
@@ -354,6 +390,7 @@ namespace hgl
 
             hgl_swap(data_index[a],data_index[b]);
 
+            OnChurn(1);
             return true;
         }
 
@@ -457,46 +494,85 @@ namespace hgl
             return(true);
         }
 
+        /**
+        * 按逻辑顺序重新排列数据<br>
+        * 将data_array按当前索引顺序重新排列，索引重建为0..n-1，并清空空闲位置，
+        * 之后按逻辑顺序遍历即为顺序内存访问。保留data_array已分配的容量。
+        * @warning 之前通过Add()等取得的数据指针会失效
+        */
         virtual void Reorder()
         {
+            churn_count=0;
+
             const int count=(int)data_index.size();
 
-            if(count<=0)return;
+            if(!IsOrdered())
+            {
+                std::vector<T> temp_array(count);
 
-            if(IsOrdered())         //顺序没问题
-                return;
+                int i = 0;
+                while (i < count)
+                {
+                    int start = i; // 当前连续块的起始位置
+                    int end = i;   // 当前连续块的结束位置
 
-            std::vector<T> temp_array(count);
+                    // 检查后续索引是否是连续的正确顺序
+                    while (end + 1 < count && data_index[end + 1] == data_index[end] + 1)
+                    {
+                        ++end;
+                    }
 
-            int i = 0;
-            while (i < count)
-            {
-                int start = i; // 当前连续块的起始位置
-                int end = i;   // 当前连续块的结束位置
+                    // 批量复制连续块的数据
+                    int length = end - start + 1;
+                    memcpy(temp_array.data()+start, data_array.data() + data_index[start], length * sizeof(T));
 
-                // 检查后续索引是否是连续的正确顺序
-                while (end + 1 < count && data_index[end + 1] == data_index[end] + 1)
-                {
-                    ++end;
+                    // 更新索引
+                    i = end + 1;
                 }
 
-                // 批量复制连续块的数据
-                int length = end - start + 1;
-                memcpy(temp_array.data()+start, data_array.data() + data_index[start], length * sizeof(T));
+                // 将临时数组的数据复制回 data_array
+                memcpy(data_array.data(), temp_array.data(), count * sizeof(T));
 
-                // 更新索引
-                i = end + 1;
+                // 更新 data_index，使其与 data_array 的顺序一致
+                for (int i = 0; i < count; ++i)
+                {
+                    data_index[i] = i;
+                }
             }
 
-            // 将临时数组的数据复制回 data_array
-            memcpy(data_array.data(), temp_array.data(), count * sizeof(T));
+            // 索引已是0..n-1，其余位置都是空闲的，全部丢弃
+            data_array.resize(count);
+            free_index.Clear();
+        }
 
-            // 更新 data_index，使其与 data_array 的顺序一致
-            for (int i = 0; i < count; ++i)
+        /**
+        * 整理碎片：按逻辑顺序重新排列数据，并释放多余的内存
+        */
+        virtual void Defragment()
+        {
+            Reorder();
+
+            if constexpr (!std::is_array_v<T>)
             {
-                data_index[i] = i;
+                data_array.shrink_to_fit();
             }
+            data_index.shrink_to_fit();
+            free_index.Free();
         }
+
+        /**
+        * 设置自动重排<br>
+        * 复用空位、插入、删除、交换都计为逻辑变动，累计达到阈值时自动调用Reorder()
+        * @param churn_threshold 逻辑变动量阈值，0为关闭
+        */
+        void SetAutoReorder(const int32 churn_threshold)
+        {
+            auto_reorder_threshold=churn_threshold>0?churn_threshold:0;
+            churn_count=0;
+        }
+
+        const int32 GetAutoReorder()const{return auto_reorder_threshold;}
+        const int32 GetChurnCount()const{return churn_count;}
     };//template<typename T> class IndexedList
 
     /**
@@ -786,8 +862,12 @@ namespace hgl
         {
             const int count = (int)data_index.size();
 
-            if (count <= 0) return;
-            if (IsOrdered()) return;
+            if (IsOrdered())
+            {
+                byte_storage.resize((size_t)count * sizeof(ArrayType));
+                free_index.Clear();
+                return;
+            }
 
             std::vector<uint8_t> temp_storage(count * sizeof(ArrayType));
 
@@ -818,6 +898,18 @@ namespace hgl
             {
                 data_index[i] = i;
             }
+
+            byte_storage.resize((size_t)count * sizeof(ArrayType));
+            free_index.Clear();
+        }
+
+        void Defragment()
+        {
+            Reorder();
+
+            byte_storage.shrink_to_fit();
+            data_index.shrink_to_fit();
+            free_index.Free();
         }
 
         bool Clear()
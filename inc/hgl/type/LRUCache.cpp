@@ -7,9 +7,10 @@ namespace hgl
     /**
     * 本类构造函数
     * @param value 缓冲区最大数据量
+    * @param cost 缓冲区最大总开销(<=0表示不按开销淘汰)
     */
     template<typename F,typename T>
-    LRUCache<F,T>::LRUCache(int value)
+    LRUCache<F,T>::LRUCache(int value,int64 cost)
     {
         if(value<=0)
         {
@@ -21,14 +22,22 @@ namespace hgl
         count=0;
         alloc_count=value;
 
+        total_cost=0;
+        max_cost=cost;
+
         start_item=nullptr;
         end_item=nullptr;
+
+        free_item=nullptr;
     }
 
     template<typename F,typename T>
     LRUCache<F,T>::~LRUCache()
     {
         Clear();
+
+        for(LruItem *block:item_blocks)
+            delete[] block;
     }
 
     template<typename F,typename T>
@@ -42,6 +51,64 @@ namespace hgl
             alloc_count=value;
     }
 
+    template<typename F,typename T>
+    void LRUCache<F,T>::SetMaxCost(int64 cost)
+    {
+        max_cost=cost;
+
+        if(max_cost<=0)return;
+
+        while(count>1&&total_cost>max_cost)ClearEnd();          //超出总开销上限，清除最旧的数据(至少保留一个)
+    }
+
+    /**
+    * 从节点池中取得一个节点，没有空闲节点时按块分配一批新节点
+    */
+    template<typename F,typename T>
+    LRUCacheItem<F,T> *LRUCache<F,T>::AllocItem()
+    {
+        if(!free_item)
+        {
+            int block_size=count;                   //每块节点数量随已用数量倍增
+
+            if(block_size<16)block_size=16;else
+            if(block_size>4096)block_size=4096;
+
+            if(block_size>alloc_count&&alloc_count>=16)
+                block_size=alloc_count;
+
+            LruItem *block=new LruItem[block_size];
+
+            item_blocks.push_back(block);
+
+            for(int i=0;i<block_size-1;i++)
+                block[i].next=block+i+1;
+
+            block[block_size-1].next=nullptr;
+
+            free_item=block;
+        }
+
+        LruItem *item=free_item;
+
+        free_item=item->next;
+
+        return item;
+    }
+
+    template<typename F,typename T>
+    void LRUCache<F,T>::FreeItem(LruItem *item)
+    {
+        item->key=F();                  //节点进入节点池前释放数据，避免被淘汰的数据一直占用资源
+        item->value=T();
+        item->cost=0;
+
+        item->prev=nullptr;
+        item->next=free_item;
+
+        free_item=item;
+    }
+
     template<typename F,typename T>
     bool LRUCache<F,T>::Create(const F &,T &)
     {
@@ -60,7 +127,10 @@ namespace hgl
 
         Clear(end_item->key,end_item->value);
 
-        delete end_item;
+        item_map.erase(end_item->key);
+        total_cost-=end_item->cost;
+
+        FreeItem(end_item);
 
         end_item=temp;
 
@@ -84,17 +154,44 @@ namespace hgl
     * 添加一个数据
     * @param key 数据标识
     * @param value 数据
+    * @return 数据所在节点(如key已存在，则替换原数据并移到最前面)
     */
     template<typename F,typename T>
     LRUCacheItem<F,T> *LRUCache<F,T>::Add(const F &key,const T &value)
     {
         LruItem *temp;
 
-        while(count>=alloc_count)ClearEnd();          //满了，清除超出的数据
+        const int64 cost=GetCost(key,value);
+
+        {
+            auto it=item_map.find(key);
+
+            if(it!=item_map.end())                  //已存在，替换数据
+            {
+                temp=it->second;
+
+                Clear(temp->key,temp->value);
+
+                total_cost+=cost-temp->cost;
+
+                temp->value=value;
+                temp->cost=cost;
+
+                MoveToStart(temp);
+
+                if(max_cost>0)
+                    while(count>1&&total_cost>max_cost)ClearEnd();
+
+                return(temp);
+            }
+        }
+
+        while(IsOverflow(cost))ClearEnd();          //满了，清除超出的数据
 
-        temp=new LruItem;
+        temp=AllocItem();
         temp->key=key;
         temp->value=value;
+        temp->cost=cost;
 
         temp->prev=nullptr;
         temp->next=start_item;
@@ -104,7 +201,10 @@ namespace hgl
 
         start_item=temp;                //将当前数据设成start_item
 
+        item_map.emplace(key,temp);
+
         count++;
+        total_cost+=cost;
 
         if(!end_item)
         {
@@ -168,25 +268,19 @@ namespace hgl
     {
         if(count<=0)return(false);
 
-        int n=count;
-        LruItem *temp=start_item;
+        auto it=item_map.find(key);
 
-        while(n--)
-        {
-            if(temp->key==key)
-            {
-                value=temp->value;
+        if(it==item_map.end())
+            return(false);
 
-                if(mts)
-                    MoveToStart(temp);
+        LruItem *temp=it->second;
 
-                return(true);
-            }
-            else
-                temp=temp->next;
-        }
+        value=temp->value;
 
-        return(false);
+        if(mts)
+            MoveToStart(temp);
+
+        return(true);
     }
 
     /**
@@ -202,8 +296,6 @@ namespace hgl
         if(Find(key,value,mts))
             return(true);
 
-        while(count>=alloc_count)ClearEnd();          //满了，清除超出的数据
-
         if(Create(key,value))
         {
             Add(key,value);
@@ -233,7 +325,7 @@ namespace hgl
 
             temp=obj->next;
 
-            delete obj;
+            FreeItem(obj);
             n++;
         }
 
@@ -242,7 +334,10 @@ namespace hgl
             LogError(OS_TEXT("LRUCache Count=")+OSString(count)+OS_TEXT(",Clear=")+OSString(n));
         }
 
+        item_map.clear();
+
         count=0;
+        total_cost=0;
         start_item=nullptr;
         end_item=nullptr;
     }
@@ -282,7 +377,10 @@ namespace hgl
             end_item=nullptr;
         }
 
-        delete obj;
+        item_map.erase(obj->key);
+        total_cost-=obj->cost;
+
+        FreeItem(obj);
 
         count--;
     }
@@ -292,19 +390,10 @@ namespace hgl
     {
         if(count<=0)return;
 
-        int n=count;
-        LruItem *temp=start_item;
-
-        while(n--)
-        {
-            if(temp->key==key)
-            {
-                Delete(temp);
-                return;
-            }
+        auto it=item_map.find(key);
 
-            temp=temp->next;
-        }
+        if(it!=item_map.end())
+            Delete(it->second);
     }
 
     template<typename F,typename T>
@@ -1,6 +1,8 @@
 ﻿#pragma once
 
 #include<hgl/type/ValueArray.h>
+#include<ankerl/unordered_dense.h>
+#include<vector>
 namespace hgl
 {
     template<typename F,typename T> struct LRUCacheItem
@@ -9,6 +11,8 @@ namespace hgl
 
         T value;                        //数据
 
+        int64 cost;                     //数据开销(如字节数，由GetCost计算)
+
         LRUCacheItem<F,T>   *prev,      //前一数据
                             *next;      //后一数据
     };//template<typename F,typename T> struct LRUCacheItem
@@ -16,7 +20,11 @@ namespace hgl
     /**
     * 最近使用数据缓冲区管理模板(当缓冲区满时，将最长时间没有使用的清除)<br>
     * 现这个模板使用双头链表，每次添加或使用的数据会被移到链表的最前端。<br>
-    * 这样使用率最低的数据会被存在链表的最末端，当缓冲区满时，最末端的数据将会被清除。
+    * 这样使用率最低的数据会被存在链表的最末端，当缓冲区满时，最末端的数据将会被清除。<br>
+    * <br>
+    * 数据项另有一个key到节点的哈希索引，Find/Get/DeleteByKey均为O(1)。<br>
+    * 节点从内部节点池中成块分配，释放的节点进入空闲链表复用，不会每项单独new/delete。<br>
+    * 如果重载GetCost并调用SetMaxCost设置了总开销上限，则除了数量上限外，还会按总开销(如字节数)淘汰数据。
     */
     template<typename F,typename T> class LRUCache                                                  ///缓冲区管理模板(以最终使用时间为基准)
     {
@@ -31,10 +39,21 @@ namespace hgl
 
         int count,alloc_count;
 
+        int64 total_cost,max_cost;  //当前总开销/总开销上限(max_cost<=0表示不按开销淘汰)
+
+        ankerl::unordered_dense::map<F,LruItem *> item_map;     //key到节点的索引
+
+        std::vector<LruItem *> item_blocks;                     //节点池中已分配的块
+        LruItem *free_item;                                     //空闲节点链表(以next串联)
+
     protected:
 
         virtual bool Create(const F &,T &);                                                         ///<创建数据
         virtual void Clear(const F &,T &);                                                          ///<清除数据
+        virtual int64 GetCost(const F &,const T &){return 1;}                                       ///<计算数据开销(用于按总开销淘汰)
+
+                LruItem *AllocItem();                                                               ///<从节点池中取得一个节点
+                void FreeItem(LruItem *);                                                           ///<将节点归还节点池
 
                 void MoveToStart(LruItem *);                                                        ///<移动某一个数据到最前面
 
@@ -42,6 +61,13 @@ namespace hgl
 
                 void ClearEnd();                                                                    ///<清除最后一个数据
 
+                bool IsOverflow(const int64 new_cost)const                                          ///<再加入一个指定开销的数据是否会超出上限
+                {
+                    if(count>=alloc_count)return(true);
+                    if(max_cost>0&&count>0&&total_cost+new_cost>max_cost)return(true);
+                    return(false);
+                }
+
     public:
 
                 const   int     GetCount        ()const{return count;}                              ///<取得当前有多少数据
@@ -49,20 +75,25 @@ namespace hgl
         virtual         void    Realloc         (int);                                              ///<设置已分配空间容量
                         int     GetFreeCount    ()const{return alloc_count-count;}                  ///<取得当前缓冲区剩于量
 
+                const   int64   GetTotalCost    ()const{return total_cost;}                         ///<取得当前数据总开销
+                const   int64   GetMaxCost      ()const{return max_cost;}                           ///<取得总开销上限
+                        void    SetMaxCost      (int64);                                            ///<设置总开销上限(<=0表示不限制)
+
     public:
 
-        LRUCache(int);
+        LRUCache(int,int64=0);
         virtual ~LRUCache();
 
-        virtual LruItem *       Add     (const F &,const T &);                                      ///<增加一个数据
+        virtual LruItem *       Add     (const F &,const T &);                                      ///<增加一个数据(如key已存在则替换数据)
         virtual bool            Find    (const F &,T &,bool=true);                                  ///<取得一个数据(如果没有不会自动创建)
         virtual bool            Get     (const F &,T &,bool=true);                                  ///<取得一个数据(如果没有会自动创建)
+                bool            Contains(const F &key)const{return item_map.find(key)!=item_map.end();} ///<是否存在指定数据
                 void            Clear   ();                                                         ///<清除所有数据
                 LruItem *       GetEnd  (bool mts=true)                                             ///<取最后一项
                 {
                     LruItem *obj=end_item;
 
-                    if(mts)
+                    if(mts&&obj)
                         MoveToStart(obj);
 
                     return(obj);
@@ -6,14 +6,128 @@
 
 #include <type_traits>
 #include <vector>
+#include <bit>
 #include <hgl/util/hash/QuickHash.h>
 #include <hgl/type/ActiveDataManager.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace hgl
 {
+    /**
+     * 线性探测集合的探测方式
+     */
+    enum class LinearProbeMode
+    {
+        Scalar,         ///<逐槽位探测，删除留下墓碑
+        Group,          ///<控制字节+7位哈希指纹，每次SIMD比较16个槽位(Swiss-table方式)，删除尽量直接置空
+        RobinHood,      ///<Robin Hood插入+后移删除，表中永远没有墓碑
+    };
+
+    /**
+     * 探测长度统计(用于调整max_load_factor)
+     * 探测长度为元素实际位置距其初始位置的距离：Scalar/RobinHood模式按槽位计，Group模式按组计，0表示就在初始位置
+     */
+    struct LinearProbeStats
+    {
+        int count = 0;                  ///<元素数量
+        int capacity = 0;               ///<槽位数量
+        int tombstones = 0;             ///<墓碑数量
+        double mean = 0;                ///<平均探测长度
+        int max = 0;                    ///<最大探测长度
+        std::vector<int> histogram;     ///<histogram[n]为探测长度为n的元素数量
+
+        float GetLoadFactor() const { return capacity > 0 ? float(count + tombstones) / float(capacity) : 0; }
+    };
+
+    /**
+     * 16个控制字节组成的探测组，用SSE2/NEON一次比较整组
+     */
+    struct LinearProbeGroup
+    {
+        static constexpr int WIDTH = 16;
+
+        static constexpr int8 CTRL_EMPTY = -128;        ///<空槽位(最高位为1)
+        static constexpr int8 CTRL_DELETED = -2;        ///<墓碑(最高位为1)
+                                                        ///<有效槽位为0~127的哈希指纹
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        __m128i ctrl;
+
+        explicit LinearProbeGroup(const int8 *p) : ctrl(_mm_loadu_si128((const __m128i *)p)) {}
+
+        uint32 Match(int8 h2) const
+        {
+            return (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl));
+        }
+
+        uint32 MatchEmpty() const { return Match(CTRL_EMPTY); }
+
+        uint32 MatchEmptyOrDeleted() const
+        {
+            return (uint32)_mm_movemask_epi8(ctrl);
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        int8x16_t ctrl;
+
+        explicit LinearProbeGroup(const int8 *p) : ctrl(vld1q_s8(p)) {}
+
+        static uint32 ToMask(uint8x16_t m)
+        {
+            static const uint8 bit[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+
+            const uint8x16_t b = vandq_u8(m, vld1q_u8(bit));
+
+            return (uint32)vaddv_u8(vget_low_u8(b)) | ((uint32)vaddv_u8(vget_high_u8(b)) << 8);
+        }
+
+        uint32 Match(int8 h2) const { return ToMask(vceqq_s8(ctrl, vdupq_n_s8(h2))); }
+
+        uint32 MatchEmpty() const { return Match(CTRL_EMPTY); }
+
+        uint32 MatchEmptyOrDeleted() const { return ToMask(vcltq_s8(ctrl, vdupq_n_s8(0))); }
+#else
+        const int8 *ctrl;
+
+        explicit LinearProbeGroup(const int8 *p) : ctrl(p) {}
+
+        uint32 Match(int8 h2) const
+        {
+            uint32 result = 0;
+
+            for (int i = 0; i < WIDTH; i++)
+                if (ctrl[i] == h2)
+                    result |= 1u << i;
+
+            return result;
+        }
+
+        uint32 MatchEmpty() const { return Match(CTRL_EMPTY); }
+
+        uint32 MatchEmptyOrDeleted() const
+        {
+            uint32 result = 0;
+
+            for (int i = 0; i < WIDTH; i++)
+                if (ctrl[i] < 0)
+                    result |= 1u << i;
+
+            return result;
+        }
+#endif
+    };
+
     // AI NOTE: Open-addressing hash set with linear probing and tombstones.
     // Uses ActiveDataManager to store values; table size is power of two.
     // Rehash when load factor exceeded; deletes leave tombstones.
+    // MODE=Group: Swiss-table style control bytes (7-bit fingerprints),
+    // probed 16 at a time with SSE2/NEON; deletes mark empty when safe.
+    // MODE=RobinHood: displacement-ordered insertion, backward-shift delete,
+    // no tombstones. GetProbeStats() reports probe lengths for any mode.
     /**
      * 【线性探测集合 LinearProbeSet】
      *
@@ -49,18 +163,44 @@ namespace hgl
      *  • 缓存友好度: 最优（线性内存访问）
      *  • 内存占用: 最小（无额外结构）
      *
+     * 【Group探测模式】LinearProbeSet<T,LinearProbeMode::Group>
+     *  • 另有一个控制字节数组，每个槽位一字节：空(0x80)、墓碑(0xFE)、或哈希高7位指纹(0~127)
+     *  • 查找时一次用SSE2/NEON比较16个控制字节，只有指纹相同的槽位才去比较哈希和数据
+     *  • 组内只要有空槽位即可判定不存在，未命中的查找通常只需读取一组控制字节
+     *  • 按组三角探测(步长16,32,48...)，可遍历全部组
+     *  • 删除时若该槽位两侧16字节窗口内有空槽位，则直接置空，否则才留下墓碑
+     *  • 墓碑计入负载，墓碑过多时原地重建(不扩容)
+     *  • 无SSE2/NEON的平台退化为逐字节比较
+     *
+     * 【RobinHood模式】LinearProbeSet<T,LinearProbeMode::RobinHood>
+     *  • 插入时若遇到比自己离初始位置更近的元素，就与其交换，继续为被换出的元素找位置
+     *  • 各元素探测长度趋于平均，最大探测长度远小于Scalar模式
+     *  • 查找时遇到离初始位置比当前探测距离更近的元素即可判定不存在
+     *  • 删除采用后移删除(backward-shift)：后续元素前移填补，表中永远没有墓碑，无需RehashToFit()
+     *
      * 【配置】
      *  • SetMaxLoadFactor(f): 重哈希阈值(0.1~0.95)
      *  • RehashToFit(): 手动清理墓碑并压缩
+     *  • GetProbeStats(): 探测长度统计(平均/最大/直方图)，可依据实际数据调整负载因子
+     *  • Compact()/CompactStep(n): 压缩数据存储，回收已删除元素占用的空洞(槽位中的ID同步更新)
      *
      * 【注意】
-     *  • 大量删除后需要定期调用RehashToFit()清理墓碑
-     *  • 否则查找性能会因墓碑积累而退化
+     *  • Scalar模式大量删除后需要定期调用RehashToFit()清理墓碑
+     *  • 否则查找性能会因墓碑积累而退化(Group模式会自动处理)
+     *  • 未命中查询为主的场景推荐使用Group模式
      */
-    template<typename T>
+    template<typename T, LinearProbeMode MODE = LinearProbeMode::Scalar>
     class LinearProbeSet
     {
     protected:
+        static constexpr bool GROUP_PROBE = (MODE == LinearProbeMode::Group);
+
+        static constexpr bool ROBIN_HOOD = (MODE == LinearProbeMode::RobinHood);
+
+        static constexpr int GROUP_WIDTH = LinearProbeGroup::WIDTH;
+
+        static constexpr int MIN_CAPACITY = GROUP_PROBE ? GROUP_WIDTH : 8;
+
         struct Slot
         {
             int id = -1;       // -1 空槽位, -2 墓碑
@@ -72,16 +212,45 @@ namespace hgl
         int active_slots = 0;
         float max_load_factor = 0.7f;
 
+        std::vector<int8> ctrl;         ///<Group模式的控制字节(长度为容量+GROUP_WIDTH，尾部镜像开头GROUP_WIDTH个字节以便跨越表尾整组读取)
+        int deleted_slots = 0;          ///<Group模式的墓碑数量
+
         int Capacity() const
         {
             return (int)table.size();
         }
 
+        /**
+         * 槽位pos上哈希值为hash的元素距其初始位置的距离
+         */
+        int ProbeDistance(int pos, uint64 hash) const
+        {
+            return (pos - (int)(hash & (uint64)(Capacity() - 1))) & (Capacity() - 1);
+        }
+
+        static uint64 HashOf(const T &value)
+        {
+            return ComputeOptimalHash(value) * 0x9E3779B97F4A7C15ull;  // 再混合一次，避免弱哈希(如小整数)高位全为0导致指纹全部相同
+        }
+
+        static int8 H2(uint64 hash)
+        {
+            return (int8)(hash >> 57);                  // 高7位做指纹，低位用于定位，两者互不相关
+        }
+
+        void SetCtrl(int pos, int8 value)
+        {
+            ctrl[pos] = value;
+
+            if (pos < GROUP_WIDTH)
+                ctrl[Capacity() + pos] = value;
+        }
+
         void EnsureCapacity(int desired)
         {
             if (Capacity() >= desired)
                 return;
-            int new_cap = 8;
+            int new_cap = MIN_CAPACITY;
             while (new_cap < desired)
                 new_cap <<= 1;
             Rehash(new_cap);
@@ -94,6 +263,12 @@ namespace hgl
             table.resize(new_capacity);
             active_slots = 0;
 
+            if constexpr (GROUP_PROBE)
+            {
+                ctrl.assign(new_capacity + GROUP_WIDTH, LinearProbeGroup::CTRL_EMPTY);
+                deleted_slots = 0;
+            }
+
             for (const auto &slot : old)
             {
                 if (slot.id >= 0 && data_manager.IsActive(slot.id))
@@ -104,9 +279,24 @@ namespace hgl
         void MaybeGrow()
         {
             if (Capacity() == 0)
-                EnsureCapacity(8);
-            if (active_slots + 1 > (int)(Capacity() * max_load_factor))
-                Rehash(Capacity() * 2);
+                EnsureCapacity(MIN_CAPACITY);
+
+            if constexpr (GROUP_PROBE)
+            {
+                if (active_slots + deleted_slots + 1 > (int)(Capacity() * max_load_factor))
+                {
+                    // 主要被墓碑占满时原地重建即可，不必扩容
+                    if (deleted_slots >= active_slots / 2)
+                        Rehash(Capacity());
+                    else
+                        Rehash(Capacity() * 2);
+                }
+            }
+            else
+            {
+                if (active_slots + 1 > (int)(Capacity() * max_load_factor))
+                    Rehash(Capacity() * 2);
+            }
         }
 
         void InsertSlot(int id, uint64 hash)
@@ -114,6 +304,59 @@ namespace hgl
             int cap = Capacity();
             int pos = (int)(hash & (uint64)(cap - 1));
 
+            if constexpr (GROUP_PROBE)
+            {
+                // 按组三角探测，可遍历所有组
+                for (int step = GROUP_WIDTH;; step += GROUP_WIDTH)
+                {
+                    const uint32 mask = LinearProbeGroup(ctrl.data() + pos).MatchEmptyOrDeleted();
+
+                    if (mask)
+                    {
+                        pos = (pos + std::countr_zero(mask)) & (cap - 1);
+
+                        if (ctrl[pos] == LinearProbeGroup::CTRL_DELETED)
+                            --deleted_slots;
+
+                        SetCtrl(pos, H2(hash));
+                        table[pos].id = id;
+                        table[pos].hash = hash;
+                        ++active_slots;
+                        return;
+                    }
+
+                    pos = (pos + step) & (cap - 1);
+                }
+            }
+
+            if constexpr (ROBIN_HOOD)
+            {
+                // 遇到比自己离初始位置更近的元素就抢占它的位置，被挤出的元素继续向后找
+                Slot item{id, hash};
+
+                for (int dist = 0;; dist++)
+                {
+                    Slot &slot = table[pos];
+
+                    if (slot.id == -1)
+                    {
+                        slot = item;
+                        ++active_slots;
+                        return;
+                    }
+
+                    const int slot_dist = ProbeDistance(pos, slot.hash);
+
+                    if (slot_dist < dist)
+                    {
+                        std::swap(slot, item);
+                        dist = slot_dist;
+                    }
+
+                    pos = (pos + 1) & (cap - 1);
+                }
+            }
+
             while (true)
             {
                 Slot &slot = table[pos];
@@ -129,14 +372,64 @@ namespace hgl
             }
         }
 
-        int FindID(const T &value) const
+        /**
+         * 查找值所在的槽位
+         * @return 槽位下标，不存在返回-1
+         */
+        int FindSlot(const T &value, uint64 hash) const
         {
             if (Capacity() == 0)
                 return -1;
 
-            uint64 hash = ComputeOptimalHash(value);
             int cap = Capacity();
             int pos = (int)(hash & (uint64)(cap - 1));
+
+            if constexpr (GROUP_PROBE)
+            {
+                const int8 h2 = H2(hash);
+
+                for (int step = GROUP_WIDTH; step <= cap; step += GROUP_WIDTH)
+                {
+                    const LinearProbeGroup group(ctrl.data() + pos);
+
+                    for (uint32 mask = group.Match(h2); mask; mask &= mask - 1)
+                    {
+                        const int index = (pos + std::countr_zero(mask)) & (cap - 1);
+                        const Slot &slot = table[index];
+
+                        if (slot.hash == hash && *data_manager.At(slot.id) == value)
+                            return index;
+                    }
+
+                    // 组内有空槽位，说明不存在
+                    if (group.MatchEmpty())
+                        return -1;
+
+                    pos = (pos + step) & (cap - 1);
+                }
+
+                return -1;
+            }
+
+            if constexpr (ROBIN_HOOD)
+            {
+                for (int dist = 0; dist < cap; dist++)
+                {
+                    const Slot &slot = table[pos];
+
+                    // 空槽位，或当前元素比要找的值离初始位置更近，说明不存在
+                    if (slot.id == -1 || ProbeDistance(pos, slot.hash) < dist)
+                        return -1;
+
+                    if (slot.hash == hash && *data_manager.At(slot.id) == value)
+                        return pos;
+
+                    pos = (pos + 1) & (cap - 1);
+                }
+
+                return -1;
+            }
+
             int start_pos = pos;
             bool first = true;
 
@@ -161,7 +454,7 @@ namespace hgl
                 {
                     T existing;
                     if (data_manager.GetData(existing, slot.id) && existing == value)
-                        return slot.id;
+                        return pos;
                 }
 
                 pos = (pos + 1) & (cap - 1);
@@ -170,6 +463,131 @@ namespace hgl
             return -1;
         }
 
+        int FindID(const T &value) const
+        {
+            const int pos = FindSlot(value, HashOf(value));
+
+            return pos < 0 ? -1 : table[pos].id;
+        }
+
+        /**
+         * 按ID查找槽位(压缩时更新槽位中的ID用)
+         */
+        int FindSlotByID(int id, uint64 hash) const
+        {
+            const int cap = Capacity();
+
+            if (cap == 0)
+                return -1;
+
+            int pos = (int)(hash & (uint64)(cap - 1));
+
+            if constexpr (GROUP_PROBE)
+            {
+                const int8 h2 = H2(hash);
+
+                for (int step = GROUP_WIDTH; step <= cap; step += GROUP_WIDTH)
+                {
+                    const LinearProbeGroup group(ctrl.data() + pos);
+
+                    for (uint32 mask = group.Match(h2); mask; mask &= mask - 1)
+                    {
+                        const int index = (pos + std::countr_zero(mask)) & (cap - 1);
+
+                        if (table[index].id == id)
+                            return index;
+                    }
+
+                    if (group.MatchEmpty())
+                        return -1;
+
+                    pos = (pos + step) & (cap - 1);
+                }
+
+                return -1;
+            }
+
+            for (int n = 0; n < cap; n++)
+            {
+                const Slot &slot = table[pos];
+
+                if (slot.id == -1)
+                    return -1;
+
+                if (slot.id == id)
+                    return pos;
+
+                pos = (pos + 1) & (cap - 1);
+            }
+
+            return -1;
+        }
+
+        void EraseSlot(int pos)
+        {
+            --active_slots;
+
+            if constexpr (GROUP_PROBE)
+            {
+                const int cap = Capacity();
+
+                // 如果包含pos的任意16字节窗口内都有空槽位，则没有探测序列越过pos，可以直接置空
+                const uint32 empty_before = LinearProbeGroup(ctrl.data() + ((pos - GROUP_WIDTH) & (cap - 1))).MatchEmpty();
+                const uint32 empty_after = LinearProbeGroup(ctrl.data() + pos).MatchEmpty();
+
+                const bool was_never_full = empty_before && empty_after
+                                         && std::countr_zero(empty_after) + std::countl_zero((uint16)empty_before) < GROUP_WIDTH;
+
+                if (was_never_full)
+                    SetCtrl(pos, LinearProbeGroup::CTRL_EMPTY);
+                else
+                {
+                    SetCtrl(pos, LinearProbeGroup::CTRL_DELETED);
+                    ++deleted_slots;
+                }
+
+                table[pos].id = -1;
+            }
+            else if constexpr (ROBIN_HOOD)
+            {
+                // 后移删除：把后面不在初始位置上的元素逐个前移一格，直到遇到空槽位或在初始位置上的元素
+                const int cap = Capacity();
+                int next = (pos + 1) & (cap - 1);
+
+                while (table[next].id >= 0 && ProbeDistance(next, table[next].hash) > 0)
+                {
+                    table[pos] = table[next];
+                    pos = next;
+                    next = (next + 1) & (cap - 1);
+                }
+
+                table[pos].id = -1;
+            }
+            else
+            {
+                table[pos].id = -2; // tombstone
+            }
+        }
+
+        /**
+         * Group模式下槽位pos上的元素是探测序列中的第几组
+         */
+        int GroupProbeLength(int pos, uint64 hash) const
+        {
+            const int cap = Capacity();
+            int start = (int)(hash & (uint64)(cap - 1));
+
+            for (int n = 0, step = GROUP_WIDTH; step <= cap; n++, step += GROUP_WIDTH)
+            {
+                if (((pos - start) & (cap - 1)) < GROUP_WIDTH)
+                    return n;
+
+                start = (start + step) & (cap - 1);
+            }
+
+            return cap / GROUP_WIDTH;
+        }
+
     public:
         LinearProbeSet() = default;
         virtual ~LinearProbeSet() = default;
@@ -196,6 +614,63 @@ namespace hgl
                 max_load_factor = lf;
         }
 
+        float GetMaxLoadFactor() const
+        {
+            return max_load_factor;
+        }
+
+        /**
+         * 统计当前表中所有元素的探测长度(需遍历整个表)
+         */
+        LinearProbeStats GetProbeStats() const
+        {
+            LinearProbeStats stats;
+
+            stats.capacity = Capacity();
+
+            int64 total = 0;
+
+            for (int pos = 0; pos < stats.capacity; pos++)
+            {
+                const Slot &slot = table[pos];
+
+                if (slot.id < 0)
+                {
+                    if constexpr (GROUP_PROBE)
+                    {
+                        if (ctrl[pos] == LinearProbeGroup::CTRL_DELETED)
+                            ++stats.tombstones;
+                    }
+                    else if (slot.id == -2)
+                        ++stats.tombstones;
+
+                    continue;
+                }
+
+                int length;
+
+                if constexpr (GROUP_PROBE)
+                    length = GroupProbeLength(pos, slot.hash);
+                else
+                    length = ProbeDistance(pos, slot.hash);
+
+                if (length >= (int)stats.histogram.size())
+                    stats.histogram.resize(length + 1, 0);
+
+                ++stats.histogram[length];
+                ++stats.count;
+                total += length;
+
+                if (length > stats.max)
+                    stats.max = length;
+            }
+
+            if (stats.count > 0)
+                stats.mean = double(total) / double(stats.count);
+
+            return stats;
+        }
+
         bool Add(const T &value)
         {
             static_assert(std::is_trivially_copyable_v<T>, "Add() requires trivially copyable types.");
@@ -214,44 +689,21 @@ namespace hgl
                 return false;
             }
 
-            uint64 hash = ComputeOptimalHash(value);
+            uint64 hash = HashOf(value);
             InsertSlot(new_id, hash);
             return true;
         }
 
         bool Delete(const T &value)
         {
-            int id = FindID(value);
-            if (id == -1)
+            const int pos = FindSlot(value, HashOf(value));
+            if (pos == -1)
                 return false;
 
-            uint64 hash = ComputeOptimalHash(value);
-            int cap = Capacity();
-            int pos = (int)(hash & (uint64)(cap - 1));
-            int start_pos = pos;
-            bool first = true;
+            int id = table[pos].id;
 
-            while (first || pos != start_pos)
-            {
-                first = false;
-                Slot &slot = table[pos];
-
-                // 空槽位，不应该发生（FindID已经找到了）
-                if (slot.id == -1)
-                    return false;
-
-                // 找到对应的槽位
-                if (slot.id == id)
-                {
-                    slot.id = -2; // tombstone
-                    --active_slots;
-                    return data_manager.Release(&id, 1) > 0;
-                }
-
-                pos = (pos + 1) & (cap - 1);
-            }
-
-            return false;
+            EraseSlot(pos);
+            return data_manager.Release(&id, 1) > 0;
         }
 
         bool Contains(const T &value) const
@@ -263,38 +715,75 @@ namespace hgl
         {
             data_manager.Clear();
             table.clear();
+            ctrl.clear();
             active_slots = 0;
+            deleted_slots = 0;
         }
 
         void Free()
         {
             data_manager.Free();
             table.clear();
+            ctrl.clear();
+            ctrl.shrink_to_fit();
             active_slots = 0;
+            deleted_slots = 0;
         }
 
         template<typename F>
         void Enum(F &&func) const
         {
-            auto active_ids = data_manager.GetActiveView();
-            const int count = (int)active_ids.size();
-
-            for (int i = 0; i < count; i++)
+            data_manager.ForEachActive([&func](int, const T &value)
             {
-                int id = active_ids[i];
-                T value;
-                if (data_manager.GetData(value, id))
-                    func(value);
-            }
+                func(value);
+            });
         }
 
         void RehashToFit()
         {
             int count = GetCount();
-            int desired = 8;
+            int desired = MIN_CAPACITY;
             while (desired < (int)(count / max_load_factor) + 1)
                 desired <<= 1;
             Rehash(desired);
         }
+
+        /**
+         * 完整压缩：数据稠密排列到[0,GetCount())，并重哈希清除墓碑
+         * @return 搬移的元素数量
+         */
+        int Compact()
+        {
+            const int result = CompactStep(INT_MAX);
+
+            RehashToFit();
+            return result;
+        }
+
+        /**
+         * 增量压缩：最多搬移max_move个元素，并就地更新槽位中的ID
+         * @return 本次搬移的元素数量
+         */
+        int CompactStep(int max_move)
+        {
+            std::vector<ActiveIDRemap> moved;
+
+            const int result = data_manager.CompactStep(max_move, &moved);
+
+            for (const ActiveIDRemap &m : moved)
+            {
+                const int pos = FindSlotByID(m.old_id, HashOf(*data_manager.At(m.new_id)));
+
+                if (pos >= 0)
+                    table[pos].id = m.new_id;
+            }
+
+            return result;
+        }
+
+        bool IsCompact() const
+        {
+            return data_manager.IsCompact();
+        }
     };
 }
@@ -0,0 +1,362 @@
+﻿/**
+ * @file MagazineDepot.h
+ * @brief CN:弹匣式线程缓存对象池基础(Bonwick magazine/depot)
+ */
+#pragma once
+
+#include<hgl/type/DataType.h>
+#include<atomic>
+#include<memory>
+#include<mutex>
+#include<thread>
+#include<utility>
+#include<vector>
+
+namespace hgl
+{
+    /**
+     * 线程本地的缓存查找槽，所有MagazineDepot共用。以池的唯一编号区分，池销毁后编号不会再出现，残留的槽自然失效。
+     */
+    struct MagazineCacheSlot
+    {
+        uint64 uid;
+        void *cache;
+    };
+
+    constexpr int MAGAZINE_CACHE_SLOT_COUNT=8;                      ///<每个线程可快速查找的池数量，超出后退化为加锁查找
+
+    inline MagazineCacheSlot *GetMagazineCacheSlots()
+    {
+        thread_local MagazineCacheSlot slots[MAGAZINE_CACHE_SLOT_COUNT]{};
+
+        return slots;
+    }
+
+    inline uint64 AcquireMagazineDepotUID()
+    {
+        static std::atomic<uint64> next_uid{1};
+
+        return next_uid.fetch_add(1,std::memory_order_relaxed);
+    }
+
+    // AI NOTE: Bonwick-style magazine layer. Every thread owns a cache of two
+    // magazines (loaded/previous) of up to MAGAZINE_SIZE object pointers.
+    // Acquire/Release only touch the caller's cache; when both magazines are
+    // empty/full a whole magazine is exchanged with the shared depot under one
+    // mutex. Derived pools supply FillFromSource() to create fresh objects when
+    // the depot has no loaded magazines. Caches belong to the depot and are
+    // found per thread through a small thread_local slot table keyed by uid.
+    /**
+     * 弹匣仓库<br>
+     * 为对象池提供线程缓存层，每个线程持有两个弹匣(loaded/previous)，每个弹匣最多存放MAGAZINE_SIZE个对象指针。
+     *
+     * <b>原理：</b>
+     * - Acquire: 从loaded弹出；loaded空而previous有对象时交换两者；都为空时把previous还给仓库，从仓库换一个满弹匣
+     * - Release: 压入loaded；loaded满而previous未满时交换两者；都满时把previous交给仓库，从仓库换一个空弹匣
+     * - 仓库也没有对象时调用派生类的FillFromSource()一次装填一整个弹匣
+     * - 因为总是保留一个备用弹匣，在弹匣边界来回Acquire/Release不会反复访问仓库
+     *
+     * <b>开销：</b>
+     * - 快速路径只访问本线程的缓存(按缓存行对齐)，不加锁，不写共享缓存行
+     * - 每MAGAZINE_SIZE次操作最多一次加锁的弹匣交换
+     *
+     * <b>注意：</b>
+     * - 线程结束前应调用FlushThreadCache()，否则该线程缓存中的对象要等池销毁时才能回收
+     * - 线程缓存只属于其所有线程，其它线程看到的空闲数量是近似值
+     * - 快速路径不做重复归还检测
+     *
+     * @tparam T 对象类型，弹匣中存放T *
+     * @tparam MAGAZINE_SIZE 单个弹匣的容量
+     */
+    template<typename T,int MAGAZINE_SIZE=32> class MagazineDepot
+    {
+        static_assert(MAGAZINE_SIZE>0,"MAGAZINE_SIZE must be positive.");
+
+    protected:
+
+        struct Magazine
+        {
+            int count=0;
+            T *items[MAGAZINE_SIZE];
+
+            bool IsEmpty()const{return count==0;}
+            bool IsFull()const{return count==MAGAZINE_SIZE;}
+        };
+
+        struct alignas(64) ThreadCache
+        {
+            Magazine *loaded;
+            Magazine *previous;
+            std::thread::id owner;
+
+            std::atomic<int> idle_count{0};                         ///<本缓存中的对象数量，仅供其它线程统计读取
+
+            void UpdateIdleCount()
+            {
+                idle_count.store(loaded->count+previous->count,std::memory_order_relaxed);
+            }
+        };
+
+    protected:
+
+        const uint64 uid;
+
+        std::mutex lock;                                            ///<仓库锁，只在弹匣交换/装填时使用
+
+        std::vector<Magazine *> loaded_list;                        ///<仓库中有对象的弹匣
+        std::vector<Magazine *> empty_list;                         ///<仓库中的空弹匣
+        std::vector<std::unique_ptr<ThreadCache>> cache_list;       ///<所有线程缓存
+
+        uint64 exchange_count=0;                                    ///<弹匣交换次数
+        uint64 fill_count=0;                                        ///<从源装填次数
+
+    protected:
+
+        /**
+         * 从源创建新对象装入弹匣(仓库锁内调用)
+         * @param items 输出数组
+         * @param max_count 最多装入数量
+         * @return 实际装入数量，0表示源已耗尽
+         */
+        virtual int FillFromSource(T **items,int max_count)=0;
+
+        Magazine *NewEmptyMagazine()                                ///<取一个空弹匣(仓库锁内调用)
+        {
+            if(empty_list.empty())
+                return(new Magazine);
+
+            Magazine *m=empty_list.back();
+            empty_list.pop_back();
+            return m;
+        }
+
+        void PutMagazine(Magazine *m)                               ///<弹匣放回仓库(仓库锁内调用)
+        {
+            if(m->IsEmpty())
+                empty_list.push_back(m);
+            else
+                loaded_list.push_back(m);
+        }
+
+        ThreadCache *CreateThreadCache()
+        {
+            const std::thread::id tid=std::this_thread::get_id();
+
+            std::lock_guard<std::mutex> lg(lock);
+
+            for(const auto &tc:cache_list)
+                if(tc->owner==tid)
+                    return tc.get();
+
+            ThreadCache *tc=new ThreadCache;
+
+            tc->loaded=NewEmptyMagazine();
+            tc->previous=NewEmptyMagazine();
+            tc->owner=tid;
+
+            cache_list.emplace_back(tc);
+            return tc;
+        }
+
+        ThreadCache *GetThreadCache()
+        {
+            MagazineCacheSlot *slots=GetMagazineCacheSlots();
+
+            for(int i=0;i<MAGAZINE_CACHE_SLOT_COUNT;i++)
+                if(slots[i].uid==uid)
+                    return (ThreadCache *)slots[i].cache;
+
+            ThreadCache *tc=CreateThreadCache();
+
+            thread_local int next_slot=0;
+
+            slots[next_slot]={uid,tc};
+            next_slot=(next_slot+1)%MAGAZINE_CACHE_SLOT_COUNT;
+
+            return tc;
+        }
+
+        /**
+         * 两个弹匣都空，从仓库换一个有对象的弹匣，仓库也没有时从源装填
+         */
+        bool Reload(ThreadCache *tc)
+        {
+            std::lock_guard<std::mutex> lg(lock);
+
+            if(!loaded_list.empty())
+            {
+                empty_list.push_back(tc->previous);
+                tc->previous=tc->loaded;
+                tc->loaded=loaded_list.back();
+                loaded_list.pop_back();
+
+                ++exchange_count;
+                return(true);
+            }
+
+            tc->loaded->count=FillFromSource(tc->loaded->items,MAGAZINE_SIZE);
+
+            if(tc->loaded->IsEmpty())
+                return(false);
+
+            ++fill_count;
+            return(true);
+        }
+
+        /**
+         * 两个弹匣都满，把previous交给仓库并换回一个空弹匣
+         */
+        void Unload(ThreadCache *tc)
+        {
+            std::lock_guard<std::mutex> lg(lock);
+
+            loaded_list.push_back(tc->previous);
+            tc->previous=tc->loaded;
+            tc->loaded=NewEmptyMagazine();
+
+            ++exchange_count;
+        }
+
+        T *AcquireFromCache()
+        {
+            ThreadCache *tc=GetThreadCache();
+
+            if(tc->loaded->IsEmpty())
+            {
+                if(!tc->previous->IsEmpty())
+                    std::swap(tc->loaded,tc->previous);
+                else
+                if(!Reload(tc))
+                    return(nullptr);
+            }
+
+            T *obj=tc->loaded->items[--tc->loaded->count];
+
+            tc->UpdateIdleCount();
+            return obj;
+        }
+
+        void ReleaseToCache(T *obj)
+        {
+            ThreadCache *tc=GetThreadCache();
+
+            if(tc->loaded->IsFull())
+            {
+                if(!tc->previous->IsFull())
+                    std::swap(tc->loaded,tc->previous);
+                else
+                    Unload(tc);
+            }
+
+            tc->loaded->items[tc->loaded->count++]=obj;
+
+            tc->UpdateIdleCount();
+        }
+
+        /**
+         * 遍历仓库与所有线程缓存中的空闲对象(仅限池销毁等没有其它线程访问时使用)
+         */
+        template<typename F> void EnumIdle(F &&func)
+        {
+            for(Magazine *m:loaded_list)
+                for(int i=0;i<m->count;i++)
+                    func(m->items[i]);
+
+            for(const auto &tc:cache_list)
+            {
+                for(int i=0;i<tc->loaded->count;i++)
+                    func(tc->loaded->items[i]);
+
+                for(int i=0;i<tc->previous->count;i++)
+                    func(tc->previous->items[i]);
+            }
+        }
+
+    public:
+
+        MagazineDepot():uid(AcquireMagazineDepotUID()){}
+
+        virtual ~MagazineDepot()
+        {
+            for(Magazine *m:loaded_list)delete m;
+            for(Magazine *m:empty_list)delete m;
+
+            for(const auto &tc:cache_list)
+            {
+                delete tc->loaded;
+                delete tc->previous;
+            }
+        }
+
+        MagazineDepot(const MagazineDepot &)=delete;
+        MagazineDepot &operator=(const MagazineDepot &)=delete;
+
+        static constexpr int GetMagazineSize(){return MAGAZINE_SIZE;}
+
+        /**
+         * 把当前线程缓存中的对象全部交还仓库，线程结束前调用
+         */
+        void FlushThreadCache()
+        {
+            ThreadCache *tc=GetThreadCache();
+
+            std::lock_guard<std::mutex> lg(lock);
+
+            if(!tc->loaded->IsEmpty())
+            {
+                loaded_list.push_back(tc->loaded);
+                tc->loaded=NewEmptyMagazine();
+            }
+
+            if(!tc->previous->IsEmpty())
+            {
+                loaded_list.push_back(tc->previous);
+                tc->previous=NewEmptyMagazine();
+            }
+
+            tc->UpdateIdleCount();
+        }
+
+        int GetThreadCacheCount()                                   ///<取得线程缓存数量
+        {
+            std::lock_guard<std::mutex> lg(lock);
+            return (int)cache_list.size();
+        }
+
+        int GetDepotIdleCount()                                     ///<取得仓库中的空闲对象数量(不含线程缓存)
+        {
+            std::lock_guard<std::mutex> lg(lock);
+
+            int total=0;
+
+            for(Magazine *m:loaded_list)
+                total+=m->count;
+
+            return total;
+        }
+
+        int GetCachedIdleCount()                                    ///<取得所有线程缓存中的空闲对象数量(近似值)
+        {
+            std::lock_guard<std::mutex> lg(lock);
+
+            int total=0;
+
+            for(const auto &tc:cache_list)
+                total+=tc->idle_count.load(std::memory_order_relaxed);
+
+            return total;
+        }
+
+        uint64 GetExchangeCount()                                   ///<取得与仓库交换弹匣的次数
+        {
+            std::lock_guard<std::mutex> lg(lock);
+            return exchange_count;
+        }
+
+        uint64 GetFillCount()                                       ///<取得从源装填弹匣的次数
+        {
+            std::lock_guard<std::mutex> lg(lock);
+            return fill_count;
+        }
+    };//template<typename T,int MAGAZINE_SIZE> class MagazineDepot
+}//namespace hgl
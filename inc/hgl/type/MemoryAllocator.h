@@ -83,4 +83,73 @@ namespace hgl
             return(true);
         }
     };//class MemoryAllocator:public AbstractMemoryAllocator
+
+    /**
+     * 页面内存分配器<br>
+     * 直接向系统映射内存页面，可使用大页面(显式大页面或透明大页面)以减少TLB缺失。
+     * 扩容时优先使用mremap原地扩展或由系统移动映射，不支持时重新映射并复制数据。
+     */
+    class PageMemoryAllocator:public AbstractMemoryAllocator
+    {
+    protected:
+
+        uint64 map_size;                    ///<实际映射的字节数
+        bool huge_page;                     ///<是否尝试使用大页面
+        bool huge_tlb;                      ///<当前映射是否使用了显式大页面
+
+        virtual void *  MapPages    (uint64 &size,bool &tlb);                           ///<映射新页面(size返回实际大小)
+        virtual void    UnmapPages  (void *ptr,const uint64 size);                      ///<释放页面
+        virtual void *  RemapPages  (void *ptr,const uint64 old_size,uint64 &new_size); ///<扩展映射，不支持时返回nullptr
+
+        virtual bool AllocMemory() override;
+
+    public:
+
+        virtual const bool CanRealloc()const override{return true;}
+
+        const bool IsHugePage   ()const{return huge_page;}                              ///<是否尝试使用大页面
+        const bool IsHugeTLB    ()const{return huge_tlb;}                               ///<当前是否使用了显式大页面
+
+    public:
+
+        PageMemoryAllocator(const bool use_huge_page=true);
+        virtual ~PageMemoryAllocator();
+        virtual void Free() override;
+
+        virtual bool Write(const void *source,const uint64 offset,const uint64 size) override
+        {
+            if(!source||size==0)return(false);
+
+            if(offset+size>data_size)
+                return(false);
+
+            memcpy((uint8 *)memory_block+offset,source,size);
+            return(true);
+        }
+    };//class PageMemoryAllocator:public AbstractMemoryAllocator
+
+    /**
+     * NUMA节点内存分配器<br>
+     * 通过NumaAlloc将页面分配在指定的NUMA节点上，避免跨节点访问。
+     * 重新映射无法保证节点绑定，所以扩容时总是重新分配并复制数据。
+     */
+    class NumaMemoryAllocator:public PageMemoryAllocator
+    {
+    protected:
+
+        int numa_node;                      ///<NUMA节点，-1为默认节点
+
+        virtual void *  MapPages    (uint64 &size,bool &tlb) override;
+        virtual void    UnmapPages  (void *ptr,const uint64 size) override;
+        virtual void *  RemapPages  (void *,const uint64,uint64 &) override{return nullptr;}
+
+    public:
+
+        const int GetNumaNode()const{return numa_node;}
+
+    public:
+
+        NumaMemoryAllocator(const int node=-1,const bool use_huge_page=true);
+        virtual ~NumaMemoryAllocator();
+    };//class NumaMemoryAllocator:public PageMemoryAllocator
 }//namespace hgl
@@ -1,14 +1,18 @@
 ﻿#pragma once
 
 #include<vector>
+#include<algorithm>
+#include<memory>
+#include<hgl/type/DataType.h>
 #include<hgl/type/Stack.h>
-#include<hgl/type/ValueKVMap.h>
 #include<type_traits>
 
 namespace hgl
 {
     // AI NOTE: Stores values in arrays and assigns monotonically increasing IDs.
-    // ID->location is tracked by ValueKVMap; removed slots go to a free stack.
+    // ID->location is a paged direct-index table over (id-id_base), pages are
+    // freed once every ID in them was issued and removed; removed slots go to
+    // a free stack.
     // Data is trivially copyable; locations can be reused after remove.
     using MonotonicID=int32;
 
@@ -32,15 +36,141 @@ namespace hgl
     {
         static_assert(std::is_trivially_copyable<T>::value,
                       "MonotonicIDList requires trivially copyable T");
+        static_assert(std::is_integral<I>::value,
+                      "MonotonicIDList requires an integral ID type");
+
+        static constexpr int32 ID_PAGE_SHIFT=10;
+        static constexpr int32 ID_PAGE_SIZE=1<<ID_PAGE_SHIFT;     ///< CN: 每页ID数 / EN: IDs per page
+
+        /**
+         * CN: ID索引页，保存连续ID_PAGE_SIZE个ID的位置，-1表示该ID不存在
+         * EN: ID index page holding the locations of ID_PAGE_SIZE consecutive IDs, -1 means absent
+         */
+        struct IDPage
+        {
+            int32 location[ID_PAGE_SIZE];
+            int32 live_count=0;
+        };
 
         I id_base=1;                            ///< CN: ID 起始值(默认1) / EN: ID base (default 1)
         I next_id=1;                            ///< CN: 下一个可用的ID / EN: Next available ID
 
         std::vector<T>  data_array;               ///< CN: 实际数据存储数组 / EN: Actual data storage array
         std::vector<I>  location_to_id;           ///< CN: 位置到ID的并行数组 / EN: Parallel array: location -> ID
-        ValueKVMap<I,int32> id_to_location_map;   ///< CN: ID到位置映射 / EN: Map: ID -> location
+        std::vector<std::unique_ptr<IDPage>> id_pages;  ///< CN: ID到位置的分页直接索引表 / EN: Paged direct index: ID -> location
+        int32 live_count=0;                     ///< CN: 有效元素数量 / EN: Number of live elements
         Stack<int32>  free_location;         ///< CN: 空闲位置栈 / EN: Stack of free locations
 
+    private:
+
+        /**
+         * CN: 计算ID在索引表中的偏移，ID不是已分配过的ID时返回false
+         * EN: Offset of an ID in the index table, false if the ID was never issued
+         */
+        bool GetIDOffset(const I &id,uint64 &offset) const
+        {
+            using U=typename std::make_unsigned<I>::type;
+
+            if(id<id_base||!(id<next_id))
+                return false;
+
+            offset=uint64(U(id)-U(id_base));
+            return true;
+        }
+
+        int32 FindLocation(const I &id) const
+        {
+            uint64 offset;
+
+            if(!GetIDOffset(id,offset))
+                return -1;
+
+            const IDPage *page=id_pages[offset>>ID_PAGE_SHIFT].get();
+
+            if(!page)
+                return -1;
+
+            return page->location[offset&(ID_PAGE_SIZE-1)];
+        }
+
+        /**
+         * CN: 记录一个新ID的位置，需要时分配索引页
+         * EN: Record the location of a new ID, allocating its index page if needed
+         */
+        void BindLocation(const I &id,int32 location)
+        {
+            using U=typename std::make_unsigned<I>::type;
+
+            const uint64 offset=uint64(U(id)-U(id_base));
+            const uint64 page_index=offset>>ID_PAGE_SHIFT;
+
+            if(id_pages.size()<=page_index)
+                id_pages.resize(page_index+1);
+
+            std::unique_ptr<IDPage> &page=id_pages[page_index];
+
+            if(!page)
+            {
+                page.reset(new IDPage);
+                std::fill(page->location,page->location+ID_PAGE_SIZE,-1);
+            }
+
+            page->location[offset&(ID_PAGE_SIZE-1)]=location;
+            ++page->live_count;
+            ++live_count;
+        }
+
+        /**
+         * CN: 改变一个已存在ID的位置
+         * EN: Change the location of an existing ID
+         */
+        void ChangeLocation(const I &id,int32 location)
+        {
+            uint64 offset;
+
+            if(GetIDOffset(id,offset))
+                id_pages[offset>>ID_PAGE_SHIFT]->location[offset&(ID_PAGE_SIZE-1)]=location;
+        }
+
+        /**
+         * CN: 移除ID并取得其位置，页内ID全部分配过且均已移除时释放该页
+         * EN: Remove an ID and take its location, freeing the page once all of its IDs were issued and removed
+         */
+        bool UnbindLocation(const I &id,int32 &location)
+        {
+            uint64 offset;
+
+            if(!GetIDOffset(id,offset))
+                return false;
+
+            const uint64 page_index=offset>>ID_PAGE_SHIFT;
+            IDPage *page=id_pages[page_index].get();
+
+            if(!page)
+                return false;
+
+            int32 &slot=page->location[offset&(ID_PAGE_SIZE-1)];
+
+            if(slot<0)
+                return false;
+
+            location=slot;
+            slot=-1;
+            --live_count;
+
+            if(--page->live_count==0)
+            {
+                using U=typename std::make_unsigned<I>::type;
+
+                const uint64 next_offset=uint64(U(next_id-1)-U(id_base));     //id有效说明next_id>id_base，最后分配的ID一定在范围内
+
+                if((next_offset>>ID_PAGE_SHIFT)>page_index)      // 该页不会再分配新ID
+                    id_pages[page_index].reset();
+            }
+
+            return true;
+        }
+
     public:
 
         MonotonicIDList() = default;
@@ -92,7 +222,7 @@ namespace hgl
 
             T *p=&data_array[location];
 
-            id_to_location_map.Add(next_id,location);
+            BindLocation(next_id,location);
             // mark location -> id
             location_to_id[location]=next_id;
 
@@ -174,7 +304,7 @@ namespace hgl
         {
             int32 location;
 
-            if(!id_to_location_map.GetAndDelete(id,location))
+            if(!UnbindLocation(id,location))
                 return(false);
 
             // mark location as free
@@ -199,7 +329,7 @@ namespace hgl
          */
         bool Contains(const I &id)const
         {
-            return id_to_location_map.ContainsKey(id);
+            return FindLocation(id)>=0;
         }
 
         /**
@@ -216,9 +346,9 @@ namespace hgl
          */
         T *Get(const I &id)
         {
-            int32 location;
+            const int32 location=FindLocation(id);
 
-            if(!id_to_location_map.Get(id,location))
+            if(location<0)
                 return(nullptr);
 
             return &data_array[location];
@@ -226,16 +356,16 @@ namespace hgl
 
         const T *Get(const I &id) const
         {
-            int32 location;
-            if(!id_to_location_map.Get(id,location))
+            const int32 location=FindLocation(id);
+            if(location<0)
                 return nullptr;
             return &data_array[location];
         }
 
         bool TryGet(const I &id, T *&out)
         {
-            int32 location;
-            if(!id_to_location_map.Get(id,location))
+            const int32 location=FindLocation(id);
+            if(location<0)
             {
                 out=nullptr;
                 return false;
@@ -246,8 +376,8 @@ namespace hgl
 
         bool TryGet(const I &id, const T *&out) const
         {
-            int32 location;
-            if(!id_to_location_map.Get(id,location))
+            const int32 location=FindLocation(id);
+            if(location<0)
             {
                 out=nullptr;
                 return false;
@@ -270,17 +400,12 @@ namespace hgl
          */
         int GetLocation(const I &id) const
         {
-            int32 location;
-
-            if(!id_to_location_map.Get(id,location))
-                return -1;
-
-            return location;
+            return FindLocation(id);
         }
 
         int Count() const
         {
-            return id_to_location_map.GetCount();
+            return live_count;
         }
 
         int StorageSize() const
@@ -288,6 +413,21 @@ namespace hgl
             return (int)data_array.size();
         }
 
+        /**
+         * CN: 当前已分配的ID索引页数量
+         * EN: Number of allocated ID index pages
+         */
+        int GetIndexPageCount() const
+        {
+            int count=0;
+
+            for(const auto &page:id_pages)
+                if(page)
+                    ++count;
+
+            return count;
+        }
+
         bool Empty() const
         {
             return Count()==0;
@@ -297,7 +437,8 @@ namespace hgl
         {
             data_array.clear();
             location_to_id.clear();
-            id_to_location_map.Clear();
+            id_pages.clear();
+            live_count=0;
             free_location.Clear();
             next_id=id_base;
         }
@@ -378,7 +519,7 @@ namespace hgl
                 dst = src;
 
                 // 更新映射
-                id_to_location_map.Change(tail_id, hole);
+                ChangeLocation(tail_id, hole);
                 location_to_id[hole]=tail_id;
                 location_to_id[tail_loc]=InvalidID();
 
@@ -462,11 +603,12 @@ namespace hgl
             }
 
             // 重建映射：新ID从 id_base 连续
-            id_to_location_map.Clear();
+            id_pages.clear();
+            live_count=0;
             for(int32 i=0; i<count; ++i)
             {
                 const I new_id=static_cast<I>(id_base + i);
-                id_to_location_map.Add(new_id, i);
+                BindLocation(new_id, i);
                 location_to_id[i]=new_id;
             }
 
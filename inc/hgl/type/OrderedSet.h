@@ -169,6 +169,21 @@ namespace hgl
             return added;
         }
 
+        /**
+         * @brief CN:用已排序且不重复的序列替换全部元素（按序追加，每个元素均摊O(1)）\nEN:Replace all elements with a sorted unique range (appended in order, amortized O(1) each)
+         * @return 元素个数
+         */
+        template<typename It>
+        int64 AssignSorted(It first, It last)
+        {
+            data.clear();
+
+            for (; first != last; ++first)
+                data.insert(data.end(), *first);
+
+            return static_cast<int64>(data.size());
+        }
+
         // ==================== 删除 ====================
 
         /**
@@ -0,0 +1,230 @@
+﻿/**
+* @file RadixSort.h
+* @brief CN:整数键的LSD基数排序，以及按键类型自动选择基数排序/比较排序的批量排序工具
+*        EN:LSD radix sort for integer keys, and batch sort helpers that pick radix or comparison sort by key type
+*/
+#pragma once
+
+#include<vector>
+#include<algorithm>
+#include<numeric>
+#include<type_traits>
+#include<cstring>
+#include<hgl/type/DataType.h>
+
+namespace hgl
+{
+    /**
+    * @brief CN:是否可以使用基数排序（整数或枚举，不含bool）\nEN:Whether radix sort applies (integers or enums, excluding bool)
+    */
+    template<typename K>
+    constexpr bool IsRadixSortable=(std::is_integral_v<K>||std::is_enum_v<K>)
+                                 &&!std::is_same_v<K,bool>
+                                 &&sizeof(K)<=8;
+
+    /**
+    * @brief CN:数量小于此值时基数排序不如比较排序\nEN:Below this count comparison sort beats radix sort
+    */
+    constexpr int64 RADIX_SORT_MIN_COUNT=256;
+
+    namespace radix_sort
+    {
+        template<typename K,bool=std::is_enum_v<K>> struct IntegerOf{using type=K;};
+        template<typename K> struct IntegerOf<K,true>{using type=std::underlying_type_t<K>;};
+
+        /**
+        * @brief CN:把键映射为无符号整数，保持大小顺序（有符号数翻转符号位）\nEN:Map a key to an unsigned integer preserving order (flip sign bit for signed)
+        */
+        template<typename K>
+        inline auto ToOrderedBits(const K &key)
+        {
+            using I=typename IntegerOf<K>::type;
+            using U=std::make_unsigned_t<I>;
+
+            U bits;
+            memcpy(&bits,&key,sizeof(K));
+
+            if constexpr(std::is_signed_v<I>)
+                bits^=U(1)<<(sizeof(K)*8-1);
+
+            return bits;
+        }
+
+        /**
+        * @brief CN:LSD基数排序实现（稳定），payload可为nullptr\nEN:LSD radix sort (stable), payload may be nullptr
+        */
+        template<typename K,typename P>
+        void Sort(K *keys,P *payload,const int64 count)
+        {
+            constexpr int PASS_COUNT=sizeof(K);
+
+            std::vector<int64> histogram(PASS_COUNT*256,0);
+
+            for(int64 i=0;i<count;i++)
+            {
+                auto bits=ToOrderedBits(keys[i]);
+
+                for(int p=0;p<PASS_COUNT;p++)
+                    ++histogram[p*256+((bits>>(p*8))&0xFF)];
+            }
+
+            std::vector<K> key_buffer(count);
+            std::vector<P> payload_buffer(payload?count:0);
+
+            K *src_key=keys,*dst_key=key_buffer.data();
+            P *src_payload=payload,*dst_payload=payload_buffer.data();
+
+            for(int p=0;p<PASS_COUNT;p++)
+            {
+                int64 *h=histogram.data()+p*256;
+
+                // 该字节全部相同，这一趟不改变顺序，跳过
+                if(h[(ToOrderedBits(src_key[0])>>(p*8))&0xFF]==count)
+                    continue;
+
+                int64 offset=0;
+
+                for(int b=0;b<256;b++)
+                {
+                    const int64 n=h[b];
+                    h[b]=offset;
+                    offset+=n;
+                }
+
+                for(int64 i=0;i<count;i++)
+                {
+                    const int64 pos=h[(ToOrderedBits(src_key[i])>>(p*8))&0xFF]++;
+
+                    dst_key[pos]=src_key[i];
+
+                    if(payload)
+                        dst_payload[pos]=src_payload[i];
+                }
+
+                std::swap(src_key,dst_key);
+                std::swap(src_payload,dst_payload);
+            }
+
+            if(src_key!=keys)
+            {
+                memcpy(keys,src_key,count*sizeof(K));
+
+                if(payload)
+                    memcpy(payload,src_payload,count*sizeof(P));
+            }
+        }
+    }//namespace radix_sort
+
+    /**
+    * @brief CN:基数排序（稳定）\nEN:Radix sort (stable)
+    */
+    template<typename K>
+    void RadixSort(K *keys,const int64 count)
+    {
+        static_assert(IsRadixSortable<K>,"RadixSort requires integer or enum keys.");
+
+        if(!keys||count<=1)return;
+
+        radix_sort::Sort<K,char>(keys,nullptr,count);
+    }
+
+    /**
+    * @brief CN:按键基数排序，payload随键一起移动（稳定）\nEN:Radix sort by key, payload moves with its key (stable)
+    */
+    template<typename K,typename P>
+    void RadixSort(K *keys,P *payload,const int64 count)
+    {
+        static_assert(IsRadixSortable<K>,"RadixSort requires integer or enum keys.");
+        static_assert(std::is_trivially_copyable_v<P>,"RadixSort payload must be trivially copyable.");
+
+        if(!keys||count<=1)return;
+
+        radix_sort::Sort(keys,payload,count);
+    }
+
+    /**
+    * @brief CN:排序并去重，整数键使用基数排序\nEN:Sort and remove duplicates, integer keys use radix sort
+    * @return CN:去重后的数量。EN:Count after removing duplicates.
+    */
+    template<typename K>
+    int64 SortUnique(K *keys,const int64 count)
+    {
+        if(!keys||count<=0)return 0;
+
+        if constexpr(IsRadixSortable<K>)
+        {
+            if(count>=RADIX_SORT_MIN_COUNT)
+                RadixSort(keys,count);
+            else
+                std::sort(keys,keys+count);
+        }
+        else
+        {
+            std::sort(keys,keys+count);
+        }
+
+        return std::unique(keys,keys+count,[](const K &a,const K &b){return !(a<b)&&!(b<a);})-keys;
+    }
+
+    /**
+    * @brief CN:按键稳定排序键值对，并按键去重\nEN:Stable sort key/value pairs by key and remove duplicate keys
+    * @param keep_last CN:重复键保留最后出现的一个(否则保留第一个)。EN:Keep the last occurrence of a duplicate key (otherwise the first).
+    * @return CN:去重后的数量。EN:Count after removing duplicates.
+    */
+    template<typename K,typename V>
+    int64 SortUniquePairs(K *keys,V *values,const int64 count,const bool keep_last)
+    {
+        if(!keys||!values||count<=0)return 0;
+
+        bool sorted=false;
+
+        if constexpr(IsRadixSortable<K>&&std::is_trivially_copyable_v<V>)
+        {
+            if(count>=RADIX_SORT_MIN_COUNT)
+            {
+                RadixSort(keys,values,count);
+                sorted=true;
+            }
+        }
+
+        if(!sorted)
+        {
+            std::vector<int64> order(count);
+            std::iota(order.begin(),order.end(),0);
+
+            std::stable_sort(order.begin(),order.end(),[keys](int64 a,int64 b){return keys[a]<keys[b];});
+
+            std::vector<K> sorted_keys(count);
+            std::vector<V> sorted_values(count);
+
+            for(int64 i=0;i<count;i++)
+            {
+                sorted_keys[i]=keys[order[i]];
+                sorted_values[i]=values[order[i]];
+            }
+
+            std::copy(sorted_keys.begin(),sorted_keys.end(),keys);
+            std::copy(sorted_values.begin(),sorted_values.end(),values);
+        }
+
+        // 稳定排序后相同键按输入顺序排列
+        int64 write=0;
+
+        for(int64 i=0;i<count;i++)
+        {
+            if(write>0&&!(keys[write-1]<keys[i]))      // 与上一个保留的键相同
+            {
+                if(keep_last)
+                    values[write-1]=values[i];
+
+                continue;
+            }
+
+            keys[write]=keys[i];
+            values[write]=values[i];
+            ++write;
+        }
+
+        return write;
+    }
+}//namespace hgl
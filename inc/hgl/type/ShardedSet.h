@@ -7,6 +7,11 @@
 #include <type_traits>
 #include <vector>
 #include <array>
+#include <bit>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
 #include <hgl/util/hash/QuickHash.h>
 #include <hgl/type/ActiveDataManager.h>
 #include <ankerl/unordered_dense.h>
@@ -16,12 +21,14 @@ namespace hgl
     // AI NOTE: Hash set sharded into SHARD_COUNT partitions (power of two).
     // Each shard has its own ActiveDataManager and hash->id map.
     // Operations hash value, pick shard, then act locally.
+    // THREAD_SAFE=true adds a per-shard shared_mutex; AddBatch/ContainsBatch
+    // group inputs by shard and run shards on worker threads.
     /**
      * 【分片集合 ShardedSet】
      *
      * 【原理】
      * 将数据按哈希值高位分割为K个独立分片(默认16个)：
-     *  • 哈希值的第4位决定分片编号: (hash >> 60) & 0xF
+     *  • 哈希值最高SHARD_BITS位决定分片编号: hash >> (64 - SHARD_BITS)，SHARD_BITS=log2(SHARD_COUNT)(默认16个分片时为4位)
      *  • 每个分片独立维护ActiveDataManager和HashMap
      *  • 每个分片完全隔离，可独立操作和扩展
      *
@@ -60,37 +67,67 @@ namespace hgl
      *  • SHARD_COUNT模板参数: 分片数(必须是2的幂)
      *  • Reserve(capacity): 均分容量到各分片
      *  • RefreshHashMap(): 全局重建所有分片哈希表
+     *  • Compact()/CompactStep(n): 压缩各分片数据存储，回收已删除元素占用的空洞
+     *  • THREAD_SAFE模板参数: 为true时每个分片带一个读写锁(读共享/写独占)，可多线程并发访问
+     *
+     * 【批量操作】
+     *  • AddBatch/ContainsBatch先按分片对输入做计数排序，每个分片只加锁一次
+     *  • 分片之间互不相关，由thread_count个工作线程并行处理(0表示使用全部硬件线程)
+     *  • 非THREAD_SAFE模式下批量操作同样可以并行，但调用期间不能有其它线程访问本集合
      *
      * 【使用建议】
      *  • 元素数量预期 > 10000 时开始考虑
-     *  • 有锁或并发需求时强烈推荐
+     *  • 有锁或并发需求时强烈推荐(使用ShardedSet<T,N,true>)
      *  • 可通过reduce RefreshHashMap()调用次数优化
      */
-    template<typename T, int SHARD_COUNT = 16>
+    template<typename T, int SHARD_COUNT = 16, bool THREAD_SAFE = false>
     class ShardedSet
     {
         static_assert((SHARD_COUNT & (SHARD_COUNT - 1)) == 0, "SHARD_COUNT must be power of two.");
 
+        static constexpr int SHARD_BITS = std::countr_zero((unsigned)SHARD_COUNT);
+
+        static constexpr int PARALLEL_BATCH_MIN = 4096;         ///<批量操作数量小于此值时不启动工作线程
+
     protected:
         using HashMap = ankerl::unordered_dense::map<uint64, std::vector<int>>;
 
-        struct Shard
+        /**
+         * 非线程安全模式下使用的空锁
+         */
+        struct NullLock
+        {
+            void lock() {}
+            void unlock() {}
+            void lock_shared() {}
+            void unlock_shared() {}
+        };
+
+        using LockType = std::conditional_t<THREAD_SAFE, std::shared_mutex, NullLock>;
+        using ReadLock = std::shared_lock<LockType>;
+        using WriteLock = std::unique_lock<LockType>;
+
+        struct alignas(THREAD_SAFE ? 64 : alignof(HashMap)) Shard            // 线程安全模式下按缓存行对齐，避免相邻分片的锁伪共享
         {
             ActiveDataManager<T> data_manager;
             HashMap hash_map;
             int deleted_count = 0;
+
+            mutable LockType lock;
         };
 
         std::array<Shard, SHARD_COUNT> shards;
 
         int GetShardIndex(uint64 hash) const
         {
-            return (int)((hash >> 60) & (SHARD_COUNT - 1));
+            if constexpr (SHARD_BITS == 0)
+                return 0;
+            else
+                return (int)(hash >> (64 - SHARD_BITS));       // 取最高位，与分片内哈希表使用的低位无关
         }
 
-        int FindID(const Shard &shard, const T &value) const
+        int FindID(const Shard &shard, const T &value, uint64 hash) const
         {
-            uint64 hash = ComputeOptimalHash(value);
             auto it = shard.hash_map.find(hash);
             if (it == shard.hash_map.end())
                 return -1;
@@ -106,22 +143,172 @@ namespace hgl
             return -1;
         }
 
+        int FindID(const Shard &shard, const T &value) const
+        {
+            return FindID(shard, value, ComputeOptimalHash(value));
+        }
+
+        /**
+         * 在分片内添加(调用者需持有分片写锁)
+         */
+        static bool AddToShard(Shard &shard, const T &value, uint64 hash)
+        {
+            int new_id;
+            if (!shard.data_manager.GetOrCreate(&new_id, 1))
+                return false;
+
+            if (!shard.data_manager.WriteData(value, new_id))
+            {
+                shard.data_manager.Release(&new_id, 1);
+                return false;
+            }
+
+            shard.hash_map[hash].push_back(new_id);
+            return true;
+        }
+
+        static void RemapHashMap(Shard &shard, const std::vector<ActiveIDRemap> &moved)
+        {
+            for (const ActiveIDRemap &m : moved)
+            {
+                auto it = shard.hash_map.find(ComputeOptimalHash(*shard.data_manager.At(m.new_id)));
+                if (it == shard.hash_map.end())
+                    continue;
+
+                for (int &id : it->second)
+                {
+                    if (id == m.old_id)
+                    {
+                        id = m.new_id;
+                        break;
+                    }
+                }
+            }
+        }
+
+        static void RebuildHashMap(Shard &shard)
+        {
+            shard.hash_map.clear();
+
+            HashMap &hash_map = shard.hash_map;
+            const ActiveDataManager<T> &dm = shard.data_manager;
+
+            dm.ForEachActive([&hash_map](int id, const T &value)
+            {
+                uint64 hash = ComputeOptimalHash(value);
+                hash_map[hash].push_back(id);
+            });
+        }
+
+        /**
+         * 按分片分组后的批量输入
+         */
+        struct ShardGroups
+        {
+            std::array<int, SHARD_COUNT + 1> offset{};
+            std::vector<int> order;                 ///<按分片排列的输入下标
+            std::vector<uint64> hash;               ///<每个输入的哈希值
+        };
+
+        void GroupByShard(ShardGroups &groups, const T *values, const int count) const
+        {
+            std::vector<int> shard_of(count);
+
+            groups.hash.resize(count);
+            groups.order.resize(count);
+
+            for (int i = 0; i < count; i++)
+            {
+                groups.hash[i] = ComputeOptimalHash(values[i]);
+                shard_of[i] = GetShardIndex(groups.hash[i]);
+                ++groups.offset[shard_of[i] + 1];
+            }
+
+            for (int s = 0; s < SHARD_COUNT; s++)
+                groups.offset[s + 1] += groups.offset[s];
+
+            std::array<int, SHARD_COUNT> pos;
+
+            for (int s = 0; s < SHARD_COUNT; s++)
+                pos[s] = groups.offset[s];
+
+            for (int i = 0; i < count; i++)
+                groups.order[pos[shard_of[i]]++] = i;
+        }
+
+        /**
+         * 用最多thread_count个线程并行处理所有分片，func(shard_index)返回该分片的结果计数
+         */
+        template<typename F>
+        static int ParallelForShards(int thread_count, F &&func)
+        {
+            if (thread_count <= 0)
+                thread_count = (int)std::thread::hardware_concurrency();
+
+            if (thread_count > SHARD_COUNT)
+                thread_count = SHARD_COUNT;
+
+            if (thread_count <= 1)
+            {
+                int result = 0;
+
+                for (int s = 0; s < SHARD_COUNT; s++)
+                    result += func(s);
+
+                return result;
+            }
+
+            std::atomic<int> next_shard{0};
+            std::atomic<int> result{0};
+
+            auto worker = [&]()
+            {
+                int local = 0;
+
+                for (int s = next_shard.fetch_add(1); s < SHARD_COUNT; s = next_shard.fetch_add(1))
+                    local += func(s);
+
+                result.fetch_add(local);
+            };
+
+            std::vector<std::thread> threads;
+            threads.reserve(thread_count - 1);
+
+            for (int i = 1; i < thread_count; i++)
+                threads.emplace_back(worker);
+
+            worker();
+
+            for (std::thread &t : threads)
+                t.join();
+
+            return result.load();
+        }
+
     public:
         ShardedSet() = default;
         virtual ~ShardedSet() = default;
 
+        static constexpr bool IsThreadSafe() { return THREAD_SAFE; }
+
         void Reserve(int capacity)
         {
             int per = capacity / SHARD_COUNT + 1;
             for (auto &shard : shards)
+            {
+                WriteLock lock(shard.lock);
                 shard.data_manager.Reserve(per);
+            }
         }
 
         int GetCount() const
         {
             int total = 0;
             for (const auto &shard : shards)
+            {
+                ReadLock lock(shard.lock);
                 total += shard.data_manager.GetActiveCount();
+            }
             return total;
         }
 
@@ -137,21 +324,12 @@ namespace hgl
             int shard_index = GetShardIndex(hash);
             auto &shard = shards[shard_index];
 
-            if (FindID(shard, value) != -1)
-                return false;
-
-            int new_id;
-            if (!shard.data_manager.GetOrCreate(&new_id, 1))
-                return false;
+            WriteLock lock(shard.lock);
 
-            if (!shard.data_manager.WriteData(value, new_id))
-            {
-                shard.data_manager.Release(&new_id, 1);
+            if (FindID(shard, value, hash) != -1)
                 return false;
-            }
 
-            shard.hash_map[hash].push_back(new_id);
-            return true;
+            return AddToShard(shard, value, hash);
         }
 
         bool Delete(const T &value)
@@ -160,7 +338,9 @@ namespace hgl
             int shard_index = GetShardIndex(hash);
             auto &shard = shards[shard_index];
 
-            int id = FindID(shard, value);
+            WriteLock lock(shard.lock);
+
+            int id = FindID(shard, value, hash);
             if (id == -1)
                 return false;
 
@@ -178,13 +358,108 @@ namespace hgl
             uint64 hash = ComputeOptimalHash(value);
             int shard_index = GetShardIndex(hash);
             const auto &shard = shards[shard_index];
-            return FindID(shard, value) != -1;
+
+            ReadLock lock(shard.lock);
+            return FindID(shard, value, hash) != -1;
+        }
+
+        /**
+         * 批量添加：按分片分组，每个分片加锁一次，分片间并行
+         * @param values 数据
+         * @param count 数量
+         * @param thread_count 工作线程数(0表示使用全部硬件线程，1表示在当前线程顺序执行)
+         * @return 新添加的数量(已存在或输入中重复的值不计)
+         */
+        int AddBatch(const T *values, const int count, const int thread_count = 0)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "AddBatch() requires trivially copyable types.");
+
+            if (!values || count <= 0)
+                return 0;
+
+            ShardGroups groups;
+            GroupByShard(groups, values, count);
+
+            return ParallelForShards(count < PARALLEL_BATCH_MIN ? 1 : thread_count, [this, values, &groups](int s)
+            {
+                const int first = groups.offset[s];
+                const int last = groups.offset[s + 1];
+
+                if (first == last)
+                    return 0;
+
+                Shard &shard = shards[s];
+                WriteLock lock(shard.lock);
+
+                shard.data_manager.Reserve(shard.data_manager.GetActiveCount() + (last - first));
+
+                int added = 0;
+
+                for (int p = first; p < last; p++)
+                {
+                    const int i = groups.order[p];
+
+                    if (FindID(shard, values[i], groups.hash[i]) != -1)
+                        continue;
+
+                    if (AddToShard(shard, values[i], groups.hash[i]))
+                        ++added;
+                }
+
+                return added;
+            });
+        }
+
+        /**
+         * 批量查询：按分片分组，每个分片加读锁一次，分片间并行
+         * @param values 数据
+         * @param results 每项是否存在(可为nullptr)
+         * @param count 数量
+         * @param thread_count 工作线程数(0表示使用全部硬件线程，1表示在当前线程顺序执行)
+         * @return 存在的数量
+         */
+        int ContainsBatch(const T *values, bool *results, const int count, const int thread_count = 0) const
+        {
+            if (!values || count <= 0)
+                return 0;
+
+            ShardGroups groups;
+            GroupByShard(groups, values, count);
+
+            return ParallelForShards(count < PARALLEL_BATCH_MIN ? 1 : thread_count, [this, values, results, &groups](int s)
+            {
+                const int first = groups.offset[s];
+                const int last = groups.offset[s + 1];
+
+                if (first == last)
+                    return 0;
+
+                const Shard &shard = shards[s];
+                ReadLock lock(shard.lock);
+
+                int found = 0;
+
+                for (int p = first; p < last; p++)
+                {
+                    const int i = groups.order[p];
+                    const bool exist = FindID(shard, values[i], groups.hash[i]) != -1;
+
+                    if (results)
+                        results[i] = exist;
+
+                    if (exist)
+                        ++found;
+                }
+
+                return found;
+            });
         }
 
         void Clear()
         {
             for (auto &shard : shards)
             {
+                WriteLock lock(shard.lock);
                 shard.data_manager.Clear();
                 shard.hash_map.clear();
                 shard.deleted_count = 0;
@@ -195,27 +470,27 @@ namespace hgl
         {
             for (auto &shard : shards)
             {
+                WriteLock lock(shard.lock);
                 shard.data_manager.Free();
                 shard.hash_map.clear();
                 shard.deleted_count = 0;
             }
         }
 
+        /**
+         * 遍历所有元素(线程安全模式下遍历每个分片期间持有该分片的读锁，回调中不要修改本集合)
+         */
         template<typename F>
         void Enum(F &&func) const
         {
             for (const auto &shard : shards)
             {
-                auto active_ids = shard.data_manager.GetActiveView();
-                const int count = (int)active_ids.size();
+                ReadLock lock(shard.lock);
 
-                for (int i = 0; i < count; i++)
+                shard.data_manager.ForEachActive([&func](int, const T &value)
                 {
-                    int id = active_ids[i];
-                    T value;
-                    if (shard.data_manager.GetData(value, id))
-                        func(value);
-                }
+                    func(value);
+                });
             }
         }
 
@@ -223,22 +498,73 @@ namespace hgl
         {
             for (auto &shard : shards)
             {
-                shard.hash_map.clear();
-                auto active_ids = shard.data_manager.GetActiveView();
-                const int count = (int)active_ids.size();
+                WriteLock lock(shard.lock);
+                RebuildHashMap(shard);
+            }
+        }
 
-                for (int i = 0; i < count; i++)
-                {
-                    int id = active_ids[i];
-                    if (!shard.data_manager.IsActive(id))
-                        continue;
-                    T *ptr = shard.data_manager.At(id);
-                    if (!ptr)
-                        continue;
-                    uint64 hash = ComputeOptimalHash(*ptr);
-                    shard.hash_map[hash].push_back(id);
-                }
+        /**
+         * 完整压缩所有分片，并重建哈希表（同时清除已删除元素的残留ID）
+         * @return 搬移的元素数量
+         */
+        int Compact()
+        {
+            int result = 0;
+
+            for (auto &shard : shards)
+            {
+                WriteLock lock(shard.lock);
+
+                if (shard.data_manager.IsCompact())
+                    continue;
+
+                result += shard.data_manager.Compact();
+                shard.deleted_count = 0;
+
+                RebuildHashMap(shard);
+            }
+
+            return result;
+        }
+
+        /**
+         * 增量压缩：每个分片最多搬移max_move_per_shard个元素，并就地更新哈希表
+         * @return 本次搬移的元素数量
+         */
+        int CompactStep(int max_move_per_shard)
+        {
+            std::vector<ActiveIDRemap> moved;
+            int result = 0;
+
+            for (auto &shard : shards)
+            {
+                WriteLock lock(shard.lock);
+
+                if (shard.data_manager.IsCompact())
+                    continue;
+
+                moved.clear();
+                result += shard.data_manager.CompactStep(max_move_per_shard, &moved);
+                RemapHashMap(shard, moved);
+
+                if (shard.data_manager.IsCompact())
+                    shard.deleted_count = 0;
             }
+
+            return result;
+        }
+
+        bool IsCompact() const
+        {
+            for (const auto &shard : shards)
+            {
+                ReadLock lock(shard.lock);
+
+                if (!shard.data_manager.IsCompact())
+                    return false;
+            }
+
+            return true;
         }
     };
 }
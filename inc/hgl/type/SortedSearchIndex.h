@@ -0,0 +1,196 @@
+﻿/**
+* @file SortedSearchIndex.h
+* @brief CN:有序数组的静态B+树查找索引（16键节点），用于冻结后的FlatOrderedMap/FlatOrderedSet
+*        EN:Static B+ tree search index (16-key nodes) over a sorted array, used by frozen FlatOrderedMap/FlatOrderedSet
+*/
+#pragma once
+
+#include<vector>
+#include<algorithm>
+#include<hgl/type/DataType.h>
+
+namespace hgl
+{
+    /**
+    * @brief CN:有序数组的静态B+树查找索引\nEN:Static B+ tree search index over a sorted array
+    *
+    * CN:把有序数组按16个一组分块，每块的最大键组成上一层，逐层向上直到只剩一个节点。
+    *    查找时从根开始，每层只访问一个16键节点(一到两条缓存行)，节点内用定长无分支比较计数，
+    *    编译器可将其向量化为SIMD比较。最后在原数组的一个块内确定位置。
+    *    索引只保存分隔键，不保存指针，原数组不变时可随容器一起复制/移动。
+    * EN:The sorted array is split into blocks of 16, the max key of each block forms the level above,
+    *    repeated until a single node remains. A lookup touches one 16-key node (one or two cache lines)
+    *    per level, counting keys with a fixed-length branchless loop the compiler can turn into SIMD
+    *    compares, then finishes inside one block of the original array.
+    *    The index holds separator keys only (no pointers), so it stays valid when copied/moved along
+    *    with an unchanged array.
+    *
+    * @tparam K CN:键类型，需支持operator<。EN:Key type, must support operator<.
+    */
+    template<typename K>
+    class SortedSearchIndex
+    {
+    public:
+
+        static constexpr int64 NODE_WIDTH=16;
+
+    protected:
+
+        /**
+        * @brief CN:一个节点，键足够大时按缓存行对齐\nEN:One node, cache line aligned when keys are large enough
+        */
+        struct alignas(sizeof(K)*NODE_WIDTH>=64?64:alignof(K)) Node
+        {
+            K key[NODE_WIDTH];
+        };
+
+        std::vector<Node> nodes;                ///<CN:所有层的节点，根在最前。EN:Nodes of all levels, root first.
+        std::vector<int64> level_start;         ///<CN:每层第一个节点的下标(从根开始)。EN:First node of each level (root first).
+        int64 key_count=0;
+
+        /**
+        * @brief CN:统计节点内小于key的键数量（定长，无分支）\nEN:Count keys less than key in a node (fixed length, branchless)
+        */
+        static int64 CountLess(const K *node_key,const K &key)
+        {
+            int64 count=0;
+
+            for(int64 i=0;i<NODE_WIDTH;i++)
+                count+=(node_key[i]<key);
+
+            return count;
+        }
+
+    public:
+
+        SortedSearchIndex()=default;
+        ~SortedSearchIndex()=default;
+
+        bool IsEmpty()const{return key_count==0;}
+        int64 GetKeyCount()const{return key_count;}
+        int64 GetLevelCount()const{return (int64)level_start.size();}
+
+        /**
+        * @brief CN:索引占用的字节数\nEN:Bytes used by the index
+        */
+        int64 GetByteSize()const{return (int64)(nodes.size()*sizeof(Node)+level_start.size()*sizeof(int64));}
+
+        void Clear()
+        {
+            nodes.clear();
+            nodes.shrink_to_fit();
+            level_start.clear();
+            key_count=0;
+        }
+
+        /**
+        * @brief CN:根据有序数组建立索引\nEN:Build the index over a sorted array
+        * @param sorted_keys CN:升序排列且不重复的键。EN:Keys in ascending order without duplicates.
+        * @param count CN:键数量。EN:Key count.
+        */
+        void Build(const K *sorted_keys,const int64 count)
+        {
+            Clear();
+
+            if(!sorted_keys||count<=0)
+                return;
+
+            key_count=count;
+
+            if(count<=NODE_WIDTH)                   // 只有一个块，直接在原数组中查找
+                return;
+
+            // 自底向上生成每一层的分隔键(每组的最大键)
+            std::vector<std::vector<K>> levels;
+
+            const K *below=sorted_keys;
+            int64 below_count=count;
+
+            do
+            {
+                const int64 group_count=(below_count+NODE_WIDTH-1)/NODE_WIDTH;
+
+                std::vector<K> level(group_count);
+
+                for(int64 i=0;i<group_count;i++)
+                    level[i]=below[std::min((i+1)*NODE_WIDTH,below_count)-1];
+
+                levels.push_back(std::move(level));
+
+                below=levels.back().data();
+                below_count=group_count;
+            }while(below_count>NODE_WIDTH);
+
+            // 根在最前排列，每层补齐到整节点，补位键重复该层最后一个键
+            int64 total=0;
+
+            for(auto it=levels.rbegin();it!=levels.rend();++it)
+            {
+                level_start.push_back(total);
+                total+=((int64)it->size()+NODE_WIDTH-1)/NODE_WIDTH;
+            }
+
+            nodes.resize(total);
+
+            int64 level_index=0;
+
+            for(auto it=levels.rbegin();it!=levels.rend();++it,++level_index)
+            {
+                K *dst=nodes[level_start[level_index]].key;
+                const int64 n=(int64)it->size();
+                const int64 padded=((n+NODE_WIDTH-1)/NODE_WIDTH)*NODE_WIDTH;
+
+                std::copy(it->begin(),it->end(),dst);
+                std::fill(dst+n,dst+padded,it->back());
+            }
+        }
+
+        /**
+        * @brief CN:查找第一个不小于key的位置\nEN:Find the first position not less than key
+        * @param sorted_keys CN:建立索引时使用的有序数组。EN:The sorted array the index was built over.
+        * @return CN:位置，所有键都小于key时返回键数量。EN:Position, or the key count when every key is less than key.
+        */
+        int64 LowerBound(const K *sorted_keys,const K &key)const
+        {
+            int64 node=0;
+
+            for(const int64 start:level_start)
+            {
+                const int64 count=CountLess(nodes[start+node].key,key);
+
+                // 只会发生在根节点：key大于所有键
+                if(count==NODE_WIDTH)
+                    return key_count;
+
+                node=node*NODE_WIDTH+count;
+            }
+
+            // node现在是原数组中的块号
+            const int64 begin=node*NODE_WIDTH;
+
+            if(begin+NODE_WIDTH<=key_count)
+                return begin+CountLess(sorted_keys+begin,key);
+
+            int64 pos=begin;
+
+            while(pos<key_count&&sorted_keys[pos]<key)
+                ++pos;
+
+            return pos;
+        }
+
+        /**
+        * @brief CN:查找键的位置\nEN:Find the position of a key
+        * @return CN:位置或-1。EN:Position or -1.
+        */
+        int64 Find(const K *sorted_keys,const K &key)const
+        {
+            const int64 pos=LowerBound(sorted_keys,key);
+
+            if(pos<key_count&&!(key<sorted_keys[pos]))
+                return pos;
+
+            return -1;
+        }
+    };//template<typename K> class SortedSearchIndex
+}//namespace hgl
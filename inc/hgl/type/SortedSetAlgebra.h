@@ -0,0 +1,359 @@
+﻿/**
+* @file SortedSetAlgebra.h
+* @brief CN:有序去重数组的集合运算（线性合并、倍增查找、32位整数SIMD求交）
+*        EN:Set algebra on sorted unique arrays (linear merge, galloping search, SIMD intersection for 32-bit integers)
+*/
+#pragma once
+
+#include<algorithm>
+#include<type_traits>
+#include<hgl/type/DataType.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HGL_SORTED_SET_SIMD_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define HGL_SORTED_SET_SIMD_NEON
+#endif
+
+namespace hgl
+{
+    /**
+    * @brief CN:两数组长度比超过此值时，对小数组的每个元素在大数组中倍增查找\nEN:Beyond this size ratio, each element of the small array is galloped into the large one
+    */
+    constexpr int64 SORTED_SET_GALLOP_RATIO=32;
+
+    namespace sorted_set
+    {
+        /**
+        * @brief CN:从begin开始倍增查找第一个不小于key的位置\nEN:Galloping search for the first position not less than key, starting at begin
+        */
+        template<typename T>
+        int64 GallopLowerBound(const T *p,int64 begin,const int64 end,const T &key)
+        {
+            int64 step=1;
+            int64 low=begin;
+
+            while(begin+step<end&&p[begin+step]<key)
+            {
+                low=begin+step;
+                step<<=1;
+            }
+
+            return std::lower_bound(p+low,p+std::min(begin+step+1,end),key)-p;
+        }
+
+#if defined(HGL_SORTED_SET_SIMD_SSE2)||defined(HGL_SORTED_SET_SIMD_NEON)
+        template<typename T> constexpr bool UseSIMD=std::is_integral_v<T>&&sizeof(T)==4;
+#else
+        template<typename T> constexpr bool UseSIMD=false;
+#endif
+
+        /**
+        * @brief CN:把a[begin,end)移动到out[c]，out不超前于a时可以原地使用\nEN:Move a[begin,end) to out[c], works in place as long as out does not run ahead of a
+        */
+        template<typename T>
+        int64 CopyRun(const T *a,const int64 begin,const int64 end,T *out,const int64 c)
+        {
+            if(out+c!=a+begin)
+                std::copy(a+begin,a+end,out+c);
+
+            return c+(end-begin);
+        }
+
+        /**
+        * @brief CN:求交/求差的4x4块比较内核（32位整数）\nEN:4x4 block compare kernel for intersect/difference (32-bit integers)
+        * @tparam KEEP_COMMON CN:true求交集，false求差集(a-b)。EN:true for intersection, false for difference (a-b).
+        *
+        * CN:每次取a、b各4个元素，用4次移位比较得到a中每个元素是否在b块中出现；
+        *    a块的匹配结果跨多个b块累积，a块前进时一次输出。
+        * EN:Takes 4 elements from each side and finds, with 4 rotated compares, which a lanes occur in the b block;
+        *    matches for an a block accumulate across b blocks and are emitted when a advances.
+        */
+        template<bool KEEP_COMMON,typename T>
+        int64 BlockMerge(const T *a,const int64 na,const T *b,const int64 nb,T *out)
+        {
+            int64 i=0,j=0,c=0;
+            int found=0;                    // 当前a块中已匹配的元素位掩码
+
+            const int64 na4=na&~int64(3);
+            const int64 nb4=nb&~int64(3);
+
+            auto emit_block=[&](const T *block)
+            {
+                for(int lane=0;lane<4;lane++)
+                    if(((found>>lane)&1)==KEEP_COMMON)
+                        out[c++]=block[lane];
+            };
+
+            while(i<na4&&j<nb4)
+            {
+#if defined(HGL_SORTED_SET_SIMD_SSE2)
+                const __m128i va=_mm_loadu_si128((const __m128i *)(a+i));
+                const __m128i vb=_mm_loadu_si128((const __m128i *)(b+j));
+
+                const __m128i m01=_mm_or_si128(_mm_cmpeq_epi32(va,vb),
+                                               _mm_cmpeq_epi32(va,_mm_shuffle_epi32(vb,_MM_SHUFFLE(0,3,2,1))));
+                const __m128i m23=_mm_or_si128(_mm_cmpeq_epi32(va,_mm_shuffle_epi32(vb,_MM_SHUFFLE(1,0,3,2))),
+                                               _mm_cmpeq_epi32(va,_mm_shuffle_epi32(vb,_MM_SHUFFLE(2,1,0,3))));
+
+                found|=_mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(m01,m23)));
+#elif defined(HGL_SORTED_SET_SIMD_NEON)
+                const uint32x4_t va=vld1q_u32((const uint32_t *)(a+i));
+                const uint32x4_t vb=vld1q_u32((const uint32_t *)(b+j));
+
+                const uint32x4_t m=vorrq_u32(vorrq_u32(vceqq_u32(va,vb),vceqq_u32(va,vextq_u32(vb,vb,1))),
+                                             vorrq_u32(vceqq_u32(va,vextq_u32(vb,vb,2)),vceqq_u32(va,vextq_u32(vb,vb,3))));
+
+                static const uint32_t lane_bit[4]={1,2,4,8};
+                found|=(int)vaddvq_u32(vandq_u32(m,vld1q_u32(lane_bit)));
+#endif
+                const T a_max=a[i+3];
+                const T b_max=b[j+3];
+
+                if(!(b_max<a_max))          // a块中不会再有匹配
+                {
+                    // 先复制整块再输出：out可能与a重叠
+                    const T block[4]={a[i],a[i+1],a[i+2],a[i+3]};
+
+                    emit_block(block);
+                    found=0;
+                    i+=4;
+                }
+
+                if(!(a_max<b_max))
+                    j+=4;
+            }
+
+            // 尚未输出的a块：已匹配的元素已确定，其余继续逐个比较
+            if(i<na4)
+            {
+                for(int lane=0;lane<4;lane++,i++)
+                {
+                    const T x=a[i];
+
+                    if((found>>lane)&1)
+                    {
+                        if(KEEP_COMMON)
+                            out[c++]=x;
+
+                        continue;
+                    }
+
+                    while(j<nb&&b[j]<x)
+                        ++j;
+
+                    const bool common=(j<nb&&!(x<b[j]));
+
+                    if(common==KEEP_COMMON)
+                        out[c++]=x;
+                }
+            }
+
+            // 剩余部分逐个合并
+            while(i<na)
+            {
+                const T x=a[i++];
+
+                while(j<nb&&b[j]<x)
+                    ++j;
+
+                const bool common=(j<nb&&!(x<b[j]));
+
+                if(common==KEEP_COMMON)
+                    out[c++]=x;
+            }
+
+            return c;
+        }
+
+        /**
+        * @brief CN:小数组对大数组的倍增合并（并集/对称差）\nEN:Galloping merge of a small array into a large one (union / symmetric difference)
+        * @tparam KEEP_COMMON CN:true求并集，false求对称差。EN:true for union, false for symmetric difference.
+        */
+        template<bool KEEP_COMMON,typename T>
+        int64 GallopMerge(const T *small,const int64 ns,const T *large,const int64 nl,T *out)
+        {
+            int64 j=0,c=0;
+
+            for(int64 i=0;i<ns;i++)
+            {
+                const int64 next=GallopLowerBound(large,j,nl,small[i]);
+
+                c=std::copy(large+j,large+next,out+c)-out;
+                j=next;
+
+                if(j<nl&&!(small[i]<large[j]))      // 相同元素
+                {
+                    ++j;
+
+                    if(!KEEP_COMMON)
+                        continue;
+                }
+
+                out[c++]=small[i];
+            }
+
+            return std::copy(large+j,large+nl,out+c)-out;
+        }
+    }//namespace sorted_set
+
+    /**
+    * @brief CN:并集\nEN:Union
+    * @param out CN:输出，至少na+nb个元素，不能与输入重叠。EN:Output of at least na+nb elements, must not overlap the inputs.
+    * @return CN:输出元素个数。EN:Number of elements written.
+    */
+    template<typename T>
+    int64 SortedUnion(const T *a,const int64 na,const T *b,const int64 nb,T *out)
+    {
+        if(na*SORTED_SET_GALLOP_RATIO<nb)return sorted_set::GallopMerge<true>(a,na,b,nb,out);
+        if(nb*SORTED_SET_GALLOP_RATIO<na)return sorted_set::GallopMerge<true>(b,nb,a,na,out);
+
+        return std::set_union(a,a+na,b,b+nb,out)-out;
+    }
+
+    /**
+    * @brief CN:交集\nEN:Intersection
+    * @param out CN:输出，至少min(na,nb)个元素，可以与a相同(原地)。EN:Output of at least min(na,nb) elements, may be a itself (in place).
+    * @return CN:输出元素个数。EN:Number of elements written.
+    */
+    template<typename T>
+    int64 SortedIntersect(const T *a,const int64 na,const T *b,const int64 nb,T *out)
+    {
+        if(na<=0||nb<=0)return 0;
+
+        int64 c=0;
+
+        if(na*SORTED_SET_GALLOP_RATIO<nb)
+        {
+            int64 j=0;
+
+            for(int64 i=0;i<na&&j<nb;i++)
+            {
+                j=sorted_set::GallopLowerBound(b,j,nb,a[i]);
+
+                if(j<nb&&!(a[i]<b[j]))
+                    out[c++]=a[i];
+            }
+
+            return c;
+        }
+
+        if(nb*SORTED_SET_GALLOP_RATIO<na)
+        {
+            int64 i=0;
+
+            for(int64 j=0;j<nb&&i<na;j++)
+            {
+                i=sorted_set::GallopLowerBound(a,i,na,b[j]);
+
+                if(i<na&&!(b[j]<a[i]))
+                    out[c++]=a[i++];
+            }
+
+            return c;
+        }
+
+        if constexpr(sorted_set::UseSIMD<T>)
+            return sorted_set::BlockMerge<true>(a,na,b,nb,out);
+
+        int64 i=0,j=0;
+
+        while(i<na&&j<nb)
+        {
+            if(a[i]<b[j])
+                ++i;
+            else if(b[j]<a[i])
+                ++j;
+            else
+            {
+                out[c++]=a[i++];
+                ++j;
+            }
+        }
+
+        return c;
+    }
+
+    /**
+    * @brief CN:差集(a-b)\nEN:Difference (a-b)
+    * @param out CN:输出，至少na个元素，可以与a相同(原地)。EN:Output of at least na elements, may be a itself (in place).
+    * @return CN:输出元素个数。EN:Number of elements written.
+    */
+    template<typename T>
+    int64 SortedDifference(const T *a,const int64 na,const T *b,const int64 nb,T *out)
+    {
+        if(na<=0)return 0;
+
+        int64 c=0;
+
+        if(nb<=0||na*SORTED_SET_GALLOP_RATIO<nb)
+        {
+            int64 j=0;
+
+            for(int64 i=0;i<na;i++)
+            {
+                if(j<nb)
+                    j=sorted_set::GallopLowerBound(b,j,nb,a[i]);
+
+                if(j<nb&&!(a[i]<b[j]))
+                    continue;
+
+                out[c++]=a[i];
+            }
+
+            return c;
+        }
+
+        if(nb*SORTED_SET_GALLOP_RATIO<na)
+        {
+            int64 i=0;
+
+            for(int64 j=0;j<nb;j++)
+            {
+                const int64 next=sorted_set::GallopLowerBound(a,i,na,b[j]);
+
+                c=sorted_set::CopyRun(a,i,next,out,c);
+                i=next;
+
+                if(i<na&&!(b[j]<a[i]))
+                    ++i;
+            }
+
+            return sorted_set::CopyRun(a,i,na,out,c);
+        }
+
+        if constexpr(sorted_set::UseSIMD<T>)
+            return sorted_set::BlockMerge<false>(a,na,b,nb,out);
+
+        int64 j=0;
+
+        for(int64 i=0;i<na;i++)
+        {
+            while(j<nb&&b[j]<a[i])
+                ++j;
+
+            if(j<nb&&!(a[i]<b[j]))
+                continue;
+
+            out[c++]=a[i];
+        }
+
+        return c;
+    }
+
+    /**
+    * @brief CN:对称差\nEN:Symmetric difference
+    * @param out CN:输出，至少na+nb个元素，不能与输入重叠。EN:Output of at least na+nb elements, must not overlap the inputs.
+    * @return CN:输出元素个数。EN:Number of elements written.
+    */
+    template<typename T>
+    int64 SortedSymmetricDifference(const T *a,const int64 na,const T *b,const int64 nb,T *out)
+    {
+        if(na*SORTED_SET_GALLOP_RATIO<nb)return sorted_set::GallopMerge<false>(a,na,b,nb,out);
+        if(nb*SORTED_SET_GALLOP_RATIO<na)return sorted_set::GallopMerge<false>(b,nb,a,na,out);
+
+        return std::set_symmetric_difference(a,a+na,b,b+nb,out)-out;
+    }
+}//namespace hgl
@@ -0,0 +1,698 @@
+﻿/**
+* @file VersionedFlatOrderedMap.h
+* @brief CN:多版本平铺有序映射 - 写时复制，读者无锁读取快照
+*        EN:Versioned flat ordered map - copy-on-write, readers take lock-free snapshots
+*/
+#pragma once
+
+#include<vector>
+#include<memory>
+#include<atomic>
+#include<mutex>
+#include<algorithm>
+#include<hgl/type/FlatOrderedMap.h>
+
+namespace hgl
+{
+    // AI NOTE: RCU-style wrapper over FlatOrderedMap. Data is split into sorted
+    // chunks shared between versions via shared_ptr; a write copies only the
+    // chunks it touches, builds a new Version and publishes it with one atomic
+    // pointer swap. Readers announce the global epoch in a private slot, then
+    // load the current version; retired versions are freed by writers once no
+    // slot holds an older epoch.
+    /**
+    * @brief CN:多版本平铺有序映射（RCU风格）
+    *        EN:Versioned flat ordered map (RCU style)
+    *
+    * 设计特点：
+    * 1. 分块存储：数据按键分为若干有序块(每块是一个FlatOrderedMap)，块在版本之间共享
+    * 2. 写时复制：写操作只复制被修改的块，生成新版本后用一次原子指针交换发布
+    * 3. 无锁读取：读者通过Reader在自己的槽位登记当前纪元，再读取当前版本指针，不加任何锁
+    * 4. 延迟回收：旧版本在所有可能看到它的读者离开后，由写者释放
+    *
+    * 使用场景：
+    * - 配置表、路由表等被大量线程读取、很少修改的映射
+    *
+    * 性能特征：
+    * - 读取快照：两次原子读取+一次写入读者私有槽位，无共享缓存行写入
+    * - 查找：O(log(n/CHUNK_SIZE)+log(CHUNK_SIZE))
+    * - 单键修改：O(n/CHUNK_SIZE+CHUNK_SIZE)，复制版本头和一个块
+    * - 批量修改(AddBatch/DeleteBatch)：只复制涉及的块，生成一个版本
+    * - 写者之间使用互斥锁串行化
+    *
+    * @tparam K CN:键类型（trivially copyable，支持operator<）。EN:Key type (trivially copyable, supports operator<).
+    * @tparam V CN:值类型（trivially copyable）。EN:Value type (trivially copyable).
+    * @tparam CHUNK_SIZE CN:每块的目标元素数量，超过2倍时拆分。EN:Target entries per chunk, split beyond twice this.
+    * @tparam MAX_READERS CN:同时存在的Reader上限。EN:Maximum number of Readers alive at once.
+    *
+    * @example
+    * ```cpp
+    * VersionedFlatOrderedMap<int, float> config;
+    * config.Add(1, 1.5f);                              // 写者线程
+    *
+    * auto reader = config.GetReader();                 // 每个读者线程一个，长期持有
+    * {
+    *     auto snapshot = reader.Pin();                 // 无锁
+    *     float value;
+    *     if (snapshot.Get(1, value)) { ... }
+    * }                                                 // 离开作用域即解除固定
+    * ```
+    *
+    * @see FlatOrderedMap
+    */
+    template<typename K, typename V, int CHUNK_SIZE = 256, int MAX_READERS = 64>
+    class VersionedFlatOrderedMap
+    {
+    public:
+
+        using Chunk = FlatOrderedMap<K, V>;
+
+        static_assert(CHUNK_SIZE >= 4, "VersionedFlatOrderedMap CHUNK_SIZE must be at least 4.");
+        static_assert(MAX_READERS > 0, "VersionedFlatOrderedMap requires at least one reader slot.");
+
+    protected:
+
+        /**
+        * @brief CN:一个版本：有序块列表（只读，发布后不再修改）\nEN:One version: list of sorted chunks (read-only once published)
+        */
+        struct Version
+        {
+            std::vector<K> first_keys;                          ///<CN:每块的最小键。EN:Smallest key of each chunk.
+            std::vector<std::shared_ptr<const Chunk>> chunks;   ///<CN:有序块，与未修改的版本共享。EN:Sorted chunks, shared with versions that did not modify them.
+            int64 count = 0;
+            uint64 serial = 0;
+
+            int64 FindChunk(const K& key) const
+            {
+                auto it = std::upper_bound(first_keys.begin(), first_keys.end(), key);
+                return std::distance(first_keys.begin(), it) - 1;
+            }
+
+            const V* GetValuePointer(const K& key) const
+            {
+                const int64 index = FindChunk(key);
+
+                if (index < 0)
+                    return nullptr;
+
+                return chunks[index]->GetValuePointer(key);
+            }
+        };
+
+        /**
+        * @brief CN:读者槽位（独占一条缓存行），0表示未在读取\nEN:Reader slot (own cache line), 0 means not reading
+        */
+        struct alignas(64) ReaderSlot
+        {
+            std::atomic<uint64> epoch{0};
+            std::atomic<bool> used{false};
+        };
+
+        struct RetiredVersion
+        {
+            const Version* version;
+            uint64 epoch;                                       ///<CN:纪元不小于此值的读者看不到该版本。EN:Readers at this epoch or later cannot see the version.
+        };
+
+        std::atomic<const Version*> current;
+        std::atomic<uint64> global_epoch{1};
+
+        ReaderSlot slots[MAX_READERS];
+
+        std::mutex write_lock;
+        std::vector<RetiredVersion> retired;                    ///<CN:等待回收的旧版本（受write_lock保护）。EN:Old versions awaiting reclamation (guarded by write_lock).
+
+    public:
+
+        class Reader;
+
+        /**
+        * @brief CN:只读快照，存在期间其版本不会被释放\nEN:Read-only snapshot, its version is not freed while it exists
+        */
+        class Snapshot
+        {
+            friend class Reader;
+
+            Reader* reader = nullptr;
+            const Version* version = nullptr;
+
+            Snapshot(Reader* r, const Version* v) : reader(r), version(v) {}
+
+        public:
+
+            Snapshot() = default;
+            Snapshot(const Snapshot&) = delete;
+            Snapshot& operator=(const Snapshot&) = delete;
+
+            Snapshot(Snapshot&& other) noexcept : reader(other.reader), version(other.version)
+            {
+                other.reader = nullptr;
+                other.version = nullptr;
+            }
+
+            Snapshot& operator=(Snapshot&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    Release();
+                    std::swap(reader, other.reader);
+                    std::swap(version, other.version);
+                }
+                return *this;
+            }
+
+            ~Snapshot() { Release(); }
+
+            /**
+            * @brief CN:提前解除固定\nEN:Unpin early
+            */
+            void Release()
+            {
+                if (reader)
+                    reader->Unpin();
+
+                reader = nullptr;
+                version = nullptr;
+            }
+
+            bool IsValid() const { return version != nullptr; }
+
+            /**
+            * @brief CN:版本序号（每次发布加1）\nEN:Version serial (increments on every publish)
+            */
+            uint64 GetSerial() const { return version ? version->serial : 0; }
+
+            int64 GetCount() const { return version ? version->count : 0; }
+            bool IsEmpty() const { return GetCount() == 0; }
+
+            const V* GetValuePointer(const K& key) const
+            {
+                return version ? version->GetValuePointer(key) : nullptr;
+            }
+
+            bool ContainsKey(const K& key) const { return GetValuePointer(key) != nullptr; }
+
+            bool Get(const K& key, V& value) const
+            {
+                const V* p = GetValuePointer(key);
+
+                if (!p)
+                    return false;
+
+                value = *p;
+                return true;
+            }
+
+            /**
+            * @brief CN:块数量与按块访问（相同块地址表示与其它版本共享）\nEN:Chunk count and access (equal chunk addresses mean sharing with another version)
+            */
+            int64 GetChunkCount() const { return version ? (int64)version->chunks.size() : 0; }
+            const Chunk* GetChunk(int64 index) const { return version ? version->chunks[index].get() : nullptr; }
+
+            /**
+            * @brief CN:按键升序枚举所有键值对\nEN:Enumerate all key-value pairs in ascending key order
+            */
+            template<typename F>
+            void EnumKV(F&& func) const
+            {
+                if (!version)
+                    return;
+
+                for (const auto& chunk : version->chunks)
+                    chunk->EnumKV(func);
+            }
+        };//class Snapshot
+
+        /**
+        * @brief CN:读者，占用一个槽位，应由一个线程长期持有\nEN:Reader, owns one slot, meant to be held long-term by one thread
+        */
+        class Reader
+        {
+            friend class VersionedFlatOrderedMap;
+            friend class Snapshot;
+
+            VersionedFlatOrderedMap* owner = nullptr;
+            ReaderSlot* slot = nullptr;
+            int pin_depth = 0;
+
+            Reader(VersionedFlatOrderedMap* o, ReaderSlot* s) : owner(o), slot(s) {}
+
+            void Unpin()
+            {
+                if (--pin_depth == 0)
+                    slot->epoch.store(0, std::memory_order_release);
+            }
+
+        public:
+
+            Reader() = default;
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            Reader(Reader&& other) noexcept : owner(other.owner), slot(other.slot), pin_depth(other.pin_depth)
+            {
+                other.owner = nullptr;
+                other.slot = nullptr;
+                other.pin_depth = 0;
+            }
+
+            /**
+            * @note CN:快照不能比Reader存活更久。若仍有快照固定着版本，这里也会清除纪元，防止回收永远卡在此槽位上。\nEN:Snapshots must not outlive their Reader. If one is still pinned, the epoch is cleared anyway so reclamation cannot stall on this slot.
+            */
+            ~Reader()
+            {
+                if (slot)
+                {
+                    slot->epoch.store(0, std::memory_order_release);
+                    slot->used.store(false, std::memory_order_release);
+                }
+            }
+
+            /**
+            * @brief CN:是否取得了槽位（槽位用尽时为false）\nEN:Whether a slot was acquired (false when slots are exhausted)
+            */
+            bool IsValid() const { return slot != nullptr; }
+
+            /**
+            * @brief CN:固定当前版本，返回快照（可嵌套）\nEN:Pin the current version and return a snapshot (may nest)
+            * @note CN:Reader及其快照只能在同一线程使用。\nEN:A Reader and its snapshots must stay on one thread.
+            */
+            Snapshot Pin()
+            {
+                if (!slot)
+                    return Snapshot();
+
+                // 先登记纪元再读取版本指针：写者发布新版本后才递增纪元，
+                // 所以读到新纪元的读者一定能读到新版本
+                if (pin_depth++ == 0)
+                    slot->epoch.store(owner->global_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+
+                return Snapshot(this, owner->current.load(std::memory_order_seq_cst));
+            }
+        };//class Reader
+
+    protected:
+
+        static std::shared_ptr<const Chunk> MakeChunk(const K* key_buffer, const V* value_buffer, int64 count)
+        {
+            auto chunk = std::make_shared<Chunk>();
+            chunk->LoadFromBuffers(key_buffer, value_buffer, count);
+            return chunk;
+        }
+
+        /**
+        * @brief CN:把块追加到新版本，过大时拆分，空块丢弃，过小时与前一块合并\nEN:Append a chunk to a new version, splitting large ones, dropping empty ones and merging tiny ones into the previous chunk
+        */
+        static void AppendChunk(Version* nv, std::shared_ptr<const Chunk> chunk, bool modified)
+        {
+            const int64 count = chunk->GetCount();
+
+            if (count <= 0)
+                return;
+
+            if (count > CHUNK_SIZE * 2)
+            {
+                const int64 pieces = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+                for (int64 p = 0; p < pieces; p++)
+                {
+                    const int64 start = count * p / pieces;
+                    const int64 end = count * (p + 1) / pieces;
+
+                    nv->first_keys.push_back(chunk->GetKeyData()[start]);
+                    nv->chunks.push_back(MakeChunk(chunk->GetKeyData() + start, chunk->GetValueData() + start, end - start));
+                }
+
+                nv->count += count;
+                return;
+            }
+
+            if (modified && count < CHUNK_SIZE / 4 && !nv->chunks.empty()
+                && nv->chunks.back()->GetCount() + count <= CHUNK_SIZE * 2)
+            {
+                auto merged = std::make_shared<Chunk>(*nv->chunks.back());
+                merged->AddBatch(chunk->GetKeyData(), chunk->GetValueData(), count);
+
+                nv->chunks.back() = std::move(merged);
+                nv->count += count;
+                return;
+            }
+
+            nv->first_keys.push_back(chunk->GetKeyData()[0]);
+            nv->chunks.push_back(std::move(chunk));
+            nv->count += count;
+        }
+
+        /**
+        * @brief CN:发布新版本并回收旧版本（需持有write_lock）\nEN:Publish a new version and reclaim old ones (write_lock must be held)
+        */
+        void Publish(Version* nv)
+        {
+            const Version* old = current.load(std::memory_order_relaxed);
+
+            nv->serial = old->serial + 1;
+
+            current.store(nv, std::memory_order_seq_cst);
+
+            // 纪元递增之后登记的读者只能读到新版本
+            const uint64 epoch = global_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+
+            retired.push_back({old, epoch});
+
+            ReclaimLocked();
+        }
+
+        void ReclaimLocked()
+        {
+            if (retired.empty())
+                return;
+
+            uint64 min_epoch = UINT64_MAX;
+
+            for (const ReaderSlot& slot : slots)
+            {
+                const uint64 e = slot.epoch.load(std::memory_order_seq_cst);
+
+                if (e != 0 && e < min_epoch)
+                    min_epoch = e;
+            }
+
+            auto keep = std::remove_if(retired.begin(), retired.end(), [min_epoch](const RetiredVersion& rv)
+            {
+                if (rv.epoch > min_epoch)
+                    return false;
+
+                delete rv.version;
+                return true;
+            });
+
+            retired.erase(keep, retired.end());
+        }
+
+        /**
+        * @brief CN:修改包含key的块（不存在的键归入其应插入的块）\nEN:Modify the chunk holding key (missing keys go to the chunk they would be inserted into)
+        * @param func CN:bool func(Chunk&)，返回是否有修改。EN:bool func(Chunk&), returns whether anything changed.
+        */
+        template<typename F>
+        bool ModifyChunk(const K& key, F&& func)
+        {
+            std::lock_guard<std::mutex> guard(write_lock);
+
+            const Version* old = current.load(std::memory_order_relaxed);
+
+            if (old->chunks.empty())
+            {
+                Chunk chunk;
+
+                if (!func(chunk))
+                    return false;
+
+                Version* nv = new Version;
+                AppendChunk(nv, std::make_shared<Chunk>(std::move(chunk)), true);
+                Publish(nv);
+                return true;
+            }
+
+            const int64 index = std::max<int64>(old->FindChunk(key), 0);
+
+            auto chunk = std::make_shared<Chunk>(*old->chunks[index]);
+
+            if (!func(*chunk))
+                return false;
+
+            Version* nv = new Version;
+            nv->first_keys.reserve(old->first_keys.size() + 1);
+            nv->chunks.reserve(old->chunks.size() + 1);
+
+            for (int64 i = 0; i < (int64)old->chunks.size(); i++)
+            {
+                if (i == index)
+                    AppendChunk(nv, chunk, true);
+                else
+                    AppendChunk(nv, old->chunks[i], false);
+            }
+
+            Publish(nv);
+            return true;
+        }
+
+        /**
+        * @brief CN:按块分发已排序的批数据并生成一个新版本\nEN:Distribute a sorted batch over chunks and build one new version
+        * @param func CN:bool func(Chunk&, const K*, const V*, int64)，返回是否有修改。EN:bool func(Chunk&, const K*, const V*, int64), returns whether anything changed.
+        */
+        template<typename F>
+        bool ModifyChunks(const K* batch_keys, const V* batch_values, int64 count, F&& func)
+        {
+            const Version* old = current.load(std::memory_order_relaxed);
+
+            Version* nv = new Version;
+            bool changed = false;
+
+            if (old->chunks.empty())
+            {
+                Chunk chunk;
+                changed = func(chunk, batch_keys, batch_values, count);
+
+                if (changed)
+                    AppendChunk(nv, std::make_shared<Chunk>(std::move(chunk)), true);
+            }
+            else
+            {
+                const int64 chunk_count = (int64)old->chunks.size();
+                int64 start = 0;
+
+                for (int64 i = 0; i < chunk_count; i++)
+                {
+                    // 第i块负责[first_keys[i],first_keys[i+1])，第0块同时负责更小的键
+                    int64 end = start;
+
+                    if (i == chunk_count - 1)
+                        end = count;
+                    else
+                        while (end < count && batch_keys[end] < old->first_keys[i + 1])
+                            ++end;
+
+                    if (end > start)
+                    {
+                        auto chunk = std::make_shared<Chunk>(*old->chunks[i]);
+
+                        if (func(*chunk, batch_keys + start, batch_values ? batch_values + start : nullptr, end - start))
+                        {
+                            changed = true;
+                            AppendChunk(nv, chunk, true);
+                            start = end;
+                            continue;
+                        }
+                    }
+
+                    AppendChunk(nv, old->chunks[i], false);
+                    start = end;
+                }
+            }
+
+            if (!changed)
+            {
+                delete nv;
+                return false;
+            }
+
+            Publish(nv);
+            return true;
+        }
+
+    public:
+
+        VersionedFlatOrderedMap()
+        {
+            current.store(new Version, std::memory_order_relaxed);
+        }
+
+        /**
+        * @note CN:析构时不能有Reader存在。\nEN:No Reader may be alive at destruction.
+        */
+        virtual ~VersionedFlatOrderedMap()
+        {
+            for (const RetiredVersion& rv : retired)
+                delete rv.version;
+
+            delete current.load(std::memory_order_relaxed);
+        }
+
+        VersionedFlatOrderedMap(const VersionedFlatOrderedMap&) = delete;
+        VersionedFlatOrderedMap& operator=(const VersionedFlatOrderedMap&) = delete;
+
+        // ============================================================
+        // 读取
+        // ============================================================
+
+        /**
+        * @brief CN:取得一个读者（占用一个槽位）\nEN:Acquire a reader (takes one slot)
+        * @return CN:槽位用尽时返回无效Reader。EN:An invalid Reader when slots are exhausted.
+        */
+        Reader GetReader()
+        {
+            for (ReaderSlot& slot : slots)
+            {
+                bool expected = false;
+
+                if (!slot.used.load(std::memory_order_relaxed)
+                  && slot.used.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return Reader(this, &slot);
+            }
+
+            return Reader();
+        }
+
+        /**
+        * @brief CN:当前版本序号\nEN:Current version serial
+        */
+        uint64 GetSerial() const { return current.load(std::memory_order_acquire)->serial; }
+
+        /**
+        * @brief CN:等待回收的旧版本数量\nEN:Number of old versions awaiting reclamation
+        */
+        int64 GetRetiredCount()
+        {
+            std::lock_guard<std::mutex> guard(write_lock);
+            return (int64)retired.size();
+        }
+
+        /**
+        * @brief CN:回收已无读者的旧版本（写操作会自动调用）\nEN:Reclaim old versions no reader can see (writes call this automatically)
+        */
+        void Reclaim()
+        {
+            std::lock_guard<std::mutex> guard(write_lock);
+            ReclaimLocked();
+        }
+
+        // ============================================================
+        // 写入（每次调用发布一个新版本，无修改时不发布）
+        // ============================================================
+
+        /**
+        * @brief CN:添加键值对\nEN:Add key-value pair
+        * @return CN:键已存在返回false。EN:False if key exists.
+        */
+        bool Add(const K& key, const V& value)
+        {
+            return ModifyChunk(key, [&](Chunk& chunk) { return chunk.Add(key, value); });
+        }
+
+        /**
+        * @brief CN:添加或更新键值对\nEN:Add or update key-value pair
+        */
+        void AddOrUpdate(const K& key, const V& value)
+        {
+            ModifyChunk(key, [&](Chunk& chunk) { chunk.AddOrUpdate(key, value); return true; });
+        }
+
+        /**
+        * @brief CN:修改已有键的值\nEN:Change value of an existing key
+        */
+        bool Change(const K& key, const V& value)
+        {
+            return ModifyChunk(key, [&](Chunk& chunk) { return chunk.Change(key, value); });
+        }
+
+        /**
+        * @brief CN:按键删除\nEN:Delete by key
+        */
+        bool DeleteByKey(const K& key)
+        {
+            return ModifyChunk(key, [&](Chunk& chunk) { return chunk.DeleteByKey(key); });
+        }
+
+        /**
+        * @brief CN:批量添加，只复制涉及的块，发布一个版本\nEN:Batch add, copies only affected chunks and publishes one version
+        * @return CN:新增键的数量。EN:Number of keys added.
+        */
+        int64 AddBatch(const K* key_buffer, const V* value_buffer, int64 count, BatchDuplicatePolicy policy = BatchDuplicatePolicy::KeepFirst)
+        {
+            if (!key_buffer || !value_buffer || count <= 0)
+                return 0;
+
+            std::vector<K> batch_keys(key_buffer, key_buffer + count);
+            std::vector<V> batch_values(value_buffer, value_buffer + count);
+
+            count = SortUniquePairs(batch_keys.data(), batch_values.data(), count, policy == BatchDuplicatePolicy::KeepLast);
+
+            std::lock_guard<std::mutex> guard(write_lock);
+
+            int64 added = 0;
+
+            ModifyChunks(batch_keys.data(), batch_values.data(), count,
+                [&](Chunk& chunk, const K* k, const V* v, int64 n)
+                {
+                    const int64 result = chunk.AddBatch(k, v, n, policy);
+
+                    added += result;
+
+                    // KeepLast时未新增的键都覆盖了已有值
+                    return result > 0 || policy == BatchDuplicatePolicy::KeepLast;
+                });
+
+            return added;
+        }
+
+        /**
+        * @brief CN:批量删除，只复制涉及的块，发布一个版本\nEN:Batch delete, copies only affected chunks and publishes one version
+        * @return CN:删除的数量。EN:Number of keys deleted.
+        */
+        int64 DeleteBatch(const K* key_buffer, int64 count)
+        {
+            if (!key_buffer || count <= 0)
+                return 0;
+
+            std::vector<K> batch_keys(key_buffer, key_buffer + count);
+
+            count = SortUnique(batch_keys.data(), count);
+
+            std::lock_guard<std::mutex> guard(write_lock);
+
+            int64 deleted = 0;
+
+            ModifyChunks(batch_keys.data(), nullptr, count,
+                [&](Chunk& chunk, const K* k, const V*, int64 n)
+                {
+                    const int64 result = chunk.DeleteBatch(k, n);
+
+                    deleted += result;
+                    return result > 0;
+                });
+
+            return deleted;
+        }
+
+        /**
+        * @brief CN:用给定键值对重建（不共享任何旧块）\nEN:Rebuild from given pairs (shares no old chunk)
+        * @return CN:键数量。EN:Number of keys.
+        */
+        int64 BuildFrom(const K* key_buffer, const V* value_buffer, int64 count, BatchDuplicatePolicy policy = BatchDuplicatePolicy::KeepFirst)
+        {
+            Chunk all;
+            all.BuildFrom(key_buffer, value_buffer, count, policy);
+
+            Version* nv = new Version;
+
+            for (int64 start = 0; start < all.GetCount(); start += CHUNK_SIZE)
+            {
+                const int64 n = std::min<int64>(CHUNK_SIZE, all.GetCount() - start);
+                AppendChunk(nv, MakeChunk(all.GetKeyData() + start, all.GetValueData() + start, n), false);
+            }
+
+            std::lock_guard<std::mutex> guard(write_lock);
+            Publish(nv);
+            return nv->count;
+        }
+
+        /**
+        * @brief CN:清空（发布一个空版本）\nEN:Clear (publishes an empty version)
+        */
+        void Clear()
+        {
+            std::lock_guard<std::mutex> guard(write_lock);
+            Publish(new Version);
+        }
+    };//template<typename K,typename V,int CHUNK_SIZE,int MAX_READERS> class VersionedFlatOrderedMap
+}//namespace hgl
@@ -1,4 +1,5 @@
 ﻿#include<hgl/type/MemoryAllocator.h>
+#include<hgl/platform/MemoryAffinity.h>
 
 namespace hgl
 {
@@ -88,4 +89,131 @@ namespace hgl
         data_size=0;
         alloc_size=0;
     }
+
+    PageMemoryAllocator::PageMemoryAllocator(const bool use_huge_page)
+    {
+        map_size=0;
+        huge_page=use_huge_page;
+        huge_tlb=false;
+    }
+
+    PageMemoryAllocator::~PageMemoryAllocator()
+    {
+        Free();
+    }
+
+    void *PageMemoryAllocator::MapPages(uint64 &size,bool &tlb)
+    {
+        size_t map=size;
+
+        void *ptr=PageAlloc(map,huge_page,tlb);
+
+        size=map;
+        return ptr;
+    }
+
+    void PageMemoryAllocator::UnmapPages(void *ptr,const uint64 size)
+    {
+        PageFree(ptr,size);
+    }
+
+    void *PageMemoryAllocator::RemapPages(void *ptr,const uint64 old_size,uint64 &new_size)
+    {
+        size_t map=new_size;
+
+        void *new_ptr=PageRealloc(ptr,old_size,map,huge_tlb);
+
+        new_size=map;
+        return new_ptr;
+    }
+
+    bool PageMemoryAllocator::AllocMemory()
+    {
+        if(memory_block)
+        {
+            if(alloc_size<=map_size)            //页面取整后的空间已经够用
+            {
+                alloc_size=map_size;
+                return(true);
+            }
+
+            uint64 new_size=alloc_size;
+            void *ptr=RemapPages(memory_block,map_size,new_size);
+
+            if(ptr)
+            {
+                memory_block=ptr;
+                map_size=new_size;
+                alloc_size=new_size;
+                return(true);
+            }
+        }
+
+        uint64 new_size=alloc_size;
+        bool tlb=false;
+
+        void *ptr=MapPages(new_size,tlb);
+
+        if(!ptr)
+        {
+            alloc_size=map_size;                //Reserve已提前修改alloc_size，失败时恢复为实际映射的大小
+            return(false);
+        }
+
+        if(memory_block)
+        {
+            memcpy(ptr,memory_block,data_size);
+            UnmapPages(memory_block,map_size);
+        }
+
+        memory_block=ptr;
+        map_size=new_size;
+        alloc_size=new_size;
+        huge_tlb=tlb;
+        return(true);
+    }
+
+    void PageMemoryAllocator::Free()
+    {
+        if(memory_block)
+        {
+            UnmapPages(memory_block,map_size);
+            memory_block=nullptr;
+        }
+
+        data_size=0;
+        alloc_size=0;
+        map_size=0;
+        huge_tlb=false;
+    }
+
+    NumaMemoryAllocator::NumaMemoryAllocator(const int node,const bool use_huge_page):PageMemoryAllocator(use_huge_page)
+    {
+        numa_node=node;
+    }
+
+    NumaMemoryAllocator::~NumaMemoryAllocator()
+    {
+        Free();         //基类析构时虚函数已不指向本类，需在这里释放
+    }
+
+    void *NumaMemoryAllocator::MapPages(uint64 &size,bool &tlb)
+    {
+        const uint64 page_size=GetSystemPageSize();
+
+        size=((size+page_size-1)/page_size)*page_size;
+        tlb=false;
+
+        void *ptr=NumaAlloc(size,numa_node);
+
+        if(ptr&&huge_page)
+            AdviseHugePage(ptr,size);
+
+        return ptr;
+    }
+
+    void NumaMemoryAllocator::UnmapPages(void *ptr,const uint64 size)
+    {
+        NumaFree(ptr,size);
+    }
 }//namespace hgl
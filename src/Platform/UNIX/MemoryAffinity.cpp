@@ -1,6 +1,8 @@
 ﻿#include<hgl/platform/MemoryAffinity.h>
 #include<stdlib.h>
 #include<string.h>
+#include<stdio.h>
+#include<unistd.h>
 #include<sys/mman.h>
 
 // NUMA support (optional, may not be available on all systems)
@@ -144,4 +146,131 @@ namespace hgl
 
         return false;
     }
+
+    namespace
+    {
+        size_t RoundUp(size_t size,size_t unit)
+        {
+            return ((size+unit-1)/unit)*unit;
+        }
+    }//namespace
+
+    size_t GetSystemPageSize()
+    {
+        static const size_t page_size=(size_t)sysconf(_SC_PAGESIZE);
+
+        return page_size;
+    }
+
+    size_t GetHugePageSize()
+    {
+#if defined(__linux__)
+        static const size_t huge_page_size=[]()->size_t
+        {
+            size_t kb=0;
+
+            FILE *fp=fopen("/proc/meminfo","r");
+
+            if(fp)
+            {
+                char line[256];
+
+                while(fgets(line,sizeof(line),fp))
+                    if(sscanf(line,"Hugepagesize: %zu kB",&kb)==1)
+                        break;
+
+                fclose(fp);
+            }
+
+            return kb?kb*1024:2*1024*1024;
+        }();
+
+        return huge_page_size;
+#else
+        return 0;
+#endif
+    }
+
+    void AdviseHugePage(void* ptr, size_t size)
+    {
+        if (!ptr || size == 0) return;
+
+#ifdef MADV_HUGEPAGE
+        madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    }
+
+    void* PageAlloc(size_t &size, bool huge_page, bool &huge_tlb)
+    {
+        huge_tlb=false;
+
+        if (size == 0) return nullptr;
+
+        const size_t huge_page_size=GetHugePageSize();
+
+#ifdef MAP_HUGETLB
+        // 显式大页面需要系统预留大页面池，失败时回退到普通页面
+        if (huge_page && huge_page_size && size >= huge_page_size)
+        {
+            const size_t huge_size=RoundUp(size,huge_page_size);
+
+            void* ptr = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+            if (ptr != MAP_FAILED)
+            {
+                size=huge_size;
+                huge_tlb=true;
+                return ptr;
+            }
+        }
+#endif
+
+        // 足够大时按大页面取整，便于透明大页面完整覆盖
+        const size_t map_size=RoundUp(size,(huge_page && huge_page_size && size >= huge_page_size)?huge_page_size:GetSystemPageSize());
+
+        void* ptr = mmap(nullptr, map_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (ptr == MAP_FAILED)
+            return nullptr;
+
+        if (huge_page)
+            AdviseHugePage(ptr, map_size);
+
+        size=map_size;
+        return ptr;
+    }
+
+    void* PageRealloc(void* ptr, [[maybe_unused]] size_t old_size, size_t &new_size, [[maybe_unused]] bool huge_tlb)
+    {
+        if (!ptr || new_size == 0) return nullptr;
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+        const size_t huge_page_size=GetHugePageSize();
+        const bool huge=huge_page_size && new_size >= huge_page_size;
+
+        const size_t map_size=RoundUp(new_size,(huge_tlb||huge)?huge_page_size:GetSystemPageSize());
+
+        void* new_ptr = mremap(ptr, old_size, map_size, MREMAP_MAYMOVE);
+
+        if (new_ptr == MAP_FAILED)
+            return nullptr;
+
+        if (!huge_tlb && huge)
+            AdviseHugePage(new_ptr, map_size);
+
+        new_size=map_size;
+        return new_ptr;
+#else
+        return nullptr;
+#endif
+    }
+
+    void PageFree(void* ptr, size_t size)
+    {
+        if (!ptr) return;
+
+        munmap(ptr, size);
+    }
 }//namespace hgl
@@ -81,4 +81,70 @@ namespace hgl
 
         return true;
     }
+
+    size_t GetSystemPageSize()
+    {
+        SYSTEM_INFO si;
+
+        GetSystemInfo(&si);
+        return si.dwPageSize;
+    }
+
+    size_t GetHugePageSize()
+    {
+        return GetLargePageMinimum();
+    }
+
+    void AdviseHugePage(void*, size_t)
+    {
+        // Windows没有透明大页面
+    }
+
+    void* PageAlloc(size_t &size, bool huge_page, bool &huge_tlb)
+    {
+        huge_tlb=false;
+
+        if (size == 0) return nullptr;
+
+        const size_t large_page_size=GetLargePageMinimum();
+
+        // 大页面需要SeLockMemoryPrivilege权限，失败时回退到普通页面
+        if (huge_page && large_page_size && size >= large_page_size)
+        {
+            const size_t large_size=((size+large_page_size-1)/large_page_size)*large_page_size;
+
+            void* ptr = VirtualAlloc(nullptr, large_size, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+
+            if (ptr)
+            {
+                size=large_size;
+                huge_tlb=true;
+                return ptr;
+            }
+        }
+
+        const size_t page_size=GetSystemPageSize();
+        const size_t map_size=((size+page_size-1)/page_size)*page_size;
+
+        void* ptr = VirtualAlloc(nullptr, map_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+
+        if (!ptr)
+            return nullptr;
+
+        size=map_size;
+        return ptr;
+    }
+
+    void* PageRealloc(void*, size_t, size_t &, bool)
+    {
+        // Windows没有mremap，由调用者重新分配并复制
+        return nullptr;
+    }
+
+    void PageFree(void* ptr, size_t)
+    {
+        if (!ptr) return;
+
+        VirtualFree(ptr, 0, MEM_RELEASE);
+    }
 }//namespace hgl
@@ -21,12 +21,26 @@ namespace hgl
 
         id_count+=count;
 
+        // 位图随ID上界扩展，新位均为0
+        active_bits.resize(BitWordCount(id_count),0);
+        idle_bits.resize(BitWordCount(id_count),0);
+        queued_bits.resize(BitWordCount(id_count),0);
+
+        // 代数数组只增不减(压缩/重置后重新创建的ID沿用原有代数)
+        if((int)generation.size()<id_count)
+            generation.resize(id_count,1);
+
         return(true);
     }
 
     void ActiveIDManager::Reserve(int c)
     {
-        // btree_set 无需手动预留容量
+        if(c<=0)return;
+
+        active_bits.reserve(BitWordCount(c));
+        idle_bits.reserve(BitWordCount(c));
+        queued_bits.reserve(BitWordCount(c));
+        generation.reserve(c);
         // deque 自动扩展，无需预留
     }
 
@@ -36,14 +50,12 @@ namespace hgl
 
         if(!Create(id,count))return(0);
 
-        // 批量插入到 btree_set
-        int added = 0;
+        // 新ID必然未被使用，直接置位
         for(int i = 0; i < count; i++)
-        {
-            if(active_list.insert(id[i]).second)
-                ++added;
-        }
-        return added;
+            SetBit(active_bits, id[i]);
+
+        active_count += count;
+        return count;
     }
 
     /**
@@ -69,9 +81,7 @@ namespace hgl
 
             // 将创建的ID推入 deque（直接插入到尾部）
             for(int i = 0; i < batch_size; i++)
-            {
-                idle_list.push_back(created_ids[i]);
-            }
+                PushIdle(created_ids[i]);
 
             // 如果需要输出，拷贝到idp
             if(idp)
@@ -109,22 +119,30 @@ namespace hgl
         if(!id||count<=0)return(false);
 
         // 检查是否有足够的闲置ID
-        if(static_cast<int>(idle_list.size()) < count)
+        if(idle_count < count)
             return false;
 
         // 从 deque 头部取出 count 个ID（FIFO）
-        for(int i = 0; i < count; i++)
+        for(int i = 0; i < count; )
         {
-            id[i] = idle_list.front();
+            const int cur = idle_list.front();
             idle_list.pop_front();
-        }
 
-        // 批量加入到 active_list
-        for(int i = 0; i < count; i++)
-        {
-            active_list.insert(id[i]);
+            ClearBit(queued_bits, cur);
+
+            // 压缩时被填掉的ID仍残留在队列中，跳过
+            if(!TestBit(idle_bits, cur))
+                continue;
+
+            ClearBit(idle_bits, cur);
+            SetBit(active_bits, cur);
+
+            id[i++] = cur;
         }
 
+        active_count += count;
+        idle_count -= count;
+
         return true;
     }
 
@@ -140,9 +158,9 @@ namespace hgl
     {
         if(!id||count<=0)return(false);
 
-        if(static_cast<int>(idle_list.size()) < count)
+        if(idle_count < count)
         {
-            [[maybe_unused]] int created = CreateIdle(count - static_cast<int>(idle_list.size()));
+            [[maybe_unused]] int created = CreateIdle(count - idle_count);
         }
 
         return Get(id,count);
@@ -150,8 +168,6 @@ namespace hgl
 
     /**
     * 释放指定量的ID数据(会从Active列表中取出，放入Idle列表中)
-    *
-    * 优化：使用批缓冲减少 deque::push_back 调用次数
     */
     int ActiveIDManager::Release(const int *id,int count)
     {
@@ -161,16 +177,21 @@ namespace hgl
 
         for(int i = 0; i < count; i++)
         {
-            // 从 active_list 删除
-            if(active_list.erase(id[i]) > 0)
+            // 仅释放处于活跃状态的ID
+            if(IsActive(id[i]))
             {
+                ClearBit(active_bits, id[i]);
+                NextGeneration(id[i]);
+
                 // 添加到 idle_list 尾部（FIFO）
-                idle_list.push_back(id[i]);
+                PushIdle(id[i]);
                 ++result;
-                ++released_count;  // 统计已释放ID
             }
         }
 
+        active_count -= result;
+        released_count += result;  // 统计已释放ID
+
         return result;
     }
 
@@ -179,21 +200,81 @@ namespace hgl
     */
     int ActiveIDManager::ReleaseAllActive()
     {
-        const int count = static_cast<int>(active_list.size());
+        const int count = active_count;
 
         if(count > 0)
         {
-            // 将所有活跃ID移到闲置队列尾部
-            for(int id : active_list)
+            // 将所有活跃ID按升序移到闲置队列尾部
+            ForEachActive([this](int id)
             {
-                idle_list.push_back(id);
-            }
+                NextGeneration(id);
+                PushIdle(id);
+            });
+
+            std::fill(active_bits.begin(), active_bits.end(), 0);
 
             released_count += count;  // 统计已释放ID
 
-            active_list.clear();
+            active_count = 0;
         }
 
         return count;
     }
+
+    /**
+    * 压缩ID空间：每次把最高的活跃ID搬到最低的闲置ID上
+    *
+    * 每次调用都会从头按字扫描一次闲置位图定位第一个空洞，之后的空洞/活跃ID查找都是单向前进的，
+    * 因此增量压缩时每步的代价为 O(id_count/64 + max_move)。
+    */
+    int ActiveIDManager::Compact(std::vector<ActiveIDRemap> &moved,const int max_move)
+    {
+        if(max_move<0)return(0);
+
+        int result=0;
+
+        int hole=FindNextIdle(0);
+        int tail=FindPrevActive(id_count-1);
+
+        while(hole!=-1&&hole<tail&&result<max_move)
+        {
+            // 低位空洞变为活跃(其在闲置队列中的项留待Get时跳过)
+            ClearBit(idle_bits,hole);
+            SetBit(active_bits,hole);
+            --idle_count;
+
+            // 高位ID变为闲置(代数加1，指向旧ID的句柄失效)
+            ClearBit(active_bits,tail);
+            NextGeneration(tail);
+            PushIdle(tail);
+
+            moved.push_back({tail,hole});
+            ++result;
+
+            hole=FindNextIdle(hole+1);
+            tail=FindPrevActive(tail-1);
+        }
+
+        if(hole==-1||hole>tail)         //低位已无空洞，丢弃所有闲置ID
+            Trim();
+
+        return result;
+    }
+
+    /**
+    * 丢弃所有闲置ID，将ID上界收缩到active_count(仅在活跃ID已稠密排列时调用)
+    */
+    void ActiveIDManager::Trim()
+    {
+        id_count=active_count;
+
+        const int word_count=BitWordCount(id_count);
+
+        active_bits.resize(word_count);
+        idle_bits.assign(word_count,0);
+        queued_bits.assign(word_count,0);
+
+        idle_list.clear();
+        idle_count=0;
+    }
 }//namespace hgl
@@ -6,10 +6,16 @@ namespace hgl
     {
         max_count=0;
         free_count=0;
+
+        start=nullptr;
+        end=nullptr;
     }
 
     bool BlockAllocator::Init(const int mc)
     {
+        if(mc<=0)
+            return(false);
+
         max_count=mc;
         free_count=mc;
 
@@ -17,102 +23,141 @@ namespace hgl
         node_pool.Init(mc);
         ud_pool.Init(mc);
 
-        ud_set.Reserve(mc);
+        user_at.assign(mc,nullptr);
+        head_at.assign(mc,nullptr);
+        tail_at.assign(mc,nullptr);
+
+        free_by_size.Clear();
+        free_by_start.Clear();
+
+        start=nullptr;
+        end=nullptr;
+
+        ChainNode *cn=node_pool.Acquire();
 
-        start=node_pool.Acquire();
-        end=start;
+        cn->start=0;
+        cn->count=max_count;
 
-        start->prev=nullptr;
-        start->next=nullptr;
-        start->start=0;
-        start->count=max_count;
+        LinkFreeRun(cn);
+        AddFreeRun(cn);
 
         return(true);
     }
 
-    BlockAllocator::UserNode *BlockAllocator::Acquire(const int acquire_count)
+    /**
+    * 将空闲段登记到大小树与边界标记(修改start/count前需先RemoveFreeRun)
+    */
+    void BlockAllocator::AddFreeRun(ChainNode *cn)
     {
-        if(acquire_count<=0)
-            return(nullptr);
+        const FreeRunKey key{cn->count,cn->start};
 
-        if(acquire_count>free_count)
-            return(nullptr);
+        free_by_size.Add(&key,1);           //批量版本不计算插入位置，O(log n)
 
-        if(acquire_count>max_count)
-            return(nullptr);
+        head_at[cn->start]=cn;
+        tail_at[cn->GetEnd()-1]=cn;
+    }
 
-        if(start==end)
-        {
-            free_count-=acquire_count;
+    void BlockAllocator::RemoveFreeRun(ChainNode *cn)
+    {
+        free_by_size.Delete(FreeRunKey{cn->count,cn->start});
 
-            UserNode *ud=ud_pool.Acquire();
+        head_at[cn->start]=nullptr;
+        tail_at[cn->GetEnd()-1]=nullptr;
+    }
 
-            if(!ud){free_count+=acquire_count;return(nullptr);}
+    /**
+    * 将新节点按起始位置插入链表
+    */
+    void BlockAllocator::LinkFreeRun(ChainNode *cn)
+    {
+        auto it=free_by_start.lower_bound(cn->start);
 
-            ud->start=start->start;
-            ud->count=acquire_count;
+        ChainNode *prev=nullptr;
 
-            ud_set.Add(ud);
+        if(it!=free_by_start.begin())
+            prev=head_at[*(--it)];
 
-            start->start+=acquire_count;
-            start->count=free_count;
+        cn->prev=prev;
+        cn->next=prev?prev->next:start;
 
-            return(ud);
-        }
+        if(cn->prev)
+            cn->prev->next=cn;
+        else
+            start=cn;
 
-        ChainNode *cn=start;
-        ChainNode *fit=nullptr;
+        if(cn->next)
+            cn->next->prev=cn;
+        else
+            end=cn;
 
-        do
-        {
-            if(cn->count==acquire_count)    //长度正合适，那就用这一段
-            {
-                fit=cn;
-                break;
-            }
+        free_by_start.Add(&cn->start,1);
+    }
 
-            if(cn->count>acquire_count)     //长度够了
-            {
-                if(!fit                     //没有合适的，先记下这个
-                   ||fit->count>cn->count)   //这个更小，更合适
-                    fit=cn;
-            }
+    /**
+    * 将节点移出链表并归还
+    */
+    void BlockAllocator::UnlinkFreeRun(ChainNode *cn)
+    {
+        if(cn->prev)
+            cn->prev->next=cn->next;
+        else
+            start=cn->next;
+
+        if(cn->next)
+            cn->next->prev=cn->prev;
+        else
+            end=cn->prev;
+
+        free_by_start.Delete(cn->start);
+        node_pool.Release(cn);
+    }
+
+    BlockAllocator::UserNode *BlockAllocator::Acquire(const int acquire_count)
+    {
+        if(acquire_count<=0)
+            return(nullptr);
+
+        if(acquire_count>free_count)
+            return(nullptr);
 
-            cn=cn->next;
-            }while(cn!=nullptr);
+        if(acquire_count>max_count)
+            return(nullptr);
+
+        //最小的足够长的空闲段，同样长度取最靠前的
+        auto it=free_by_size.lower_bound(FreeRunKey{acquire_count,-1});
 
-            if(!fit)    //没有合适的
-                return(nullptr);
+        if(it==free_by_size.end())      //没有合适的
+            return(nullptr);
 
-            free_count-=acquire_count;
+        ChainNode *fit=head_at[it->start];
 
-            UserNode *ud=ud_pool.Acquire();
+        UserNode *ud=ud_pool.Acquire();
 
-            if(!ud){free_count+=acquire_count;return(nullptr);}
+        if(!ud)
+            return(nullptr);
 
-            ud->start=fit->start;
+        ud->start=fit->start;
         ud->count=acquire_count;
 
-        ud_set.Add(ud);
+        user_at[ud->start]=ud;
+        free_count-=acquire_count;
+
+        RemoveFreeRun(fit);
 
         if(fit->count==acquire_count)       //正好合适
         {
-            if(fit->prev)
-                fit->prev->next=fit->next;
-            else
-                start=fit->next;
-
-            if(fit->next)
-                fit->next->prev=fit->prev;
-            else
-                end=fit->prev;
-
-            node_pool.Release(fit);
+            UnlinkFreeRun(fit);
         }
         else
         {
+            free_by_start.Delete(fit->start);
+
             fit->start+=acquire_count;
             fit->count-=acquire_count;
+
+            free_by_start.Add(&fit->start,1);
+
+            AddFreeRun(fit);
         }
 
         return(ud);
@@ -123,136 +168,102 @@ namespace hgl
         if(!ud)
             return(false);
 
-        if(!ud_set.Contains(ud))
+        if(ud->start<0||ud->start>=max_count)
+            return(false);
+
+        if(user_at[ud->start]!=ud)          //不是已分配的数据区块
             return(false);
 
+        user_at[ud->start]=nullptr;
+
         const int ud_end=ud->GetEnd();
 
-        ChainNode *cur=start;
-        ChainNode *next;
-        int cur_end;
+        ChainNode *left =ud->start>0    ?tail_at[ud->start-1]:nullptr;     //紧接在前面的空闲段
+        ChainNode *right=ud_end<max_count?head_at[ud_end]:nullptr;          //紧接在后面的空闲段
 
-        do
+        if(left)
         {
-            cur_end=cur->GetEnd();
+            RemoveFreeRun(left);
 
-            if(cur_end==ud->start)          //接在一起了
-            {
-                cur->count+=ud->count;      //count扩充
+            left->count+=ud->count;
 
-                free_count+=ud->count;      //空闲数量增加
-                ud_set.Delete(ud);
-                ud_pool.Release(ud);
-                return(true);
-            }
-            else if(cur->start==ud_end)     //接在一起了
+            if(right)                       //前后都接上了，三段合一
             {
-                cur->count+=ud->count;
-                cur->start-=ud->count;
+                RemoveFreeRun(right);
+
+                left->count+=right->count;
 
-                free_count+=ud->count;      //空闲数量增加
-                ud_set.Delete(ud);
-                ud_pool.Release(ud);
-                return(true);
+                UnlinkFreeRun(right);
             }
-            else if(cur->start>ud_end)      //在前面
-            {
-                ChainNode *new_cn=node_pool.Acquire();
 
-                new_cn->prev=cur->prev;
-                new_cn->next=cur;
-                new_cn->start=ud->start;
-                new_cn->count=ud->count;
+            AddFreeRun(left);
+        }
+        else if(right)
+        {
+            RemoveFreeRun(right);
+            free_by_start.Delete(right->start);
 
-                if(cur->prev)
-                    cur->prev->next=new_cn;
-                else
-                    start=new_cn;
+            right->start=ud->start;
+            right->count+=ud->count;
 
-                cur->prev=new_cn;
+            free_by_start.Add(&right->start,1);
+            AddFreeRun(right);
+        }
+        else                                //前后都不接，新建一个节点
+        {
+            ChainNode *cn=node_pool.Acquire();
 
-                free_count+=ud->count;      //空闲数量增加
-                ud_set.Delete(ud);
-                ud_pool.Release(ud);
-                return(true);
+            if(!cn)
+            {
+                user_at[ud->start]=ud;
+                return(false);
             }
 
-            next=cur->next;
+            cn->start=ud->start;
+            cn->count=ud->count;
 
-            if(next)
-            {
-                if(next->start==ud_end)     //下一个块接着，那就合并
-                {
-                    next->count+=ud->count;    //count扩充
-                    next->start-=ud->count;    //start前移,理论上==ud->start，调试时检查一下
-
-                    free_count+=ud->count;      //空闲数量增加
-                    ud_set.Delete(ud);
-                    ud_pool.Release(ud);
-                    return(true);
-                }
-                else
-                    if(next->start>ud_end)      //下一个块不接着，但是在后面，那就新建一个节点
-                    {
-                        ChainNode *new_cn=node_pool.Acquire();
-
-                        new_cn->prev=cur;
-                        new_cn->next=next;
-                        new_cn->start=ud->start;
-                        new_cn->count=ud->count;
-
-                        cur->next=new_cn;
-                        next->prev=new_cn;
-
-                        free_count+=ud->count;      //空闲数量增加
-                        ud_set.Delete(ud);
-                        ud_pool.Release(ud);
-                        return(true);
-                    }
-                    else //next->start<ud_end
-                    {
-                        if(next->start>=ud->start)  //这个块在中间，那就是出错了
-                        {
-                            //                            LogError(OS_TEXT("BlockAllocator::Release, block cross."));
-                            return(false);
-                        }
-                    }
-            }
-            else    //都没下一个了，那这个就当下一个吧
-            {
-                ChainNode *new_cn=node_pool.Acquire();
+            LinkFreeRun(cn);
+            AddFreeRun(cn);
+        }
+
+        free_count+=ud->count;      //空闲数量增加
+        ud_pool.Release(ud);
+        return(true);
+    }
 
-                new_cn->start=ud->start;
-                new_cn->count=ud->count;
+    const int BlockAllocator::GetLargestFreeRun()const
+    {
+        FreeRunKey key;
 
-                if(cur==start)      //卧槽这是第一个
-                {
-                    new_cn->prev=nullptr;
-                    new_cn->next=cur;
+        if(!free_by_size.GetLast(key))
+            return(0);
 
-                    cur->prev=new_cn;
+        return key.count;
+    }
 
-                    start=new_cn;
-                }
-                else
-                {
-                    new_cn->prev=cur;
-                    new_cn->next=nullptr;
+    const double BlockAllocator::GetExternalFragmentation()const
+    {
+        if(free_count<=0)
+            return(0);
 
-                    cur->next=new_cn;
-                    end=new_cn;
-                }
+        return 1.0-double(GetLargestFreeRun())/double(free_count);
+    }
 
-                free_count+=ud->count;      //空闲数量增加
-                ud_set.Delete(ud);
-                ud_pool.Release(ud);
-                return(true);
-            }
+    void BlockAllocator::GetFreeRunHistogram(std::vector<int> &histogram)const
+    {
+        histogram.clear();
+
+        for(const FreeRunKey &key:free_by_size)
+        {
+            int bucket=0;
 
-            cur=next;
-        }while(cur!=nullptr);
+            while((key.count>>(bucket+1))>0)
+                ++bucket;
 
-        //未找到？？
-        return(false);
+            if((int)histogram.size()<=bucket)
+                histogram.resize(bucket+1,0);
+
+            ++histogram[bucket];
+        }
     }
 }//namespace hgl